@@ -0,0 +1,10 @@
+TEMPLATE = app
+TARGET = eglinfo-aggregate
+INCLUDEPATH += $$PWD/../lib
+LIBS += -L$$OUT_PWD/../lib -leglinfo
+PRE_TARGETDEPS += $$OUT_PWD/../lib/libeglinfo.a
+include(../eglinfo.pri)
+HEADERS += index.h
+SOURCES += \
+    index.cpp \
+    main.cpp
@@ -0,0 +1,258 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+namespace EglInfo {
+
+uint32_t Index::extensionSet(const std::string& extensions)
+{
+    const auto it = m_extensionSetIds.find(extensions);
+    if (it != m_extensionSetIds.end())
+        return it->second;
+
+    std::vector<uint32_t> ids;
+    std::istringstream stream(extensions);
+    std::string name;
+    while (stream >> name) {
+        const auto id = m_extensionIds.insert(std::make_pair(name, uint32_t(m_extensionNames.size())));
+        if (id.second)
+            m_extensionNames.push_back(name);
+        ids.push_back(id.first->second);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    const uint32_t set = m_extensionSets.size();
+    m_extensionSets.push_back(std::move(ids));
+    m_extensionSetIds.insert(std::make_pair(extensions, set));
+    return set;
+}
+
+template <typename T>
+static void encode(const std::vector<const ConfigInfo*>& rows, int attribute, const std::vector<EGLint>& dictionary, std::vector<T>* codes)
+{
+    codes->resize(rows.size());
+    for (size_t r = 0; r < rows.size(); ++r) {
+        const ConfigInfo *config = rows[r];
+        if (!config->isValid(attribute)) {
+            (*codes)[r] = 0;
+            continue;
+        }
+        const auto it = std::lower_bound(dictionary.begin(), dictionary.end(), config->values[attribute]);
+        (*codes)[r] = static_cast<T>(it - dictionary.begin() + 1);
+    }
+}
+
+void Index::buildColumn(int attribute, const std::vector<const ConfigInfo*>& rows)
+{
+    Column &column = m_columns[attribute];
+    column.dictionary.clear();
+    for (const ConfigInfo *config : rows) {
+        if (config->isValid(attribute))
+            column.dictionary.push_back(config->values[attribute]);
+    }
+    std::sort(column.dictionary.begin(), column.dictionary.end());
+    column.dictionary.erase(std::unique(column.dictionary.begin(), column.dictionary.end()), column.dictionary.end());
+
+    if (column.dictionary.size() < 0xff)
+        encode(rows, attribute, column.dictionary, &column.codes8);
+    else if (column.dictionary.size() < 0xffff)
+        encode(rows, attribute, column.dictionary, &column.codes16);
+    else
+        encode(rows, attribute, column.dictionary, &column.codes32);
+}
+
+void Index::build(std::vector<HostRecord>&& hosts, int threads)
+{
+    std::vector<const ConfigInfo*> rows;
+    for (const HostRecord &host : hosts) {
+        const uint32_t hostIndex = m_hostNames.size();
+        m_hostNames.push_back(host.name);
+        for (const HostDisplay &display : host.displays) {
+            const uint32_t displayIndex = m_displayHost.size();
+            m_displayHost.push_back(hostIndex);
+            m_displayExtensionSet.push_back(extensionSet(display.extensions));
+            for (const ConfigInfo &config : display.configs) {
+                m_fingerprintRows[config.fingerprint()].push_back(rows.size());
+                rows.push_back(&config);
+                m_rowDisplay.push_back(displayIndex);
+            }
+        }
+    }
+
+    // columns are independent of each other
+    std::atomic<int> nextColumn(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::max(1, std::min<int>(threads, attributesSize)); ++i) {
+        workers.emplace_back([&] {
+            for (int column = nextColumn++; column < attributesSize; column = nextColumn++)
+                buildColumn(column, rows);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    hosts.clear();
+}
+
+template <typename T>
+static void filter(const std::vector<T>& codes, const std::vector<uint8_t>& dictionaryMatch, std::vector<uint8_t>* selected)
+{
+    uint8_t *out = selected->data();
+    const T *in = codes.data();
+    const uint8_t *match = dictionaryMatch.data();
+    for (size_t r = 0, size = codes.size(); r < size; ++r)
+        out[r] &= match[in[r]];
+}
+
+void Index::decode(int attribute, size_t row, ConfigInfo* config) const
+{
+    const Column &column = m_columns[attribute];
+    uint32_t code;
+    if (!column.codes8.empty())
+        code = column.codes8[row];
+    else if (!column.codes16.empty())
+        code = column.codes16[row];
+    else
+        code = column.codes32[row];
+    if (code) {
+        config->values[attribute] = column.dictionary[code - 1];
+        config->validMask |= 1u << attribute;
+    } else {
+        config->validMask &= ~(1u << attribute);
+    }
+}
+
+Index::Result Index::query(const Query& query, bool listHosts, const CostModel& model) const
+{
+    Result result = Result();
+
+    // extension terms are evaluated once per extension set
+    std::vector<uint8_t> setMatch(m_extensionSets.size(), 1);
+    for (const QueryTerm &term : query) {
+        if (term.attribute != QueryTerm::ExtensionTerm)
+            continue;
+        const auto id = m_extensionIds.find(term.extension);
+        for (size_t set = 0; set < m_extensionSets.size(); ++set) {
+            const auto &ids = m_extensionSets[set];
+            const bool has = id != m_extensionIds.end() && std::binary_search(ids.begin(), ids.end(), id->second);
+            if (has != (term.op == QueryTerm::Equal))
+                setMatch[set] = 0;
+        }
+    }
+
+    std::vector<uint8_t> selected(m_rowDisplay.size());
+    for (size_t r = 0; r < selected.size(); ++r)
+        selected[r] = setMatch[m_displayExtensionSet[m_rowDisplay[r]]];
+
+    // fingerprint terms are hash lookups
+    for (const QueryTerm &term : query) {
+        if (term.attribute != QueryTerm::FingerprintTerm)
+            continue;
+        const auto it = m_fingerprintRows.find(term.fingerprint);
+        if (term.op == QueryTerm::Equal) {
+            std::vector<uint8_t> rows(selected.size(), 0);
+            if (it != m_fingerprintRows.end()) {
+                for (uint32_t r : it->second)
+                    rows[r] = selected[r];
+            }
+            selected.swap(rows);
+        } else if (it != m_fingerprintRows.end()) {
+            for (uint32_t r : it->second)
+                selected[r] = 0;
+        }
+    }
+
+    // attribute terms are evaluated once per dictionary entry, then applied to the codes
+    for (const QueryTerm &term : query) {
+        if (term.attribute < 0)
+            continue;
+        const Column &column = m_columns[term.attribute];
+        std::vector<uint8_t> dictionaryMatch(column.dictionary.size() + 1, 0);
+        for (size_t i = 0; i < column.dictionary.size(); ++i)
+            dictionaryMatch[i + 1] = term.matches(column.dictionary[i]);
+        if (!column.codes8.empty())
+            filter(column.codes8, dictionaryMatch, &selected);
+        else if (!column.codes16.empty())
+            filter(column.codes16, dictionaryMatch, &selected);
+        else
+            filter(column.codes32, dictionaryMatch, &selected);
+    }
+
+    // cost terms last, so only the rows still selected are decoded
+    static const EGLint costAttributes[] = { EGL_BUFFER_SIZE, EGL_DEPTH_SIZE, EGL_STENCIL_SIZE, EGL_SAMPLES, EGL_SAMPLE_BUFFERS };
+    for (const QueryTerm &term : query) {
+        if (term.attribute != QueryTerm::FrameBytesTerm && term.attribute != QueryTerm::BandwidthTerm)
+            continue;
+        ConfigInfo config = ConfigInfo();
+        for (size_t r = 0; r < selected.size(); ++r) {
+            if (!selected[r])
+                continue;
+            for (EGLint attribute : costAttributes)
+                decode(attributeIndex(attribute), r, &config);
+            const int64_t value = term.attribute == QueryTerm::FrameBytesTerm ? frameBytes(config, model) : writeBandwidth(config, model);
+            selected[r] = term.matchesAmount(value);
+        }
+    }
+
+    std::vector<uint8_t> displays(m_displayHost.size(), 0);
+    for (size_t r = 0; r < selected.size(); ++r) {
+        if (selected[r]) {
+            ++result.configs;
+            displays[m_rowDisplay[r]] = 1;
+        }
+    }
+    std::vector<uint8_t> hosts(m_hostNames.size(), 0);
+    for (size_t d = 0; d < displays.size(); ++d) {
+        if (displays[d]) {
+            ++result.displays;
+            hosts[m_displayHost[d]] = 1;
+        }
+    }
+    for (size_t h = 0; h < hosts.size(); ++h) {
+        if (!hosts[h])
+            continue;
+        ++result.hosts;
+        if (listHosts)
+            result.hostIndexes.push_back(h);
+    }
+    return result;
+}
+
+size_t Index::memoryUsage() const
+{
+    size_t usage = m_displayHost.size() * sizeof(uint32_t) * 2 + m_rowDisplay.size() * sizeof(uint32_t);
+    for (const Column &column : m_columns) {
+        usage += column.dictionary.size() * sizeof(EGLint) + column.codes8.size()
+            + column.codes16.size() * sizeof(uint16_t) + column.codes32.size() * sizeof(uint32_t);
+    }
+    for (const auto &set : m_extensionSets)
+        usage += set.size() * sizeof(uint32_t);
+    for (const std::string &name : m_extensionNames)
+        usage += name.size();
+    for (const auto &fingerprint : m_fingerprintRows)
+        usage += sizeof(fingerprint) + fingerprint.second.size() * sizeof(uint32_t);
+    return usage;
+}
+
+}
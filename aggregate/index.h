@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_AGGREGATE_INDEX_H
+#define EGLINFO_AGGREGATE_INDEX_H
+
+#include "hostrecord.h"
+#include "query.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace EglInfo {
+
+/**
+ * Columnar index over the configs of many hosts.
+ *
+ * Every config attribute is a dictionary encoded column with one row per config, using
+ * 8, 16 or 32 bit codes depending on the number of distinct values. Display extension
+ * strings are split into extension sets, which are shared between all displays with the
+ * same extensions. Config fingerprints are kept in a hash table for direct lookup.
+ * Cost model terms combine several columns and are evaluated on the decoded rows.
+ */
+class Index
+{
+public:
+    struct Result {
+        size_t hosts;
+        size_t displays;
+        size_t configs;
+        /** Indexes of the matching hosts, only filled if requested. */
+        std::vector<uint32_t> hostIndexes;
+    };
+
+    /** Builds the index from @p hosts, encoding the columns on up to @p threads threads. */
+    void build(std::vector<HostRecord>&& hosts, int threads);
+
+    Result query(const Query& query, bool listHosts, const CostModel& model = CostModel()) const;
+
+    size_t hostCount() const { return m_hostNames.size(); }
+    size_t displayCount() const { return m_displayHost.size(); }
+    size_t configCount() const { return m_rowDisplay.size(); }
+    size_t extensionSetCount() const { return m_extensionSets.size(); }
+    const std::string& hostName(uint32_t index) const { return m_hostNames[index]; }
+    /** Approximate memory used by the index, in bytes. */
+    size_t memoryUsage() const;
+
+private:
+    struct Column {
+        /** Distinct values, sorted. Code 0 means "not available", code i refers to dictionary[i - 1]. */
+        std::vector<EGLint> dictionary;
+        std::vector<uint8_t> codes8;
+        std::vector<uint16_t> codes16;
+        std::vector<uint32_t> codes32;
+    };
+
+    void buildColumn(int attribute, const std::vector<const ConfigInfo*>& rows);
+    /** Decodes @p attribute of @p row into @p config. */
+    void decode(int attribute, size_t row, ConfigInfo* config) const;
+    uint32_t extensionSet(const std::string& extensions);
+
+    std::vector<std::string> m_hostNames;
+    std::vector<uint32_t> m_displayHost;
+    std::vector<uint32_t> m_displayExtensionSet;
+    std::vector<std::vector<uint32_t>> m_extensionSets;
+    std::unordered_map<std::string, uint32_t> m_extensionSetIds;
+    std::vector<std::string> m_extensionNames;
+    std::unordered_map<std::string, uint32_t> m_extensionIds;
+    std::vector<uint32_t> m_rowDisplay;
+    /** Config fingerprint -> rows with that fingerprint. */
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_fingerprintRows;
+    Column m_columns[AttributeCount];
+};
+
+}
+
+#endif
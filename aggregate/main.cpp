@@ -0,0 +1,175 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * eglinfo-aggregate: answers config queries over eglinfo results collected from many hosts.
+ */
+
+#include "index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace EglInfo;
+
+static void printUsage(const char* argv0)
+{
+    cerr << "Usage: " << argv0 << " [options] FILE|DIRECTORY..." << endl
+         << "Reads eglinfo text output or snapshot files, one per host, and answers config queries." << endl
+         << "Queries are read from standard input, one per line, unless given as options." << endl
+         << "  --query QUERY  answer QUERY, e.g. \"renderable_type&OpenGL_ES3 samples>=4 depth_size>=24\"" << endl
+         << "  --list         also list the matching hosts" << endl
+         << "  --threads N    number of ingest threads (default: number of CPUs)" << endl;
+}
+
+static void addPath(const string& path, vector<string>* files)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        cerr << "Cannot access " << path << "." << endl;
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        files->push_back(path);
+        return;
+    }
+
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+        return;
+    vector<string> entries;
+    while (dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.')
+            entries.push_back(path + '/' + entry->d_name);
+    }
+    closedir(dir);
+    sort(entries.begin(), entries.end());
+    for (const string &entry : entries)
+        addPath(entry, files);
+}
+
+static double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static bool runQuery(const Index& index, const char* text, bool listHosts)
+{
+    Query query;
+    string error;
+    if (!parseQuery(text, &query, &error)) {
+        cerr << error << endl;
+        return false;
+    }
+
+    const auto start = chrono::steady_clock::now();
+    const Index::Result result = index.query(query, listHosts);
+    const double ms = elapsedMs(start);
+
+    cout << text << ": " << result.hosts << " host(s), " << result.displays << " display(s), "
+         << result.configs << " configuration(s) (" << ms << " ms)" << endl;
+    for (uint32_t host : result.hostIndexes)
+        cout << "  " << index.hostName(host) << endl;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    vector<string> queries;
+    vector<string> files;
+    bool listHosts = false;
+    int threads = max(1u, thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--query") == 0 && i + 1 < argc) {
+            queries.push_back(argv[++i]);
+        } else if (strcmp(argv[i], "--list") == 0) {
+            listHosts = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = max(1, atoi(argv[++i]));
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        } else {
+            addPath(argv[i], &files);
+        }
+    }
+    if (files.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const auto ingestStart = chrono::steady_clock::now();
+    vector<HostRecord> hosts(files.size());
+    vector<char> loaded(files.size(), 0);
+    atomic<size_t> nextFile(0);
+    mutex errorMutex;
+    vector<thread> workers;
+    for (int i = 0; i < min<int>(threads, files.size()); ++i) {
+        workers.emplace_back([&] {
+            for (size_t f = nextFile++; f < files.size(); f = nextFile++) {
+                string error;
+                loaded[f] = loadHost(files[f], &hosts[f], &error);
+                if (!loaded[f]) {
+                    lock_guard<mutex> lock(errorMutex);
+                    cerr << "Skipping " << files[f] << ": " << error << endl;
+                }
+            }
+        });
+    }
+    for (thread &worker : workers)
+        worker.join();
+
+    // drop unreadable hosts, keeping the file order
+    size_t kept = 0;
+    for (size_t f = 0; f < hosts.size(); ++f) {
+        if (!loaded[f])
+            continue;
+        if (kept != f)
+            hosts[kept] = std::move(hosts[f]);
+        ++kept;
+    }
+    hosts.resize(kept);
+
+    Index index;
+    index.build(std::move(hosts), threads);
+    cout << "Indexed " << index.hostCount() << " host(s), " << index.displayCount() << " display(s), "
+         << index.configCount() << " configuration(s), " << index.extensionSetCount() << " distinct extension set(s) in "
+         << elapsedMs(ingestStart) << " ms, using " << index.memoryUsage() / 1024 << " KiB." << endl;
+
+    bool ok = true;
+    if (!queries.empty()) {
+        for (const string &query : queries)
+            ok = runQuery(index, query.c_str(), listHosts) && ok;
+    } else {
+        string line;
+        while (getline(cin, line)) {
+            if (line.find_first_not_of(" \t") != string::npos)
+                ok = runQuery(index, line.c_str(), listHosts) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,2 @@
+TEMPLATE = subdirs
+SUBDIRS = snapshot encoding server
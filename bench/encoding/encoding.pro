@@ -0,0 +1,7 @@
+TEMPLATE = app
+TARGET = eglinfo-encoding-bench
+INCLUDEPATH += $$PWD/../../lib
+LIBS += -L$$OUT_PWD/../../lib -leglinfo
+PRE_TARGETDEPS += $$OUT_PWD/../../lib/libeglinfo.a
+include(../../eglinfo.pri)
+SOURCES += main.cpp
@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Measures size and decode throughput of the compact snapshot encoding (eglinfo --save).
+ */
+
+#include "encoding.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace EglInfo;
+
+int main(int argc, char** argv)
+{
+    double seconds = 1.0;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "--seconds") == 0) {
+        seconds = atof(argv[2]);
+        first = 3;
+    }
+    if (first >= argc) {
+        cerr << "Usage: " << argv[0] << " [--seconds S] FILE..." << endl
+             << "FILE may be eglinfo text output, a snapshot or an encoded snapshot." << endl;
+        return 1;
+    }
+
+    for (int i = first; i < argc; ++i) {
+        HostRecord host;
+        string error;
+        if (!loadHost(argv[i], &host, &error)) {
+            cerr << argv[i] << ": " << error << endl;
+            return 1;
+        }
+        struct stat st;
+        stat(argv[i], &st);
+
+        size_t configs = 0;
+        for (const HostDisplay &display : host.displays)
+            configs += display.configs.size();
+
+        string encoded;
+        encodeHost(host, &encoded);
+
+        HostRecord decoded;
+        size_t iterations = 0;
+        const auto start = chrono::steady_clock::now();
+        double elapsed = 0;
+        do {
+            if (!decodeHost(encoded.data(), encoded.size(), &decoded, &error)) {
+                cerr << argv[i] << ": decoding failed: " << error << endl;
+                return 1;
+            }
+            ++iterations;
+            elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        } while (elapsed < seconds);
+
+        for (size_t d = 0; d < host.displays.size(); ++d) {
+            for (size_t c = 0; c < host.displays[d].configs.size(); ++c) {
+                const ConfigInfo &a = host.displays[d].configs[c];
+                const ConfigInfo &b = decoded.displays[d].configs[c];
+                if (a.validMask != b.validMask || memcmp(a.values, b.values, sizeof(a.values)) != 0) {
+                    cerr << argv[i] << ": round trip mismatch in display " << d << ", configuration " << c << endl;
+                    return 1;
+                }
+            }
+        }
+
+        cout << argv[i] << ": " << host.displays.size() << " display(s), " << configs << " configuration(s), "
+             << st.st_size << " bytes -> " << encoded.size() << " bytes encoded, "
+             << fixed << setprecision(1) << iterations * configs / elapsed / 1e6 << " M configurations/s decoded" << endl;
+    }
+    return 0;
+}
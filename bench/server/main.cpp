@@ -0,0 +1,141 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/*
+ * Measures connection setup and query latency and throughput against eglinfo --serve.
+ */
+
+#include "serverclient.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace EglInfo;
+
+static void printLatencies(const char* name, vector<double>* samples)
+{
+    if (samples->empty())
+        return;
+    sort(samples->begin(), samples->end());
+    cout << fixed << setprecision(0) << name << ": min " << samples->front()
+         << " ns, median " << (*samples)[samples->size() / 2]
+         << " ns, p99 " << (*samples)[samples->size() * 99 / 100]
+         << " ns, max " << samples->back() << " ns" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    const string defaultPath = defaultServerPath();
+    const char* path = defaultPath.c_str();
+    const char* query = "renderable_type&OpenGL_ES2 depth_size>=24";
+    int clients = max(1u, thread::hardware_concurrency());
+    double seconds = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc) {
+            clients = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--query") == 0 && i + 1 < argc) {
+            query = argv[++i];
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--clients N] [--seconds S] [--query QUERY] [socket path]" << endl;
+            return 1;
+        }
+    }
+
+    if (!*path) {
+        cerr << "XDG_RUNTIME_DIR is not set, pass the socket path." << endl;
+        return 1;
+    }
+    ServerClient client;
+    if (!client.connect(path)) {
+        perror(path);
+        return 1;
+    }
+    vector<ServerMatch> matches;
+    if (!client.findConfigs(query, &matches)) {
+        cerr << "Query failed: " << (client.lastError().empty() ? "connection lost" : client.lastError()) << endl;
+        return 1;
+    }
+    cout << "Server " << path << ": " << client.displayCount() << " display(s), " << matches.size()
+         << " configuration(s) match \"" << query << "\"." << endl;
+    client.close();
+
+    // what every short-lived process pays instead of eglInitialize()
+    vector<double> connectSamples;
+    for (int i = 0; i < 1000; ++i) {
+        const auto start = chrono::steady_clock::now();
+        if (!client.connect(path)) {
+            perror(path);
+            return 1;
+        }
+        client.findConfigs(query, &matches, ServerAllDisplays, 1);
+        connectSamples.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+        client.close();
+    }
+    printLatencies("Connect and first query", &connectSamples);
+
+    vector<vector<double>> samples(clients);
+    atomic<bool> failed(false);
+    const auto deadline = chrono::steady_clock::now() + chrono::duration<double>(seconds);
+    vector<thread> threads;
+    for (int t = 0; t < clients; ++t) {
+        threads.emplace_back([&, t] {
+            ServerClient threadClient;
+            vector<ServerMatch> threadMatches;
+            if (!threadClient.connect(path)) {
+                failed = true;
+                return;
+            }
+            samples[t].reserve(1 << 16);
+            for (auto now = chrono::steady_clock::now(); now < deadline;) {
+                if (!threadClient.findConfigs(query, &threadMatches)) {
+                    failed = true;
+                    return;
+                }
+                const auto end = chrono::steady_clock::now();
+                samples[t].push_back(chrono::duration<double, nano>(end - now).count());
+                now = end;
+            }
+        });
+    }
+    for (thread &t : threads)
+        t.join();
+    if (failed) {
+        cerr << "A client failed." << endl;
+        return 1;
+    }
+
+    vector<double> all;
+    for (const vector<double> &s : samples)
+        all.insert(all.end(), s.begin(), s.end());
+    cout << "Query with " << clients << " client(s): " << fixed << setprecision(0) << all.size() / seconds << " requests/s" << endl;
+    printLatencies("Query", &all);
+    return 0;
+}
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = eglinfo-server-bench
+INCLUDEPATH += $$PWD/../../lib $$PWD/../../client
+LIBS += -L$$OUT_PWD/../../client -leglinfo-client
+PRE_TARGETDEPS += $$OUT_PWD/../../client/libeglinfo-client.a
+CONFIG += egl_headers_only
+include(../../eglinfo.pri)
+SOURCES += main.cpp
@@ -0,0 +1,111 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Measures lookup latency on a snapshot published by eglinfo --publish.
+ */
+
+#include "snapshotreader.h"
+
+#include <EGL/egl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace EglInfo;
+
+template <typename F>
+static void benchmark(const char* name, int iterations, F f)
+{
+    vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = chrono::steady_clock::now();
+        f();
+        const auto end = chrono::steady_clock::now();
+        samples.push_back(chrono::duration<double, nano>(end - start).count());
+    }
+    sort(samples.begin(), samples.end());
+    cout << fixed << setprecision(0) << name << ": min " << samples.front()
+         << " ns, median " << samples[samples.size() / 2]
+         << " ns, p99 " << samples[samples.size() * 99 / 100]
+         << " ns, max " << samples.back() << " ns" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    const char* name = EGLINFO_SNAPSHOT_DEFAULT_NAME;
+    int iterations = 100000;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = max(1, atoi(argv[++i]));
+        } else if (argv[i][0] != '-') {
+            name = argv[i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--iterations N] [snapshot name]" << endl;
+            return 1;
+        }
+    }
+
+    SnapshotReader reader;
+    if (!reader.open(name)) {
+        perror("Could not open snapshot");
+        return 1;
+    }
+
+    uint32_t displays = 0, configs = 0;
+    if (!reader.read([&] { displays = reader.header()->displayCount; configs = reader.header()->configCount; })) {
+        cerr << "No valid snapshot in " << name << "." << endl;
+        return 1;
+    }
+    cout << "Snapshot " << name << ": " << displays << " display(s), " << configs << " configuration(s), generation " << reader.generation() << "." << endl;
+
+    SnapshotMatch match;
+    const SnapshotTerm es3Msaa[] = {
+        { EGL_RENDERABLE_TYPE, SnapshotTerm::HasBits, EGL_OPENGL_ES3_BIT },
+        { EGL_SAMPLES, SnapshotTerm::AtLeast, 4 },
+        { EGL_DEPTH_SIZE, SnapshotTerm::AtLeast, 24 }
+    };
+    benchmark("First ES3 config with 4x MSAA and 24 bit depth", iterations, [&] {
+        reader.findConfig(es3Msaa, 3, &match);
+    });
+
+    const SnapshotTerm none[] = { { EGL_CONFIG_ID, SnapshotTerm::Equal, -1 } };
+    benchmark("Full scan without match", iterations, [&] {
+        reader.findConfig(none, 1, &match);
+    });
+
+    char vendor[256];
+    benchmark("Vendor of the last display", iterations, [&] {
+        reader.read([&] {
+            const SnapshotDisplay *display = reader.display(reader.header()->displayCount - 1);
+            const char *str = display ? reader.string(display->vendor) : nullptr;
+            vendor[0] = '\0';
+            if (str)
+                strncat(vendor, str, sizeof(vendor) - 1);
+        });
+    });
+
+    return 0;
+}
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = eglinfo-snapshot-bench
+INCLUDEPATH += $$PWD/../../lib $$PWD/../../reader
+LIBS += -L$$OUT_PWD/../../reader -leglinfo-reader -lrt
+PRE_TARGETDEPS += $$OUT_PWD/../../reader/libeglinfo-reader.a
+CONFIG += egl_headers_only
+include(../../eglinfo.pri)
+SOURCES += main.cpp
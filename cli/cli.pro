@@ -0,0 +1,13 @@
+TEMPLATE = app
+TARGET = eglinfo
+INCLUDEPATH += $$PWD/../lib
+LIBS += -L$$OUT_PWD/../lib -leglinfo -lrt
+PRE_TARGETDEPS += $$OUT_PWD/../lib/libeglinfo.a
+include(../eglinfo.pri)
+HEADERS += \
+    server.h \
+    sweep.h
+SOURCES += \
+    main.cpp \
+    server.cpp \
+    sweep.cpp
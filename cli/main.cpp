@@ -0,0 +1,998 @@
+/*
+    Copyright (C) 2012 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+    Author: Volker Krause <volker.krause@kdab.com>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "contextinfo.h"
+#include "contextmatrix.h"
+#include "costmodel.h"
+#include "encoding.h"
+#include "imagebench.h"
+#include "latency.h"
+#include "pbufferlimit.h"
+#include "probe.h"
+#include "query.h"
+#include "recommend.h"
+#include "serverprotocol.h"
+#include "server.h"
+#include "shaderbench.h"
+#include "snapshotwriter.h"
+#include "sweep.h"
+#include "syncbench.h"
+#include "timeline.h"
+#include "tracepoints.h"
+#include "transferbench.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <strings.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace EglInfo;
+
+static void printOutputCount(const OutputCount& count, const char* function, const char* what, const char* indent)
+{
+    switch (count.state) {
+        case OutputCount::NotQueried:
+            break;
+        case OutputCount::Unresolved:
+            cout << indent << "Failed to resolve " << function << " function." << endl;
+            break;
+        case OutputCount::QueryFailed:
+            cout << indent << "Failed to query output " << what << "." << endl;
+            break;
+        case OutputCount::Ok:
+            cout << indent << "Found " << count.count << " output " << what << "." << endl;
+            break;
+    }
+}
+
+static void printContexts(const DisplayInfo& info, const char* indent)
+{
+    vector<ContextInfo> contexts;
+    probeContexts(info, &contexts);
+    for (const ContextInfo &context : contexts) {
+        cout << indent << apiName(context.api) << " context";
+        if (context.surfaceless || context.noConfig)
+            cout << " (" << (context.surfaceless ? "surfaceless" : "") << (context.surfaceless && context.noConfig ? ", " : "") << (context.noConfig ? "no config" : "") << ")";
+        cout << ":" << endl;
+        switch (context.state) {
+            case ContextInfo::BindFailed:
+                cout << indent << "  Failed to bind the client API." << endl;
+                continue;
+            case ContextInfo::NoConfig:
+                cout << indent << "  No suitable configuration found." << endl;
+                continue;
+            case ContextInfo::CreateFailed:
+                cout << indent << "  Failed to create context." << endl;
+                continue;
+            case ContextInfo::SurfaceFailed:
+                cout << indent << "  Failed to create pbuffer surface." << endl;
+                continue;
+            case ContextInfo::MakeCurrentFailed:
+                cout << indent << "  Failed to make context current." << endl;
+                continue;
+            case ContextInfo::Unresolved:
+                cout << indent << "  Failed to resolve GL functions." << endl;
+                continue;
+            case ContextInfo::Ok:
+                break;
+        }
+        cout << indent << "  GL vendor: " << context.vendor << endl;
+        cout << indent << "  GL renderer: " << context.renderer << endl;
+        cout << indent << "  GL version: " << context.version << endl;
+        cout << indent << "  GLSL version: " << context.shadingLanguageVersion << endl;
+        cout << indent << "  Max texture size: " << context.maxTextureSize << endl;
+        cout << indent << "  Max renderbuffer size: " << context.maxRenderbufferSize << endl;
+        cout << indent << "  Max viewport dims: " << context.maxViewportDims[0] << "x" << context.maxViewportDims[1] << endl;
+        cout << indent << "  Max samples: " << context.maxSamples << endl;
+        cout << indent << "  GL extensions: " << context.extensions << endl;
+    }
+}
+
+/** How configurations are selected, ordered and annotated when printing a display. */
+struct PrintOptions {
+    Query filter;
+    CostModel costModel;
+    /** Attribute index, QueryTerm::FrameBytesTerm or QueryTerm::BandwidthTerm to sort by, or INT_MIN for probe order. */
+    int sortKey = INT_MIN;
+    bool sortDescending = false;
+    bool withContexts = false;
+};
+
+static bool parseSortKey(const char* text, PrintOptions* options)
+{
+    options->sortDescending = *text == '-';
+    if (options->sortDescending)
+        ++text;
+    if (strcasecmp(text, "frame_bytes") == 0)
+        options->sortKey = QueryTerm::FrameBytesTerm;
+    else if (strcasecmp(text, "bandwidth") == 0)
+        options->sortKey = QueryTerm::BandwidthTerm;
+    else
+        options->sortKey = attributeIndex(text, strlen(text));
+    return options->sortKey != -1;
+}
+
+static int64_t sortValue(const ConfigInfo& config, const PrintOptions& options)
+{
+    if (options.sortKey == QueryTerm::FrameBytesTerm)
+        return frameBytes(config, options.costModel);
+    if (options.sortKey == QueryTerm::BandwidthTerm)
+        return writeBandwidth(config, options.costModel);
+    // configs without the attribute go last
+    if (!config.isValid(options.sortKey))
+        return options.sortDescending ? INT64_MIN : INT64_MAX;
+    return config.values[options.sortKey];
+}
+
+/** Indexes of the configs of @p info matching the filter of @p options, in the requested order. */
+static vector<int> selectConfigs(const DisplayInfo& info, const PrintOptions& options)
+{
+    vector<int> order;
+    for (int i = 0; i < static_cast<int>(info.configs.size()); ++i) {
+        if (matchesConfig(options.filter, info.configs[i], info.extensions, options.costModel))
+            order.push_back(i);
+    }
+    if (options.sortKey != INT_MIN) {
+        // stable, so configs with equal keys stay in the order of the driver
+        stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            const int64_t valueA = sortValue(info.configs[a], options);
+            const int64_t valueB = sortValue(info.configs[b], options);
+            return options.sortDescending ? valueA > valueB : valueA < valueB;
+        });
+    }
+    return order;
+}
+
+static void printConfig(const ConfigInfo& config, int index, const CostModel& costModel, const char* indent)
+{
+    cout << indent << "Configuration " << index << ":" << endl;
+    cout << indent << "  Fingerprint: 0x" << hex << setfill('0') << setw(16) << config.fingerprint() << dec << setfill(' ') << endl;
+    for (int j = 0; j < attributesSize; ++j) {
+        const attrib_t *attr = &attributes[j];
+        cout << indent << "  " << attr->displayName << ": ";
+        if (config.isValid(j))
+            printAttributeValue(cout, attr, config.values[j]);
+        else
+            cout << "<failed>";
+        cout << endl;
+    }
+    cout << indent << "  Estimated frame size at " << costModel.width << "x" << costModel.height << ": ";
+    printByteAmount(cout, frameBytes(config, costModel));
+    cout << endl << indent << "  Estimated write bandwidth at " << costModel.refreshRate << " Hz: ";
+    printByteAmount(cout, writeBandwidth(config, costModel));
+    cout << "/s" << endl;
+}
+
+static void printDmaBufFormats(const DmaBufFormats& formats, const char* indent)
+{
+    switch (formats.state) {
+        case DmaBufFormats::NotQueried:
+            return;
+        case DmaBufFormats::Unsupported:
+            cout << indent << "DMA-BUF import with modifiers not supported." << endl;
+            return;
+        case DmaBufFormats::Unresolved:
+            cout << indent << "Failed to resolve eglQueryDmaBufFormatsEXT function." << endl;
+            return;
+        case DmaBufFormats::QueryFailed:
+            cout << indent << "Failed to query DMA-BUF formats." << endl;
+            return;
+        case DmaBufFormats::Ok:
+            break;
+    }
+
+    cout << indent << "Found " << formats.formats.size() << " DMA-BUF formats." << endl;
+    for (const DmaBufFormat &format : formats.formats) {
+        cout << indent << "  " << fourccName(format.fourcc) << " (0x" << hex << setfill('0') << setw(8) << format.fourcc << "):";
+        if (format.modifierCount == 0)
+            cout << " implicit modifier only";
+        for (uint32_t i = 0; i < format.modifierCount; ++i) {
+            const DmaBufModifier &modifier = formats.modifiers[format.firstModifier + i];
+            cout << (i ? ", " : " ") << "0x" << setw(16) << modifier.modifier;
+            if (modifier.externalOnly)
+                cout << " external only";
+        }
+        cout << dec << setfill(' ') << endl;
+    }
+}
+
+static void printByteDelta(int64_t bytes)
+{
+    cout << (bytes < 0 ? "-" : "+");
+    printByteAmount(cout, bytes < 0 ? -bytes : bytes);
+}
+
+static void printMemoryDelta(const char* phase, const MemoryDelta& delta, const char* indent)
+{
+    cout << indent << "Memory cost of " << phase << ": RSS ";
+    printByteDelta(delta.rss);
+    cout << ", PSS ";
+    printByteDelta(delta.pss);
+    cout << ", anonymous ";
+    printByteDelta(delta.anonymous);
+    cout << ", mapped files ";
+    printByteDelta(delta.mappedFiles);
+    cout << endl;
+}
+
+static void printMemoryCost(const MemoryCost& cost, const char* indent)
+{
+    switch (cost.state) {
+    case MemoryCost::NotMeasured:
+        return;
+    case MemoryCost::Unavailable:
+        cout << indent << "Memory cost not available." << endl;
+        return;
+    case MemoryCost::Ok:
+        break;
+    }
+
+    printMemoryDelta("eglInitialize()", cost.initialize, indent);
+    for (const MappedObject &object : cost.initializeObjects) {
+        cout << indent << "  " << object.path << ": ";
+        printByteAmount(cout, object.bytes);
+        cout << endl;
+    }
+    printMemoryDelta("config enumeration", cost.configs, indent);
+}
+
+static void printDisplay(const DisplayInfo& info, const PrintOptions& options, const char* indent = "")
+{
+    EGLINFO_TRACE1(print_display_entry, info.display);
+    if (info.state == DisplayInfo::InitializeFailed) {
+        cerr << "Could not initialize EGL!" << endl;
+        exit(1);
+    }
+
+    cout << indent << "EGL version: " << info.majorVersion << "." << info.minorVersion << endl;
+    cout << indent << "Client APIs for display: " << (info.clientAPIs ? info.clientAPIs : "") << endl;
+    cout << indent << "Vendor: " << (info.vendor ? info.vendor : "") << endl;
+    cout << indent << "Display extensions: " << (info.extensions ? info.extensions : "") << endl;
+
+    printOutputCount(info.outputLayers, "eglGetOutputLayersEXT", "layers", indent);
+    printOutputCount(info.outputPorts, "eglGetOutputPortsEXT", "ports", indent);
+    printMemoryCost(info.memoryCost, indent);
+
+    if (options.withContexts)
+        printContexts(info, indent);
+    printDmaBufFormats(info.dmaBufFormats, indent);
+
+    if (info.state == DisplayInfo::ConfigCountFailed) {
+        cerr << "Could not retrieve the number of EGL configurations!" << endl;
+        exit(1);
+    }
+
+    cout << indent << "Found " << info.numConfigs << " configurations." << endl;
+
+    if (info.state == DisplayInfo::ConfigsFailed) {
+        cerr << "Could not retrieve EGL configurations!" << endl;
+        exit(1);
+    }
+
+    for (int i : selectConfigs(info, options)) {
+        printConfig(info.configs[i], i, options.costModel, indent);
+        cout << endl;
+    }
+    EGLINFO_TRACE1(print_display_return, info.display);
+}
+
+#ifdef EGL_EXT_device_base
+static void printTopology(const DeviceTopology& topology)
+{
+    switch (topology.state) {
+    case DeviceTopology::NotQueried:
+        break;
+    case DeviceTopology::NoDrmDevice:
+        cout << "  No DRM device file, topology unknown." << endl;
+        break;
+    case DeviceTopology::NotFound:
+        cout << "  DRM device not found in sysfs, topology unknown." << endl;
+        break;
+    case DeviceTopology::Ok:
+        if (!topology.pciAddress.empty())
+            cout << "  PCI address: " << topology.pciAddress << endl;
+        if (topology.numaNode >= 0)
+            cout << "  NUMA node: " << topology.numaNode << endl;
+        if (!topology.localCpus.empty())
+            cout << "  Local CPUs: " << topology.localCpus << endl;
+        if (!topology.renderNode.empty())
+            cout << "  Render node: " << topology.renderNode << endl;
+        break;
+    }
+}
+
+static void printDevices(const DeviceList& list, const PrintOptions& options)
+{
+    EGLINFO_TRACE1(print_devices_entry, list.devices.size());
+    if (list.state == DeviceList::QueryFailed) {
+        cout << "Failed to query devices." << endl << endl;
+        EGLINFO_TRACE0(print_devices_return);
+        return;
+    }
+    if (list.devices.empty()) {
+        cout << "Found no devices." << endl << endl;
+        EGLINFO_TRACE0(print_devices_return);
+        return;
+    }
+
+    cout << "Found " << list.devices.size() << " device(s)." << endl;
+
+    for (int i = 0; i < static_cast<int>(list.devices.size()); ++i) {
+        TimelineSpan span("print device", isTimelineEnabled() ? "device " + to_string(i) : string());
+        const DeviceInfo &device = list.devices[i];
+        cout << "Device " << i << ":" << endl;
+        if (device.extensions) {
+            cout << "  Device Extensions: ";
+            if (device.extensions[0])
+                cout << device.extensions << endl;
+            else
+                cout << "none" << endl;
+        } else {
+            cout << "  Failed to retrieve device extensions." << endl;
+        }
+
+        for (int j = 0; j < devicePropertiesSize; ++j) {
+            const DevicePropertyValue &value = device.properties[j];
+            if (!value.present)
+                continue;
+            cout << "  " << deviceProperties[j].displayName << ": ";
+            if (deviceProperties[j].type == device_property_t::String)
+                cout << value.string << endl;
+            else
+                cout << value.attrib << endl;
+        }
+        printTopology(device.topology);
+
+        if (!device.hasDisplay) {
+            cout << "  No attached display." << endl;
+        } else {
+            cout << "  Device display:" << endl;
+            printDisplay(device.display, options, "    ");
+        }
+
+        cout << endl;
+    }
+    EGLINFO_TRACE0(print_devices_return);
+}
+#endif
+
+/** Calls @p f with a label for every display of @p result that was initialized successfully. */
+template <typename F>
+static void forEachDisplay(const ProbeResult& result, F f)
+{
+#ifdef EGL_EXT_device_base
+    for (int i = 0; i < static_cast<int>(result.devices.devices.size()); ++i) {
+        const DeviceInfo &device = result.devices.devices[i];
+        if (device.hasDisplay && device.display.state == DisplayInfo::Ok)
+            f(device.display, "Device " + to_string(i) + " display");
+    }
+#endif
+    if (result.hasDefaultDisplay && result.defaultDisplay.state == DisplayInfo::Ok)
+        f(result.defaultDisplay, string("Default display"));
+}
+
+static void printSyncBenchmark(const DisplayInfo& info, int iterations)
+{
+    SyncBenchmark bench;
+    benchmarkSync(info, iterations, &bench);
+    switch (bench.state) {
+        case SyncBenchmark::Unsupported:
+            cout << "  EGL_KHR_fence_sync not supported." << endl;
+            return;
+        case SyncBenchmark::Unresolved:
+            cout << "  Failed to resolve fence sync functions." << endl;
+            return;
+        case SyncBenchmark::ContextFailed:
+            cout << "  Failed to make a " << apiName(bench.api) << " context current." << endl;
+            return;
+        case SyncBenchmark::SyncFailed:
+            cout << "  Fence sync failed." << endl;
+            return;
+        case SyncBenchmark::Ok:
+            break;
+    }
+    cout << "  Fences on " << apiName(bench.api) << " context:" << endl;
+    bench.clientWait.print(cout, "Create + client wait (EGL_KHR_fence_sync)", "  ");
+    if (!bench.serverWait.isEmpty())
+        bench.serverWait.print(cout, "Create + server wait (EGL_KHR_wait_sync)", "  ");
+    if (!bench.nativeFence.isEmpty())
+        bench.nativeFence.print(cout, "Create + flush + dup fd (EGL_ANDROID_native_fence_sync)", "  ");
+}
+
+static const char* errorName(EGLint error)
+{
+    switch (error) {
+        case EGL_BAD_ALLOC:
+            return "EGL_BAD_ALLOC";
+        case EGL_BAD_ATTRIBUTE:
+            return "EGL_BAD_ATTRIBUTE";
+        case EGL_BAD_CONFIG:
+            return "EGL_BAD_CONFIG";
+        case EGL_BAD_MATCH:
+            return "EGL_BAD_MATCH";
+        case EGL_BAD_PARAMETER:
+            return "EGL_BAD_PARAMETER";
+    }
+    return "an unexpected error";
+}
+
+static void printImageBenchmark(const DisplayInfo& info, int iterations)
+{
+    ImageBenchmark bench;
+    benchmarkImages(info, iterations, &bench);
+    switch (bench.state) {
+        case ImageBenchmark::Unsupported:
+            cout << "  " << bench.missing << " not supported." << endl;
+            return;
+        case ImageBenchmark::Unresolved:
+            cout << "  Failed to resolve EGLImage functions." << endl;
+            return;
+        case ImageBenchmark::ContextFailed:
+            cout << "  Failed to make a " << apiName(bench.api) << " context current." << endl;
+            return;
+        case ImageBenchmark::CreateFailed:
+            cout << "  eglCreateImageKHR failed with " << errorName(bench.error) << " (0x" << hex << bench.error << dec << ")." << endl;
+            return;
+        case ImageBenchmark::ImportFailed:
+            cout << "  glEGLImageTargetTexture2DOES failed in the consumer context." << endl;
+            return;
+        case ImageBenchmark::Ok:
+            break;
+    }
+    cout << "  " << bench.width << "x" << bench.height << " RGBA textures shared between two " << apiName(bench.api)
+         << " contexts on separate threads:" << endl;
+    bench.create.print(cout, "eglCreateImageKHR (EGL_KHR_gl_texture_2D_image)", "  ");
+    bench.import.print(cout, "Import (GL_OES_EGL_image)", "  ");
+    bench.destroy.print(cout, "eglDestroyImageKHR", "  ");
+    const char *synchronization = "glFinish";
+    if (bench.synchronization == ImageBenchmark::ClientWait)
+        synchronization = "EGL_KHR_fence_sync, client waits";
+    else if (bench.synchronization == ImageBenchmark::ServerWait)
+        synchronization = "EGL_KHR_fence_sync, server waits";
+    bench.frame.print(cout, (string("Frame round trip (") + synchronization + ")").c_str(), "  ");
+    if (bench.framesChecked == 0)
+        cout << "    The consumer could not read the imported texture, contents not checked." << endl;
+    else
+        cout << "    The consumer saw the producer's update in " << bench.framesMatched << " of " << bench.framesChecked << " frames." << endl;
+}
+
+static void printPbufferLimits(const DisplayInfo& info, const PrintOptions& options, int budgetMs)
+{
+    for (int i : selectConfigs(info, options)) {
+        PbufferLimit limit;
+        probePbufferLimit(info.display, info.configs[i], budgetMs, &limit);
+        cout << "  Configuration " << i << ": ";
+        switch (limit.state) {
+            case PbufferLimit::Unsupported:
+                cout << "no pbuffer support." << endl;
+                continue;
+            case PbufferLimit::CreateFailed:
+                cout << "failed to create a 1x1 pbuffer." << endl;
+                break;
+            case PbufferLimit::Ok:
+                cout << "reported " << limit.reportedWidth << "x" << limit.reportedHeight << " (" << limit.reportedPixels
+                     << " pixels), created " << limit.size << "x" << limit.size
+                     << (limit.budgetExceeded ? " before running out of time" : "") << "." << endl;
+                break;
+        }
+        for (const PbufferAttempt &attempt : limit.attempts) {
+            cout << "    " << attempt.width << "x" << attempt.height << ": ";
+            if (attempt.error == EGL_SUCCESS)
+                cout << "created in ";
+            else
+                cout << "failed with " << errorName(attempt.error) << " (0x" << hex << attempt.error << dec << ") in ";
+            cout << formatDuration(attempt.nanoseconds) << endl;
+        }
+    }
+}
+
+static void printShaderBenchmark(const DisplayInfo& info, int iterations)
+{
+    for (EGLenum api : supportedApis(info)) {
+        ShaderBenchmark bench;
+        benchmarkShaders(info, api, iterations, &bench);
+        switch (bench.state) {
+            case ShaderBenchmark::ContextFailed:
+                cout << "  Failed to make a " << apiName(api) << " context current." << endl;
+                continue;
+            case ShaderBenchmark::Unresolved:
+                cout << "  Failed to resolve shader functions for " << apiName(api) << "." << endl;
+                continue;
+            case ShaderBenchmark::Ok:
+                break;
+        }
+        cout << "  " << bench.language << " corpus on " << apiName(api) << " context (" << bench.version
+             << "), median of " << iterations << ":" << endl;
+        for (const ShaderProgramBenchmark &program : bench.programs) {
+            cout << "    " << program.name << ": ";
+            if (!program.ok) {
+                cout << "failed" << endl << program.log << endl;
+                continue;
+            }
+            cout << "vertex " << formatDuration(program.cold.vertex.percentile(50))
+                 << ", fragment " << formatDuration(program.cold.fragment.percentile(50))
+                 << ", link " << formatDuration(program.cold.link.percentile(50)) << endl;
+            if (bench.blobCache) {
+                cout << "      from blob cache: vertex " << formatDuration(program.warm.vertex.percentile(50))
+                     << ", fragment " << formatDuration(program.warm.fragment.percentile(50))
+                     << ", link " << formatDuration(program.warm.link.percentile(50)) << endl;
+            }
+        }
+        if (bench.blobCache)
+            cout << "    EGL_ANDROID_blob_cache: " << bench.cacheStores << " binaries stored, " << bench.cacheHits << " hits." << endl;
+        else
+            cout << "    EGL_ANDROID_blob_cache not supported, no warm compile times." << endl;
+    }
+}
+
+static void printTransferBenchmark(const DisplayInfo& info, int iterations)
+{
+    for (EGLenum api : supportedApis(info)) {
+        TransferBenchmark bench;
+        benchmarkTransfers(info, api, iterations, &bench);
+        switch (bench.state) {
+            case TransferBenchmark::ContextFailed:
+                cout << "  Failed to make a " << apiName(api) << " context current." << endl;
+                continue;
+            case TransferBenchmark::Unresolved:
+                cout << "  Failed to resolve texture and framebuffer functions for " << apiName(api) << "." << endl;
+                continue;
+            case TransferBenchmark::Ok:
+                break;
+        }
+        cout << "  " << apiName(api) << " context (" << bench.version << "), median of " << iterations << ":" << endl;
+        const TransferMeasurement *previous = nullptr;
+        for (const TransferMeasurement &measurement : bench.measurements) {
+            if (!previous || previous->path != measurement.path || previous->format != measurement.format)
+                cout << "    " << transferPathName(measurement.path) << " " << measurement.format << ":" << endl;
+            previous = &measurement;
+            cout << "      " << measurement.width << "x" << measurement.height << " (";
+            printByteAmount(cout, measurement.bytes);
+            cout << "): ";
+            if (!measurement.ok) {
+                cout << "not supported" << endl;
+                continue;
+            }
+            if (!measurement.issue.isEmpty())
+                cout << "issue " << formatDuration(measurement.issue.percentile(50)) << ", total ";
+            cout << formatDuration(measurement.latency.percentile(50)) << ", " << fixed << setprecision(2)
+                 << measurement.throughput() << defaultfloat << " GB/s" << endl;
+        }
+        if (!bench.pixelBuffers)
+            cout << "    No pixel buffer objects (needs " << (api == EGL_OPENGL_API ? "GL" : "GLES") << " 3.0), no PBO readback." << endl;
+    }
+}
+
+static string flavorName(const ContextFlavor& flavor)
+{
+    string name = apiName(flavor.api);
+    if (flavor.minorVersion >= 0)
+        name += " " + to_string(flavor.majorVersion) + "." + to_string(flavor.minorVersion);
+    else if (flavor.api == EGL_OPENGL_ES_API)
+        name += " " + to_string(flavor.majorVersion) + ".x";
+    if (flavor.profile == EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR)
+        name += " core";
+    else if (flavor.profile == EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR)
+        name += " compat";
+    return name;
+}
+
+static const char* priorityName(EGLint priority)
+{
+    switch (priority) {
+        case EGL_CONTEXT_PRIORITY_LOW_IMG:
+            return "low";
+        case EGL_CONTEXT_PRIORITY_MEDIUM_IMG:
+            return "medium";
+        case EGL_CONTEXT_PRIORITY_HIGH_IMG:
+            return "high";
+    }
+    return "not requested";
+}
+
+static void printContextMatrix(const DisplayInfo& info, int threads)
+{
+    ContextMatrix matrix;
+    probeContextMatrix(info, threads, &matrix);
+    if (matrix.flavors.empty()) {
+        cout << "  No OpenGL or OpenGL ES support." << endl;
+        return;
+    }
+
+    cout << "  eglCreateContext latency in us on " << threads << " thread(s); - rejected, ! no config,"
+         << " * lower priority granted:" << endl;
+    for (size_t p = 0; p < matrix.priorities.size(); ++p) {
+        if (matrix.priorities.size() > 1)
+            cout << "  Priority " << priorityName(matrix.priorities[p]) << ":" << endl;
+        vector<int> widths;
+        cout << "    " << left << setw(24) << "";
+        for (int flags : matrix.flagSets) {
+            const char *name = flags == (ContextMatrix::Robust | ContextMatrix::NoError) ? "robust+no-error"
+                : flags == ContextMatrix::Robust ? "robust" : flags == ContextMatrix::NoError ? "no-error" : "default";
+            widths.push_back(max<int>(9, strlen(name) + 2));
+            cout << right << setw(widths.back()) << name;
+        }
+        cout << endl;
+        for (size_t f = 0; f < matrix.flavors.size(); ++f) {
+            cout << "    " << left << setw(24) << flavorName(matrix.flavors[f]) << right;
+            for (size_t flagSet = 0; flagSet < matrix.flagSets.size(); ++flagSet) {
+                const ContextAttempt &attempt = matrix.attempt(f, flagSet, p);
+                string cell;
+                if (attempt.created) {
+                    cell = to_string((attempt.nanoseconds + 500) / 1000);
+                    // EGL_CONTEXT_PRIORITY_HIGH_IMG < MEDIUM < LOW
+                    if (attempt.grantedPriority > attempt.priority)
+                        cell += '*';
+                } else {
+                    cell = attempt.error == EGL_SUCCESS ? "!" : "-";
+                }
+                cout << setw(widths[flagSet]) << cell;
+            }
+            cout << endl;
+        }
+    }
+}
+
+/** Resolves @p name to a built-in profile or loads it from the file @p name. */
+static bool loadProfile(const string& name, Profile* profile)
+{
+    if (const Profile *builtin = findProfile(name)) {
+        *profile = *builtin;
+        return true;
+    }
+
+    ifstream file(name);
+    if (!file) {
+        cerr << "Unknown profile \"" << name << "\". Built-in profiles:" << endl;
+        for (const Profile &builtin : builtinProfiles())
+            cerr << "  " << left << setw(20) << builtin.name << right << builtin.description << endl;
+        return false;
+    }
+    stringstream text;
+    text << file.rdbuf();
+    profile->name = name.substr(name.find_last_of('/') + 1);
+    const size_t dot = profile->name.rfind('.');
+    if (dot != string::npos && dot > 0)
+        profile->name.resize(dot);
+    string error;
+    if (!parseProfile(text.str().c_str(), profile, &error)) {
+        cerr << name << ": " << error << endl;
+        return false;
+    }
+    return true;
+}
+
+static void printRecommendation(const DisplayInfo& info, const Profile& profile, const CostModel& costModel)
+{
+    const Recommendation recommendation = recommendConfig(profile, info.configs, info.extensions);
+    if (recommendation.configIndex < 0) {
+        cout << "  No configuration meets the requirements of " << profile.name << "." << endl;
+        return;
+    }
+    cout << "  Recommended for " << profile.name << " with score " << recommendation.score << ":" << endl;
+    printConfig(info.configs[recommendation.configIndex], recommendation.configIndex, costModel, "  ");
+}
+
+static const char* traceFile = nullptr;
+
+static void writeTraceFile()
+{
+    if (!writeTimeline(traceFile))
+        perror(traceFile);
+}
+
+static void printUsage(const char* argv0)
+{
+    cerr << "Usage: " << argv0 << " [options]" << endl
+         << "  --publish[=NAME]  publish the probe result as a snapshot in shared memory" << endl
+         << "                    (default " << EGLINFO_SNAPSHOT_DEFAULT_NAME << ") instead of printing it" << endl
+         << "  --save=FILE       save the probe result in the compact encoding to FILE instead of printing it" << endl
+         << "  --serve[=PATH]    answer config and extension queries from clients on the Unix socket PATH" << endl
+         << "                    (default $XDG_RUNTIME_DIR/" EGLINFO_SERVER_SOCKET_NAME ") until interrupted, probing only once" << endl
+         << "  --filter=QUERY    only print configurations matching QUERY, e.g. \"samples>=4 depth_size>=24\"" << endl
+         << "                    or \"fingerprint=0x0123456789abcdef\" or \"bandwidth<=2g\"" << endl
+         << "  --sort=KEY        print configurations ordered by KEY, an attribute, frame_bytes or bandwidth;" << endl
+         << "                    prefix with '-' for descending order" << endl
+         << "  --resolution=WxH  resolution for the frame size and bandwidth estimates (default 3840x2160)" << endl
+         << "  --refresh=HZ      refresh rate for the bandwidth estimate (default 60)" << endl
+         << "  --contexts        create one context per client API on each display and print the GL" << endl
+         << "                    renderer, version, extensions and limits" << endl
+         << "  --dmabuf          enumerate the DMA-BUF formats and modifiers each display can import, also" << endl
+         << "                    stored by --publish and --save" << endl
+         << "  --bench-sync[=N]  measure fence sync round trip latency per display over N iterations" << endl
+         << "                    (default 1000) and print latency histograms" << endl
+         << "  --bench-shaders[=N]  compile and link a bundled shader corpus N times (default 5) per display" << endl
+         << "                    and client API and print per stage latencies, cold and from the blob cache" << endl
+         << "  --bench-eglimage[=N]  share textures between two contexts on two threads through EGLImage and" << endl
+         << "                    measure create, import, destroy and per frame latency over N iterations (default 200)" << endl
+         << "  --bench-transfer[=N]  measure glReadPixels, PBO readback and glTexSubImage2D throughput for" << endl
+         << "                    several formats and sizes N times (default 10) per display and client API" << endl
+         << "  --context-matrix  try every combination of client API version, profile, robustness, no-error" << endl
+         << "                    and priority on each display on --jobs threads and print a support matrix" << endl
+         << "  --probe-pbuffer[=MS]  search the largest pbuffer each selected configuration can actually" << endl
+         << "                    create, spending at most MS milliseconds per configuration (default 1000)" << endl
+         << "  --recommend=PROFILE  print the best configuration of each display for PROFILE, one of" << endl
+         << "                    video-overlay, 3d-ui, offscreen-compute or a profile file; with" << endl
+         << "                    --publish, the recommendation is stored in the snapshot" << endl
+         << "  --sysfs-root=DIR  look up the PCI address, NUMA node, local CPUs and render node of each" << endl
+         << "                    device below DIR instead of /sys" << endl
+         << "  --sweep=FILE      run eglinfo once per environment variant in FILE (one line of NAME=VALUE" << endl
+         << "                    assignments per variant) and compare init time and memory, configs and extensions" << endl
+         << "  --jobs=N          number of parallel runs for --sweep and threads for --context-matrix" << endl
+         << "                    (default: number of CPUs)" << endl
+         << "  --trace-file=FILE write the timeline of the probe phases and the output on every thread to" << endl
+         << "                    FILE as Chrome trace-event JSON, e.g. for Perfetto or chrome://tracing" << endl
+         << "  --help            show this help" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    const char* publishName = nullptr;
+    const char* saveFile = nullptr;
+    const char* servePath = nullptr;
+    string defaultServePath;
+    PrintOptions options;
+    bool withDmaBuf = false;
+    int benchSync = 0;
+    int benchShaders = 0;
+    int benchTransfer = 0;
+    int benchImage = 0;
+    int probePbufferMs = 0;
+    bool contextMatrix = false;
+    Profile recommendProfile;
+    bool recommend = false;
+    const char* sweepFile = nullptr;
+    string sysfsRoot = "/sys";
+    int jobs = max(1l, sysconf(_SC_NPROCESSORS_ONLN));
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--publish") == 0) {
+            publishName = EGLINFO_SNAPSHOT_DEFAULT_NAME;
+        } else if (strncmp(argv[i], "--publish=", 10) == 0) {
+            publishName = argv[i] + 10;
+        } else if (strncmp(argv[i], "--save=", 7) == 0) {
+            saveFile = argv[i] + 7;
+        } else if (strcmp(argv[i], "--serve") == 0) {
+            defaultServePath = defaultServerPath();
+            if (defaultServePath.empty()) {
+                cerr << "XDG_RUNTIME_DIR is not set, use --serve=PATH." << endl;
+                return 1;
+            }
+            servePath = defaultServePath.c_str();
+        } else if (strncmp(argv[i], "--serve=", 8) == 0) {
+            servePath = argv[i] + 8;
+        } else if (strcmp(argv[i], "--contexts") == 0) {
+            options.withContexts = true;
+        } else if (strcmp(argv[i], "--dmabuf") == 0) {
+            withDmaBuf = true;
+        } else if (strcmp(argv[i], "--bench-sync") == 0) {
+            benchSync = 1000;
+        } else if (strncmp(argv[i], "--bench-sync=", 13) == 0) {
+            benchSync = max(1, atoi(argv[i] + 13));
+        } else if (strcmp(argv[i], "--bench-shaders") == 0) {
+            benchShaders = 5;
+        } else if (strncmp(argv[i], "--bench-shaders=", 16) == 0) {
+            benchShaders = max(1, atoi(argv[i] + 16));
+        } else if (strcmp(argv[i], "--bench-eglimage") == 0) {
+            benchImage = 200;
+        } else if (strncmp(argv[i], "--bench-eglimage=", 17) == 0) {
+            benchImage = max(1, atoi(argv[i] + 17));
+        } else if (strcmp(argv[i], "--bench-transfer") == 0) {
+            benchTransfer = 10;
+        } else if (strncmp(argv[i], "--bench-transfer=", 17) == 0) {
+            benchTransfer = max(1, atoi(argv[i] + 17));
+        } else if (strcmp(argv[i], "--context-matrix") == 0) {
+            contextMatrix = true;
+        } else if (strcmp(argv[i], "--probe-pbuffer") == 0) {
+            probePbufferMs = 1000;
+        } else if (strncmp(argv[i], "--probe-pbuffer=", 16) == 0) {
+            probePbufferMs = max(1, atoi(argv[i] + 16));
+        } else if (strncmp(argv[i], "--recommend=", 12) == 0) {
+            if (!loadProfile(argv[i] + 12, &recommendProfile))
+                return 1;
+            recommend = true;
+        } else if (strncmp(argv[i], "--sysfs-root=", 13) == 0) {
+            sysfsRoot = argv[i] + 13;
+        } else if (strncmp(argv[i], "--sweep=", 8) == 0) {
+            sweepFile = argv[i] + 8;
+        } else if (strncmp(argv[i], "--trace-file=", 13) == 0) {
+            traceFile = argv[i] + 13;
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0) {
+            jobs = max(1, atoi(argv[i] + 7));
+        } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+            string error;
+            if (!parseQuery(argv[i] + 9, &options.filter, &error)) {
+                cerr << error << endl;
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--sort=", 7) == 0) {
+            if (!parseSortKey(argv[i] + 7, &options)) {
+                cerr << "Invalid sort key \"" << argv[i] + 7 << "\"" << endl;
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--resolution=", 13) == 0) {
+            if (!parseResolution(argv[i] + 13, &options.costModel)) {
+                cerr << "Invalid resolution \"" << argv[i] + 13 << "\"" << endl;
+                return 1;
+            }
+        } else if (strncmp(argv[i], "--refresh=", 10) == 0) {
+            options.costModel.refreshRate = max(1, atoi(argv[i] + 10));
+        } else {
+            printUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    // each of these prints its own report instead of the regular output, only one can run
+    const int modes = (benchSync > 0) + (benchShaders > 0) + (benchImage > 0) + (benchTransfer > 0) + contextMatrix
+        + (probePbufferMs > 0) + recommend;
+    if (modes > 1) {
+        cerr << "Only one of --bench-sync, --bench-shaders, --bench-eglimage, --bench-transfer, --context-matrix," << endl
+             << "--probe-pbuffer and --recommend can be used at a time." << endl;
+        return 1;
+    }
+
+    // the parent must not load any driver itself, the variants run in child processes
+    if (sweepFile)
+        return runSweep(sweepFile, jobs);
+
+    if (traceFile) {
+        startTimeline();
+        atexit(writeTraceFile);
+    }
+
+    // memory is only sampled where it is printed or stored, it costs about 2 ms per display
+    ProbeOptions probeOptions;
+    probeOptions.measureMemory = saveFile
+        || !(benchSync || benchShaders || benchImage || benchTransfer || contextMatrix || probePbufferMs || recommend || publishName || servePath);
+    probeOptions.sysfsRoot = sysfsRoot;
+    ProbeResult result;
+    probe(&result, probeOptions);
+    if (withDmaBuf) {
+        TimelineSpan span("dmabuf formats");
+#ifdef EGL_EXT_device_base
+        for (DeviceInfo &device : result.devices.devices) {
+            if (device.hasDisplay && device.display.state == DisplayInfo::Ok)
+                queryDmaBufFormats(device.display.display, device.display.extensions, &device.display.dmaBufFormats);
+        }
+#endif
+        if (result.hasDefaultDisplay && result.defaultDisplay.state == DisplayInfo::Ok)
+            queryDmaBufFormats(result.defaultDisplay.display, result.defaultDisplay.extensions, &result.defaultDisplay.dmaBufFormats);
+    }
+
+    if (benchSync) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printSyncBenchmark(info, benchSync);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (benchShaders) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printShaderBenchmark(info, benchShaders);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (benchImage) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printImageBenchmark(info, benchImage);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (benchTransfer) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printTransferBenchmark(info, benchTransfer);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (contextMatrix) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printContextMatrix(info, jobs);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (probePbufferMs) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printPbufferLimits(info, options, probePbufferMs);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (recommend && !publishName) {
+        forEachDisplay(result, [&](const DisplayInfo& info, const string& label) {
+            cout << label << " (" << (info.vendor ? info.vendor : "") << "):" << endl;
+            printRecommendation(info, recommendProfile, options.costModel);
+            cout << endl;
+        });
+        return 0;
+    }
+
+    if (publishName) {
+        TimelineSpan span("publish");
+        vector<Profile> profiles = builtinProfiles();
+        if (recommend && !findProfile(recommendProfile.name))
+            profiles.push_back(recommendProfile);
+        if (!publishSnapshot(result, publishName, profiles)) {
+            perror("Could not publish snapshot");
+            return 1;
+        }
+        cout << "Published snapshot to " << publishName << "." << endl;
+    }
+    if (saveFile) {
+        TimelineSpan span("save");
+        HostRecord host;
+        toHostRecord(result, &host);
+        string data;
+        encodeHost(host, &data);
+        ofstream file(saveFile, ios::binary | ios::trunc);
+        if (!file.write(data.data(), data.size()) || !file.flush()) {
+            cerr << "Could not write " << saveFile << "." << endl;
+            return 1;
+        }
+        cout << "Saved " << data.size() << " bytes to " << saveFile << "." << endl;
+    }
+    if (servePath) {
+        HostRecord host;
+        toHostRecord(result, &host);
+        return runServer(host, servePath);
+    }
+    if (publishName || saveFile)
+        return 0;
+
+    TimelineSpan span("output");
+    if (result.clientExtensions)
+        cout << "Client extensions: " << result.clientExtensions << endl << endl;
+    else
+        cout << "No client extensions." << endl << endl;
+
+#ifdef EGL_EXT_device_base
+    if (result.devices.state != DeviceList::NotQueried)
+        printDevices(result.devices, options);
+#endif
+
+    if (!result.hasDefaultDisplay) {
+        cerr << "Could not obtain EGL display!" << endl;
+        exit(1);
+    }
+    cout << "Default display" << endl;
+    printDisplay(result.defaultDisplay, options);
+}
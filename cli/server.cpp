@@ -0,0 +1,365 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "server.h"
+
+#include "query.h"
+#include "serverprotocol.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace EglInfo;
+
+namespace {
+
+/** Bytes read from one connection per wake-up, the rest waits for the next epoll_wait(). */
+const size_t MaxReadSize = 4 * ServerMaxRequestSize;
+
+struct Connection {
+    string input;
+    string output;
+    size_t outputOffset = 0;
+    /** Waiting for EPOLLOUT; no further requests are read until the replies are sent. */
+    bool writing = false;
+    /** The client shut down its side, close once the replies are sent. */
+    bool closing = false;
+};
+
+}
+
+template <typename T>
+static void append(string* out, const T& value)
+{
+    out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendString(string* out, const string& str)
+{
+    append(out, uint32_t(str.size()));
+    out->append(str);
+}
+
+template <typename T>
+static bool take(const char** data, const char* end, T* value)
+{
+    if (size_t(end - *data) < sizeof(T))
+        return false;
+    memcpy(value, *data, sizeof(T));
+    *data += sizeof(T);
+    return true;
+}
+
+/** Fills @p reply with the payload answering a request, returns its ServerStatus. */
+static ServerStatus handleRequest(const HostRecord& host, uint16_t type, const char* data, const char* end, string* reply)
+{
+    switch (type) {
+    case ServerHello:
+        append(reply, uint32_t(ServerProtocolVersion));
+        append(reply, uint32_t(host.displays.size()));
+        return ServerOk;
+
+    case ServerDisplayInfo: {
+        uint32_t index;
+        if (!take(&data, end, &index))
+            return ServerBadRequest;
+        if (index >= host.displays.size())
+            return ServerBadIndex;
+        const HostDisplay &display = host.displays[index];
+        append(reply, uint32_t(display.configs.size()));
+        appendString(reply, display.vendor);
+        appendString(reply, display.extensions);
+        return ServerOk;
+    }
+
+    case ServerFindConfigs: {
+        uint32_t index, maxResults;
+        if (!take(&data, end, &index) || !take(&data, end, &maxResults))
+            return ServerBadRequest;
+        if (index != ServerAllDisplays && index >= host.displays.size())
+            return ServerBadIndex;
+        Query query;
+        string error;
+        if (!parseQuery(string(data, end).c_str(), &query, &error)) {
+            reply->append(error);
+            return ServerBadQuery;
+        }
+
+        const size_t countOffset = reply->size();
+        append(reply, uint32_t(0));
+        uint32_t count = 0;
+        const uint32_t first = index == ServerAllDisplays ? 0 : index;
+        const uint32_t last = index == ServerAllDisplays ? host.displays.size() : index + 1;
+        for (uint32_t d = first; d < last && (!maxResults || count < maxResults); ++d) {
+            const HostDisplay &display = host.displays[d];
+            for (uint32_t c = 0; c < display.configs.size() && (!maxResults || count < maxResults); ++c) {
+                if (!matchesConfig(query, display.configs[c], display.extensions.c_str()))
+                    continue;
+                append(reply, ServerMatch{ d, c, display.configs[c].fingerprint() });
+                ++count;
+            }
+        }
+        memcpy(&(*reply)[countOffset], &count, sizeof(count));
+        return ServerOk;
+    }
+
+    case ServerConfigAttributes: {
+        uint32_t displayIndex, configIndex;
+        if (!take(&data, end, &displayIndex) || !take(&data, end, &configIndex))
+            return ServerBadRequest;
+        if (displayIndex >= host.displays.size() || configIndex >= host.displays[displayIndex].configs.size())
+            return ServerBadIndex;
+        const ConfigInfo &config = host.displays[displayIndex].configs[configIndex];
+        for (int i = 0; i < attributesSize; ++i) {
+            if (config.isValid(i))
+                append(reply, ServerAttribute{ attributes[i].attribute, config.values[i] });
+        }
+        return ServerOk;
+    }
+    }
+    return ServerBadType;
+}
+
+/** Answers all complete requests buffered on @p connection. Returns false if the client misbehaved. */
+static bool handleInput(const HostRecord& host, Connection* connection, uint64_t* requests)
+{
+    size_t offset = 0;
+    string payload;
+    while (connection->input.size() - offset >= sizeof(ServerMessageHeader)) {
+        ServerMessageHeader header;
+        memcpy(&header, connection->input.data() + offset, sizeof(header));
+        if (header.size > ServerMaxRequestSize)
+            return false;
+        if (connection->input.size() - offset - sizeof(header) < header.size)
+            break;
+
+        const char *data = connection->input.data() + offset + sizeof(header);
+        offset += sizeof(header) + header.size;
+        payload.clear();
+        header.status = handleRequest(host, header.type, data, data + header.size, &payload);
+        if (header.status != ServerOk && header.status != ServerBadQuery)
+            payload.clear();
+        header.size = payload.size();
+        append(&connection->output, header);
+        connection->output += payload;
+        ++*requests;
+    }
+    connection->input.erase(0, offset);
+    return true;
+}
+
+/** Sends as much buffered output as the socket takes. Returns false on a broken connection. */
+static bool flushOutput(int fd, Connection* connection)
+{
+    while (connection->outputOffset < connection->output.size()) {
+        const ssize_t size = send(fd, connection->output.data() + connection->outputOffset,
+                                  connection->output.size() - connection->outputOffset, MSG_NOSIGNAL);
+        if (size < 0) {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        connection->outputOffset += size;
+    }
+    connection->output.clear();
+    connection->outputOffset = 0;
+    return true;
+}
+
+/**
+ * Reads what is available on @p fd, up to MaxReadSize bytes. Sets Connection::closing on end of
+ * file. Returns false on error.
+ */
+static bool readInput(int fd, Connection* connection)
+{
+    char buffer[16384];
+    size_t total = 0;
+    while (total < MaxReadSize) {
+        const ssize_t size = recv(fd, buffer, sizeof(buffer), 0);
+        if (size > 0) {
+            connection->input.append(buffer, size);
+            total += size;
+            if (size_t(size) < sizeof(buffer))
+                return true;
+        } else if (size == 0) {
+            connection->closing = true;
+            return true;
+        } else if (errno != EINTR) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+    return true;
+}
+
+/** Binds a listening socket to @p path, replacing a stale socket but not a running server. */
+static int listenOn(const char* path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+
+    const int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0)
+        return -1;
+    const bool running = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    const int connectError = errno;
+    close(probe);
+    if (running) {
+        errno = EADDRINUSE;
+        return -1;
+    }
+    // only replace our own stale socket, never another user's file in a shared directory
+    struct stat st;
+    if (connectError == ECONNREFUSED && lstat(path, &st) == 0 && S_ISSOCK(st.st_mode) && st.st_uid == geteuid())
+        unlink(path);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+int runServer(const HostRecord& host, const char* path)
+{
+    const int listenFd = listenOn(path);
+    if (listenFd < 0) {
+        perror(path);
+        return 1;
+    }
+
+    // SIGINT and SIGTERM end the event loop instead of the process, so the socket is removed
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, nullptr);
+    const int signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    const int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (signalFd < 0 || epollFd < 0) {
+        perror("Could not set up event loop");
+        unlink(path);
+        return 1;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = signalFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, signalFd, &event);
+
+    size_t configs = 0;
+    for (const HostDisplay &display : host.displays)
+        configs += display.configs.size();
+    cout << "Serving " << host.displays.size() << " display(s) with " << configs << " configuration(s) on " << path << "." << endl;
+
+    unordered_map<int, Connection> connections;
+    uint64_t connectionCount = 0, requests = 0;
+    auto closeConnection = [&](int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    };
+
+    bool running = true;
+    epoll_event events[64];
+    while (running) {
+        const int count = epoll_wait(epollFd, events, 64, -1);
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == signalFd) {
+                running = false;
+            } else if (fd == listenFd) {
+                int client;
+                while ((client = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    epoll_event clientEvent = {};
+                    clientEvent.events = EPOLLIN;
+                    clientEvent.data.fd = client;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, client, &clientEvent);
+                    connections[client];
+                    ++connectionCount;
+                }
+            } else {
+                auto it = connections.find(fd);
+                if (it == connections.end())
+                    continue;
+                Connection &connection = it->second;
+                bool ok = true;
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    const bool open = readInput(fd, &connection);
+                    ok = handleInput(host, &connection, &requests) && open;
+                }
+                ok = flushOutput(fd, &connection) && ok;
+                if (!ok || (connection.closing && connection.output.empty())) {
+                    closeConnection(fd);
+                    continue;
+                }
+
+                // stop reading while replies are pending, so slow clients cannot make us buffer without bound
+                const bool writing = !connection.output.empty();
+                if (writing != connection.writing) {
+                    epoll_event clientEvent = {};
+                    clientEvent.events = writing ? EPOLLOUT : EPOLLIN;
+                    clientEvent.data.fd = fd;
+                    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &clientEvent);
+                    connection.writing = writing;
+                }
+            }
+        }
+    }
+
+    for (auto &connection : connections)
+        close(connection.first);
+    close(epollFd);
+    close(signalFd);
+    close(listenFd);
+    unlink(path);
+    cout << "Answered " << requests << " request(s) on " << connectionCount << " connection(s)." << endl;
+    return 0;
+}
@@ -0,0 +1,31 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_SERVER_H
+#define EGLINFO_SERVER_H
+
+#include "hostrecord.h"
+
+/**
+ * Answers queries about @p host on the Unix domain socket @p path until SIGINT or SIGTERM,
+ * see serverprotocol.h. All clients are handled by a single thread with epoll, lookups are
+ * cheap compared to a context switch. Returns the exit code for main().
+ */
+int runServer(const EglInfo::HostRecord& host, const char* path);
+
+#endif
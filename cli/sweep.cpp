@@ -0,0 +1,286 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sweep.h"
+
+#include "encoding.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+using namespace std;
+using namespace EglInfo;
+
+namespace {
+
+struct Variant {
+    string name;
+    vector<string> environment;
+
+    pid_t pid = -1;
+    int fd = -1;
+    string output;
+    int status = 0;
+    chrono::steady_clock::time_point start;
+    double wallTime = 0;
+
+    bool decoded = false;
+    HostRecord host;
+};
+
+}
+
+static bool readVariants(const char* fileName, vector<Variant>* variants)
+{
+    ifstream file(fileName);
+    if (!file) {
+        cerr << "Could not open " << fileName << "." << endl;
+        return false;
+    }
+
+    string line;
+    while (getline(file, line)) {
+        const size_t start = line.find_first_not_of(" \t");
+        if (start == string::npos || line[start] == '#')
+            continue;
+
+        Variant variant;
+        variant.environment.reserve(64);
+        for (char **env = environ; *env; ++env)
+            variant.environment.push_back(*env);
+
+        istringstream stream(line);
+        string assignment;
+        while (stream >> assignment) {
+            const bool unset = assignment[0] == '-';
+            const string name = unset ? assignment.substr(1) : assignment.substr(0, assignment.find('='));
+            if (name.empty() || (!unset && assignment.find('=') == string::npos)) {
+                cerr << "Invalid environment assignment \"" << assignment << "\" in " << fileName << "." << endl;
+                return false;
+            }
+            variant.environment.erase(remove_if(variant.environment.begin(), variant.environment.end(), [&name](const string& env) {
+                return env.compare(0, name.size() + 1, name + '=') == 0;
+            }), variant.environment.end());
+            if (!unset)
+                variant.environment.push_back(assignment);
+        }
+        variant.name = line.substr(start);
+        variants->push_back(std::move(variant));
+    }
+    return true;
+}
+
+static bool startVariant(const string& executable, Variant* variant)
+{
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0)
+        return false;
+
+    // everything the child needs is prepared before fork(), it only calls async-signal-safe functions
+    const char *argv[] = { executable.c_str(), "--save=/dev/fd/3", nullptr };
+    vector<const char*> envp;
+    for (const string &env : variant->environment)
+        envp.push_back(env.c_str());
+    envp.push_back(nullptr);
+
+    variant->start = chrono::steady_clock::now();
+    variant->pid = fork();
+    if (variant->pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (variant->pid == 0) {
+        // with stdio closed the pipe can be fds 0 to 2, move it out of the way before redirecting them
+        const int out = fcntl(fds[1], F_DUPFD_CLOEXEC, 3);
+        const int devNull = open("/dev/null", O_RDWR);
+        dup2(devNull, STDIN_FILENO);
+        dup2(devNull, STDOUT_FILENO);
+        dup2(devNull, STDERR_FILENO);
+        // dup2() onto itself would keep O_CLOEXEC and the child would exec without fd 3
+        if (out == 3)
+            fcntl(3, F_SETFD, 0);
+        else
+            dup2(out, 3);
+        execve(argv[0], const_cast<char**>(argv), const_cast<char**>(envp.data()));
+        _exit(127);
+    }
+
+    close(fds[1]);
+    variant->fd = fds[0];
+    return true;
+}
+
+static void finishVariant(Variant* variant)
+{
+    close(variant->fd);
+    variant->fd = -1;
+    waitpid(variant->pid, &variant->status, 0);
+    variant->wallTime = chrono::duration<double, milli>(chrono::steady_clock::now() - variant->start).count();
+
+    string error;
+    variant->decoded = WIFEXITED(variant->status) && WEXITSTATUS(variant->status) == 0
+        && decodeHost(variant->output.data(), variant->output.size(), &variant->host, &error);
+}
+
+static set<string> extensionSet(const HostRecord& host)
+{
+    set<string> extensions;
+    for (const HostDisplay &display : host.displays) {
+        istringstream stream(display.extensions);
+        string name;
+        while (stream >> name)
+            extensions.insert(name);
+    }
+    return extensions;
+}
+
+static void printResults(const vector<Variant>& variants)
+{
+    size_t nameWidth = 7;
+    for (const Variant &variant : variants)
+        nameWidth = max(nameWidth, variant.name.size());
+
+    cout << left << setw(nameWidth) << "Variant" << right
+         << setw(10) << "Wall ms" << setw(10) << "Init ms" << setw(10) << "Init MiB" << setw(10) << "Displays" << setw(10) << "Configs"
+         << setw(12) << "Extensions" << endl;
+    cout << fixed << setprecision(1);
+    for (const Variant &variant : variants) {
+        cout << left << setw(nameWidth) << variant.name << right << setw(10) << variant.wallTime;
+        if (!variant.decoded) {
+            if (WIFEXITED(variant.status))
+                cout << "  failed with exit code " << WEXITSTATUS(variant.status) << endl;
+            else
+                cout << "  killed by signal " << WTERMSIG(variant.status) << endl;
+            continue;
+        }
+        int64_t initializeTime = 0;
+        int64_t initializeRss = 0;
+        size_t configs = 0;
+        for (const HostDisplay &display : variant.host.displays) {
+            initializeTime += display.initializeTime;
+            initializeRss += display.memoryCost.initialize.rss;
+            configs += display.configs.size();
+        }
+        cout << setw(10) << initializeTime / 1e6 << setw(10) << initializeRss / 1048576.0 << setw(10) << variant.host.displays.size()
+             << setw(10) << configs << setw(12) << extensionSet(variant.host).size() << endl;
+    }
+
+    // extension differences relative to the first variant that worked
+    const auto reference = find_if(variants.begin(), variants.end(), [](const Variant& variant) { return variant.decoded; });
+    if (reference == variants.end())
+        return;
+    const set<string> referenceExtensions = extensionSet(reference->host);
+    bool header = false;
+    for (const Variant &variant : variants) {
+        if (!variant.decoded || &variant == &*reference)
+            continue;
+        const set<string> extensions = extensionSet(variant.host);
+        vector<string> added, removed;
+        set_difference(extensions.begin(), extensions.end(), referenceExtensions.begin(), referenceExtensions.end(), back_inserter(added));
+        set_difference(referenceExtensions.begin(), referenceExtensions.end(), extensions.begin(), extensions.end(), back_inserter(removed));
+        if (added.empty() && removed.empty())
+            continue;
+        if (!header) {
+            cout << endl << "Display extensions compared to " << reference->name << ":" << endl;
+            header = true;
+        }
+        cout << variant.name << ":" << endl;
+        for (const string &name : added)
+            cout << "  + " << name << endl;
+        for (const string &name : removed)
+            cout << "  - " << name << endl;
+    }
+}
+
+int runSweep(const char* variantsFile, int jobs)
+{
+    vector<Variant> variants;
+    if (!readVariants(variantsFile, &variants))
+        return 1;
+    if (variants.empty()) {
+        cerr << "No variants in " << variantsFile << "." << endl;
+        return 1;
+    }
+
+    char executable[4096];
+    const ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+    if (length <= 0) {
+        perror("Could not determine the eglinfo executable");
+        return 1;
+    }
+    executable[length] = '\0';
+
+    size_t next = 0;
+    vector<Variant*> running;
+    while (next < variants.size() || !running.empty()) {
+        while (next < variants.size() && static_cast<int>(running.size()) < jobs) {
+            Variant *variant = &variants[next++];
+            if (!startVariant(executable, variant)) {
+                perror("Could not start eglinfo");
+                return 1;
+            }
+            running.push_back(variant);
+        }
+
+        vector<pollfd> fds;
+        for (Variant *variant : running)
+            fds.push_back(pollfd{ variant->fd, POLLIN, 0 });
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("poll");
+            return 1;
+        }
+
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (!fds[i].revents)
+                continue;
+            Variant *variant = running[i];
+            char buffer[65536];
+            const ssize_t size = read(variant->fd, buffer, sizeof(buffer));
+            if (size > 0) {
+                variant->output.append(buffer, size);
+            } else if (size == 0 || errno != EINTR) {
+                finishVariant(variant);
+                running[i] = nullptr;
+            }
+        }
+        running.erase(remove(running.begin(), running.end(), nullptr), running.end());
+    }
+
+    printResults(variants);
+    return 0;
+}
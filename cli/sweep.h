@@ -0,0 +1,30 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_SWEEP_H
+#define EGLINFO_SWEEP_H
+
+/**
+ * Runs eglinfo once per environment variant listed in @p variantsFile, in parallel child
+ * processes (at most @p jobs at a time), and prints a comparison of init time, config count
+ * and display extensions. Each line of the file is one variant of whitespace separated
+ * NAME=VALUE assignments ("-NAME" unsets NAME); empty lines and lines starting with # are
+ * ignored. Returns the exit code for main().
+ */
+int runSweep(const char* variantsFile, int jobs);
+
+#endif
@@ -0,0 +1,9 @@
+TEMPLATE = lib
+TARGET = eglinfo-client
+CONFIG += staticlib egl_headers_only
+include(../eglinfo.pri)
+INCLUDEPATH += $$PWD/../lib
+HEADERS += \
+    ../lib/serverprotocol.h \
+    serverclient.h
+SOURCES += serverclient.cpp
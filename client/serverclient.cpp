@@ -0,0 +1,224 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "serverclient.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace EglInfo;
+
+template <typename T>
+static void append(std::string* out, const T& value)
+{
+    out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool take(const char** data, const char* end, T* value)
+{
+    if (size_t(end - *data) < sizeof(T))
+        return false;
+    memcpy(value, *data, sizeof(T));
+    *data += sizeof(T);
+    return true;
+}
+
+static bool takeString(const char** data, const char* end, std::string* str)
+{
+    uint32_t size;
+    if (!take(data, end, &size) || size_t(end - *data) < size)
+        return false;
+    str->assign(*data, size);
+    *data += size;
+    return true;
+}
+
+static bool sendAll(int fd, const char* data, size_t size)
+{
+    while (size) {
+        const ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool receiveAll(int fd, char* data, size_t size)
+{
+    while (size) {
+        const ssize_t received = recv(fd, data, size, 0);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR)
+                continue;
+            if (received == 0)
+                errno = ECONNRESET;
+            return false;
+        }
+        data += received;
+        size -= received;
+    }
+    return true;
+}
+
+ServerClient::ServerClient()
+    : m_fd(-1)
+    , m_displayCount(0)
+    , m_tag(0)
+    , m_status(ServerOk)
+{
+}
+
+ServerClient::~ServerClient()
+{
+    close();
+}
+
+bool ServerClient::connect(const char* path)
+{
+    close();
+    const std::string defaultPath = path ? std::string() : defaultServerPath();
+    if (!path) {
+        if (defaultPath.empty()) {
+            errno = ENOENT;
+            return false;
+        }
+        path = defaultPath.c_str();
+    }
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strcpy(address.sun_path, path);
+
+    m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_fd < 0)
+        return false;
+    if (::connect(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        const int error = errno;
+        close();
+        errno = error;
+        return false;
+    }
+
+    const bool ok = request(ServerHello, std::string());
+    const char *data = m_reply.data(), *end = data + m_reply.size();
+    uint32_t version = 0;
+    if (!ok || !take(&data, end, &version) || version != ServerProtocolVersion || !take(&data, end, &m_displayCount)) {
+        close();
+        errno = EPROTO;
+        return false;
+    }
+    return true;
+}
+
+void ServerClient::close()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_fd = -1;
+    m_displayCount = 0;
+}
+
+bool ServerClient::request(ServerMessageType type, const std::string& payload)
+{
+    m_status = ServerOk;
+    m_error.clear();
+    m_reply.clear();
+    if (m_fd < 0) {
+        errno = ENOTCONN;
+        return false;
+    }
+
+    std::string message;
+    message.reserve(sizeof(ServerMessageHeader) + payload.size());
+    append(&message, ServerMessageHeader{ uint32_t(payload.size()), type, ServerOk, ++m_tag });
+    message += payload;
+
+    ServerMessageHeader header;
+    if (!sendAll(m_fd, message.data(), message.size())
+        || !receiveAll(m_fd, reinterpret_cast<char*>(&header), sizeof(header))) {
+        close();
+        return false;
+    }
+    m_reply.resize(header.size);
+    if (!receiveAll(m_fd, &m_reply[0], header.size) || header.tag != m_tag || header.type != type) {
+        close();
+        return false;
+    }
+
+    m_status = static_cast<ServerStatus>(header.status);
+    if (m_status == ServerBadQuery)
+        m_error.swap(m_reply);
+    return m_status == ServerOk;
+}
+
+bool ServerClient::displayInfo(uint32_t index, ServerDisplay* display)
+{
+    std::string payload;
+    append(&payload, index);
+    if (!request(ServerDisplayInfo, payload))
+        return false;
+    const char *data = m_reply.data(), *end = data + m_reply.size();
+    return take(&data, end, &display->configCount)
+        && takeString(&data, end, &display->vendor)
+        && takeString(&data, end, &display->extensions);
+}
+
+bool ServerClient::findConfigs(const char* query, std::vector<ServerMatch>* matches, uint32_t displayIndex, uint32_t maxResults)
+{
+    std::string payload;
+    append(&payload, displayIndex);
+    append(&payload, maxResults);
+    payload += query;
+    matches->clear();
+    if (!request(ServerFindConfigs, payload))
+        return false;
+    const char *data = m_reply.data(), *end = data + m_reply.size();
+    uint32_t count;
+    if (!take(&data, end, &count) || size_t(end - data) / sizeof(ServerMatch) < count)
+        return false;
+    matches->resize(count);
+    memcpy(matches->data(), data, count * sizeof(ServerMatch));
+    return true;
+}
+
+bool ServerClient::configAttributes(uint32_t displayIndex, uint32_t configIndex, std::vector<ServerAttribute>* attributes)
+{
+    std::string payload;
+    append(&payload, displayIndex);
+    append(&payload, configIndex);
+    attributes->clear();
+    if (!request(ServerConfigAttributes, payload))
+        return false;
+    attributes->resize(m_reply.size() / sizeof(ServerAttribute));
+    memcpy(attributes->data(), m_reply.data(), attributes->size() * sizeof(ServerAttribute));
+    return true;
+}
@@ -0,0 +1,90 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_SERVERCLIENT_H
+#define EGLINFO_SERVERCLIENT_H
+
+#include "serverprotocol.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+struct ServerDisplay {
+    uint32_t configCount;
+    std::string vendor;
+    std::string extensions;
+};
+
+/**
+ * Blocking client for the query socket served by eglinfo --serve, see serverprotocol.h.
+ * Neither EGL nor the probe is involved. Each request waits for its reply; use one client
+ * per thread.
+ */
+class ServerClient
+{
+public:
+    ServerClient();
+    ~ServerClient();
+
+    ServerClient(const ServerClient&) = delete;
+    ServerClient& operator=(const ServerClient&) = delete;
+
+    /**
+     * Connects to the server at @p path, or at defaultServerPath() for nullptr. Returns false
+     * and leaves errno set on failure.
+     */
+    bool connect(const char* path = nullptr);
+    void close();
+    bool isConnected() const { return m_fd >= 0; }
+
+    /** Number of displays served, known after connect(). */
+    uint32_t displayCount() const { return m_displayCount; }
+
+    bool displayInfo(uint32_t index, ServerDisplay* display);
+    /**
+     * Finds the configs matching @p query, written like eglinfo --filter, on display
+     * @p displayIndex or all displays. At most @p maxResults are returned, 0 meaning all.
+     */
+    bool findConfigs(const char* query, std::vector<ServerMatch>* matches,
+                     uint32_t displayIndex = ServerAllDisplays, uint32_t maxResults = 0);
+    bool configAttributes(uint32_t displayIndex, uint32_t configIndex, std::vector<ServerAttribute>* attributes);
+
+    /**
+     * Status of the last request; requests fail with ServerOk if the connection broke.
+     * For ServerBadQuery, lastError() holds the message of the server.
+     */
+    ServerStatus lastStatus() const { return m_status; }
+    const std::string& lastError() const { return m_error; }
+
+private:
+    bool request(ServerMessageType type, const std::string& payload);
+
+    int m_fd;
+    uint32_t m_displayCount;
+    uint32_t m_tag;
+    ServerStatus m_status;
+    std::string m_error;
+    /** Payload of the last reply. */
+    std::string m_reply;
+};
+
+}
+
+#endif
@@ -1,12 +1,10 @@
-!isEmpty(QMAKE_LIBDIR_EGL): LIBS += -L$$QMAKE_LIBDIR_EGL
-LIBS += $$QMAKE_LIBS_EGL
-QT -= gui core
-CONFIG += c++11
-use_khr_headers {
-    message("Using internal Khronos EGL headers.")
-    INCLUDEPATH += $$PWD/3rdparty/khronos
-} else {
-    message("Using system EGL headers.")
-    INCLUDEPATH += $$QMAKE_INCDIR_EGL
-}
-SOURCES += main.cpp
+TEMPLATE = subdirs
+SUBDIRS = lib cli reader client aggregate bench loadtime tracer stub asynccheck
+cli.depends = lib
+aggregate.depends = lib
+loadtime.depends = lib
+bench.depends = lib reader client
+asynccheck.subdir = stub/asynccheck
+asynccheck.depends = lib
+# make check runs cli/eglinfo, the AsyncProbe check and eglinfo-loadtime against the stub
+stub.depends = cli asynccheck loadtime
@@ -0,0 +1,178 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "asyncprobe.h"
+#include "timeline.h"
+#include "tracepoints.h"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EglInfo {
+
+struct AsyncProbe::Private {
+    struct Waiter {
+        std::function<bool(const ConfigInfo&)> predicate;
+        std::promise<ConfigMatch> promise;
+    };
+
+    void run();
+    void displayFinished(const DisplayInfo* display);
+    static ConfigMatch match(const DisplayInfo* display, const std::function<bool(const ConfigInfo&)>& predicate);
+
+    ProbeOptions options;
+    ProbeResult result;
+    std::promise<const char*> clientExtensionsPromise;
+    std::shared_future<const char*> clientExtensions;
+    std::promise<const ProbeResult*> resultPromise;
+    std::shared_future<const ProbeResult*> resultFuture;
+
+    std::mutex mutex;
+    std::vector<const DisplayInfo*> finishedDisplays;
+    std::vector<Waiter> waiters;
+    bool allFinished = false;
+
+    std::thread thread;
+};
+
+ConfigMatch AsyncProbe::Private::match(const DisplayInfo* display, const std::function<bool(const ConfigInfo&)>& predicate)
+{
+    for (int i = 0; i < static_cast<int>(display->configs.size()); ++i) {
+        if (predicate(display->configs[i]))
+            return ConfigMatch{ display, i };
+    }
+    return ConfigMatch{ nullptr, -1 };
+}
+
+void AsyncProbe::Private::displayFinished(const DisplayInfo* display)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    finishedDisplays.push_back(display);
+    for (auto it = waiters.begin(); it != waiters.end();) {
+        const ConfigMatch m = match(display, it->predicate);
+        if (m.display) {
+            it->promise.set_value(m);
+            it = waiters.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AsyncProbe::Private::run()
+{
+    TimelineSpan span("probe");
+    EGLINFO_TRACE0(probe_entry);
+    result.clientExtensions = queryClientExtensions();
+    clientExtensionsPromise.set_value(result.clientExtensions);
+
+    // the memory samples cover the whole process, so measuring probes one display after the other
+    std::vector<std::thread> workers;
+    auto start = [&](std::function<void()> step) {
+        if (options.measureMemory)
+            step();
+        else
+            workers.emplace_back(std::move(step));
+    };
+
+    start([this] {
+        probeDefaultDisplay(&result, options);
+        if (result.hasDefaultDisplay)
+            displayFinished(&result.defaultDisplay);
+    });
+
+#ifdef EGL_EXT_device_base
+    if (hasExtension(result.clientExtensions, "EGL_EXT_device_base") && queryDevices(&result.devices)) {
+        for (size_t i = 0; i < result.devices.devices.size(); ++i) {
+            start([this, i] {
+                probeDevice(&result.devices, i, options);
+                if (result.devices.devices[i].hasDisplay)
+                    displayFinished(&result.devices.devices[i].display);
+            });
+        }
+    }
+#endif
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        allFinished = true;
+        for (Waiter &waiter : waiters)
+            waiter.promise.set_value(ConfigMatch{ nullptr, -1 });
+        waiters.clear();
+    }
+    EGLINFO_TRACE0(probe_return);
+    resultPromise.set_value(&result);
+}
+
+AsyncProbe::AsyncProbe(const ProbeOptions& options)
+    : d(new Private)
+{
+    d->options = options;
+    d->clientExtensions = d->clientExtensionsPromise.get_future().share();
+    d->resultFuture = d->resultPromise.get_future().share();
+    d->thread = std::thread(&Private::run, d.get());
+}
+
+AsyncProbe::~AsyncProbe()
+{
+    d->thread.join();
+}
+
+std::shared_future<const char*> AsyncProbe::clientExtensions() const
+{
+    return d->clientExtensions;
+}
+
+std::shared_future<const ProbeResult*> AsyncProbe::result() const
+{
+    return d->resultFuture;
+}
+
+std::future<ConfigMatch> AsyncProbe::findConfig(std::function<bool(const ConfigInfo&)> predicate)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+
+    std::promise<ConfigMatch> promise;
+    std::future<ConfigMatch> future = promise.get_future();
+    for (const DisplayInfo *display : d->finishedDisplays) {
+        const ConfigMatch m = Private::match(display, predicate);
+        if (m.display) {
+            promise.set_value(m);
+            return future;
+        }
+    }
+
+    if (d->allFinished)
+        promise.set_value(ConfigMatch{ nullptr, -1 });
+    else
+        d->waiters.push_back(Private::Waiter{ std::move(predicate), std::move(promise) });
+    return future;
+}
+
+std::function<bool(const ConfigInfo&)> AsyncProbe::renderableType(EGLint renderableBit)
+{
+    return [renderableBit](const ConfigInfo& config) {
+        return (config.value(EGL_RENDERABLE_TYPE) & renderableBit) != 0;
+    };
+}
+
+}
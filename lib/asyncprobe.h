@@ -0,0 +1,78 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_ASYNCPROBE_H
+#define EGLINFO_ASYNCPROBE_H
+
+#include "probe.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace EglInfo {
+
+/** A config found by AsyncProbe::findConfig(). display is nullptr if no display had a matching config. */
+struct ConfigMatch {
+    const DisplayInfo* display;
+    int configIndex;
+
+    const ConfigInfo* config() const { return display ? &display->configs[configIndex] : nullptr; }
+};
+
+/**
+ * Runs probe() in the background, with the display of every device and the default
+ * display probed concurrently on their own threads. With ProbeOptions::measureMemory the
+ * displays are probed one after the other instead, as concurrent eglInitialize() calls would
+ * be charged to each other.
+ *
+ * All pointers handed out through the futures point into this object and stay valid
+ * until it is destroyed. The destructor waits for all probing to finish.
+ */
+class AsyncProbe
+{
+public:
+    explicit AsyncProbe(const ProbeOptions& options = ProbeOptions());
+    ~AsyncProbe();
+
+    AsyncProbe(const AsyncProbe&) = delete;
+    AsyncProbe& operator=(const AsyncProbe&) = delete;
+
+    /** Resolves with the client extension string (possibly nullptr) before any display is touched. */
+    std::shared_future<const char*> clientExtensions() const;
+
+    /** Resolves once every device and the default display have been probed. */
+    std::shared_future<const ProbeResult*> result() const;
+
+    /**
+     * Resolves with the first config accepted by @p predicate, on whichever display
+     * finishes probing first, without waiting for the remaining displays.
+     * @p predicate is called from the probing threads and must not block.
+     */
+    std::future<ConfigMatch> findConfig(std::function<bool(const ConfigInfo&)> predicate);
+
+    /** Predicate for findConfig() accepting configs whose EGL_RENDERABLE_TYPE contains @p renderableBit. */
+    static std::function<bool(const ConfigInfo&)> renderableType(EGLint renderableBit);
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,287 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "attributes.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+using namespace std;
+
+namespace EglInfo {
+
+static const enum_t boolMap[] {
+    { EGL_TRUE, "true" },
+    { EGL_FALSE, "false" }
+};
+
+static const enum_t bufferTypeMap[] {
+    { EGL_RGB_BUFFER, "RGB" },
+    { EGL_LUMINANCE_BUFFER, "Luminance" }
+};
+
+static const enum_t caveatMap[] {
+    { EGL_NONE, "none" },
+    { EGL_SLOW_CONFIG, "slow" },
+    { EGL_NON_CONFORMANT_CONFIG, "non-conformant" }
+};
+
+static const enum_t transparentTypeMap[] {
+    { EGL_NONE, "none" },
+    { EGL_TRANSPARENT_RGB, "transparent RGB" }
+};
+
+static const enum_t surfaceTypeMap[] {
+    { EGL_PBUFFER_BIT, "pbuffer" },
+    { EGL_PIXMAP_BIT, "pixmap" },
+    { EGL_WINDOW_BIT, "window" },
+    { EGL_VG_COLORSPACE_LINEAR_BIT, "VG (linear colorspace)" },
+    { EGL_VG_ALPHA_FORMAT_PRE_BIT, "VG (alpha format pre)" },
+    { EGL_MULTISAMPLE_RESOLVE_BOX_BIT, "multisample resolve box" },
+    { EGL_SWAP_BEHAVIOR_PRESERVED_BIT, "swap behavior preserved" },
+#ifdef EGL_STREAM_BIT_KHR
+    { EGL_STREAM_BIT_KHR, "stream" },
+#endif
+};
+
+static const enum_t renderableTypeMap[] {
+    { EGL_OPENGL_ES_BIT, "OpenGL ES" },
+    { EGL_OPENVG_BIT, "OpenVG" },
+    { EGL_OPENGL_ES2_BIT, "OpenGL ES2" },
+    { EGL_OPENGL_BIT, "OpenGL" },
+#ifdef EGL_OPENGL_ES3_BIT
+    { EGL_OPENGL_ES3_BIT, "OpenGL ES3" }
+#endif
+};
+
+#define A_NUM(x) { x, #x, 0, 0, false }
+#define A_MAP(x, map) { x, #x, map, sizeof(map) / sizeof(enum_t), false }
+#define A_FLAG(x, map) { x, #x, map, sizeof(map) / sizeof(enum_t), true }
+
+const attrib_t attributes[] {
+    A_NUM(EGL_ALPHA_SIZE),
+    A_NUM(EGL_ALPHA_MASK_SIZE),
+    A_MAP(EGL_BIND_TO_TEXTURE_RGB, boolMap),
+    A_MAP(EGL_BIND_TO_TEXTURE_RGBA, boolMap),
+    A_NUM(EGL_BLUE_SIZE),
+    A_NUM(EGL_BUFFER_SIZE),
+    A_MAP(EGL_COLOR_BUFFER_TYPE, bufferTypeMap),
+    A_MAP(EGL_CONFIG_CAVEAT, caveatMap),
+    A_NUM(EGL_CONFIG_ID),
+    A_FLAG(EGL_CONFORMANT, renderableTypeMap),
+    A_NUM(EGL_DEPTH_SIZE),
+    A_NUM(EGL_GREEN_SIZE),
+    A_NUM(EGL_LEVEL),
+    A_NUM(EGL_LUMINANCE_SIZE),
+    A_NUM(EGL_MAX_PBUFFER_WIDTH),
+    A_NUM(EGL_MAX_PBUFFER_HEIGHT),
+    A_NUM(EGL_MAX_PBUFFER_PIXELS),
+    A_NUM(EGL_MAX_SWAP_INTERVAL),
+    A_NUM(EGL_MIN_SWAP_INTERVAL),
+    A_MAP(EGL_NATIVE_RENDERABLE, boolMap),
+    A_NUM(EGL_NATIVE_VISUAL_ID),
+    A_NUM(EGL_NATIVE_VISUAL_TYPE),
+    A_NUM(EGL_RED_SIZE),
+    A_FLAG(EGL_RENDERABLE_TYPE, renderableTypeMap),
+    A_NUM(EGL_SAMPLE_BUFFERS),
+    A_NUM(EGL_SAMPLES),
+    A_NUM(EGL_STENCIL_SIZE),
+    A_FLAG(EGL_SURFACE_TYPE, surfaceTypeMap),
+    A_MAP(EGL_TRANSPARENT_TYPE, transparentTypeMap),
+    A_NUM(EGL_TRANSPARENT_RED_VALUE),
+    A_NUM(EGL_TRANSPARENT_GREEN_VALUE),
+    A_NUM(EGL_TRANSPARENT_BLUE_VALUE)
+};
+
+#undef A_NUM
+#undef A_MAP
+#undef A_FLAG
+
+int attributeIndex(EGLint attribute)
+{
+    for (int i = 0; i < attributesSize; ++i) {
+        if (attributes[i].attribute == attribute)
+            return i;
+    }
+    return -1;
+}
+
+static bool namesEqual(const char* a, size_t aLength, const char* b)
+{
+    size_t i = 0;
+    for (; i < aLength && b[i]; ++i) {
+        const char ca = a[i] == '_' ? ' ' : tolower(static_cast<unsigned char>(a[i]));
+        const char cb = b[i] == '_' ? ' ' : tolower(static_cast<unsigned char>(b[i]));
+        if (ca != cb)
+            return false;
+    }
+    return i == aLength && !b[i];
+}
+
+int attributeIndex(const char* name, size_t length)
+{
+    for (int i = 0; i < attributesSize; ++i) {
+        const char *displayName = attributes[i].displayName;
+        if (namesEqual(name, length, displayName) || namesEqual(name, length, displayName + 4))
+            return i;
+    }
+    return -1;
+}
+
+static void printEnum(ostream& out, int value, const attrib_t *attr)
+{
+    for (int i = 0; i < attr->enumMapSize; ++i) {
+        const enum_t *enumValue = &attr->enumMap[i];
+        if (value == enumValue->value) {
+            out << enumValue->displayName;
+            return;
+        }
+    }
+    out << "0x" << hex << value << dec;
+}
+
+static void printFlags(ostream& out, int value, const attrib_t *attr)
+{
+    bool firstEntry = true;
+    int handledFlags = 0;
+    for (int i = 0; i < attr->enumMapSize; ++i) {
+        const enum_t *enumValue = &attr->enumMap[i];
+        if (value & enumValue->value) {
+            if (!firstEntry)
+                out << ", ";
+            out << enumValue->displayName;
+            firstEntry = false;
+            handledFlags |= enumValue->value;
+        }
+    }
+
+    if (handledFlags != value) {
+        if (!firstEntry)
+            out << ", ";
+        out << "unhandled flags 0x" << hex << (value - handledFlags) << dec;
+    }
+}
+
+void printAttributeValue(ostream& out, const attrib_t* attr, EGLint value)
+{
+    if (attr->enumMap) {
+        if (!attr->isFlag)
+            printEnum(out, value, attr);
+        else
+            printFlags(out, value, attr);
+    } else {
+        out << value;
+    }
+}
+
+static bool parseNumber(const char* text, size_t length, EGLint* value)
+{
+    if (length == 0 || length > 31)
+        return false;
+    char buffer[32];
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    char *end = nullptr;
+    errno = 0;
+    const long long result = strtoll(buffer, &end, 0);
+    if (*end || errno == ERANGE)
+        return false;
+    // eglinfo prints negative enum and flag values as their 32 bit pattern in hex
+    const bool hex = length > 2 && buffer[0] == '0' && (buffer[1] == 'x' || buffer[1] == 'X');
+    const long long max = hex ? std::numeric_limits<uint32_t>::max() : std::numeric_limits<EGLint>::max();
+    if (result < std::numeric_limits<EGLint>::min() || result > max)
+        return false;
+    *value = static_cast<EGLint>(static_cast<uint32_t>(result));
+    return true;
+}
+
+static bool parseEnum(const attrib_t* attr, const char* text, size_t length, EGLint* value)
+{
+    for (int i = 0; i < attr->enumMapSize; ++i) {
+        if (namesEqual(text, length, attr->enumMap[i].displayName)) {
+            *value = attr->enumMap[i].value;
+            return true;
+        }
+    }
+    return parseNumber(text, length, value);
+}
+
+static void trim(const char** text, size_t* length)
+{
+    while (*length && isspace(static_cast<unsigned char>(**text))) {
+        ++*text;
+        --*length;
+    }
+    while (*length && isspace(static_cast<unsigned char>((*text)[*length - 1])))
+        --*length;
+}
+
+bool parseAttributeValue(const attrib_t* attr, const char* text, size_t length, EGLint* value)
+{
+    trim(&text, &length);
+    if (!attr->enumMap)
+        return parseNumber(text, length, value);
+    if (!attr->isFlag)
+        return parseEnum(attr, text, length, value);
+
+    static const char unhandledPrefix[] = "unhandled flags ";
+    *value = 0;
+    while (length) {
+        size_t itemLength = 0;
+        while (itemLength < length && text[itemLength] != ',' && text[itemLength] != '|')
+            ++itemLength;
+        const char *item = text;
+        size_t trimmedLength = itemLength;
+        trim(&item, &trimmedLength);
+        if (trimmedLength > sizeof(unhandledPrefix) - 1 && strncmp(item, unhandledPrefix, sizeof(unhandledPrefix) - 1) == 0) {
+            item += sizeof(unhandledPrefix) - 1;
+            trimmedLength -= sizeof(unhandledPrefix) - 1;
+        }
+        EGLint flag;
+        if (!parseEnum(attr, item, trimmedLength, &flag))
+            return false;
+        *value |= flag;
+
+        text += itemLength;
+        length -= itemLength;
+        if (length) {
+            ++text;
+            --length;
+        }
+    }
+    return true;
+}
+
+const device_property_t deviceProperties[] {
+#ifdef EGL_DRM_DEVICE_FILE_EXT
+    { EGL_DRM_DEVICE_FILE_EXT, "DRM device file", "EGL_EXT_device_drm", device_property_t::String },
+#endif
+#ifdef EGL_CUDA_DEVICE_NV
+    { EGL_CUDA_DEVICE_NV, "CUDA device", "EGL_NV_device_cuda", device_property_t::Attribute }
+#endif
+};
+
+const int devicePropertiesSize = sizeof(deviceProperties) / sizeof(device_property_t);
+
+static_assert(sizeof(deviceProperties) / sizeof(device_property_t) <= MaxDeviceProperties, "MaxDeviceProperties too small");
+
+}
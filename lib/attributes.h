@@ -0,0 +1,85 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_ATTRIBUTES_H
+#define EGLINFO_ATTRIBUTES_H
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace EglInfo {
+
+struct enum_t {
+    EGLint value;
+    const char* displayName;
+};
+
+struct attrib_t {
+    EGLint attribute;
+    const char* displayName;
+    const enum_t* enumMap;
+    int enumMapSize;
+    bool isFlag;
+};
+
+/** Number of entries in attributes, usable as a compile-time array size. */
+enum { AttributeCount = 32 };
+
+/** All EGLConfig attributes queried by the probe, in output order. */
+extern const attrib_t attributes[AttributeCount];
+static const int attributesSize = AttributeCount;
+
+/** Returns the index of @p attribute in attributes, or -1 if it is not queried. */
+int attributeIndex(EGLint attribute);
+
+/**
+ * Returns the index of the attribute called @p name (e.g. "EGL_SAMPLES" or "samples", case insensitive),
+ * or -1 if it is not queried.
+ */
+int attributeIndex(const char* name, size_t length);
+
+/** Prints @p value decoded according to @p attr (enum name, flag list or plain number). */
+void printAttributeValue(std::ostream& out, const attrib_t* attr, EGLint value);
+
+/**
+ * Parses what printAttributeValue() prints, as well as plain numbers. Enum names are matched
+ * case insensitively with '_' matching ' ', flags may be separated by ',' or '|'.
+ */
+bool parseAttributeValue(const attrib_t* attr, const char* text, size_t length, EGLint* value);
+
+struct device_property_t {
+    EGLint name;
+    const char* displayName;
+    const char* extension;
+    enum Type {
+        String,
+        Attribute
+    } type;
+};
+
+/** Upper bound for devicePropertiesSize, usable as a compile-time array size. */
+enum { MaxDeviceProperties = 2 };
+
+extern const device_property_t deviceProperties[];
+extern const int devicePropertiesSize;
+
+}
+
+#endif
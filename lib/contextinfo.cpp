@@ -0,0 +1,226 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "contextinfo.h"
+#include "glfunctions.h"
+
+#ifndef EGL_NO_CONFIG_KHR
+#define EGL_NO_CONFIG_KHR static_cast<EGLConfig>(nullptr)
+#endif
+
+namespace EglInfo {
+
+ContextInfo::ContextInfo()
+    : state(Ok)
+    , api(EGL_NONE)
+    , surfaceless(false)
+    , noConfig(false)
+    , maxTextureSize(0)
+    , maxRenderbufferSize(0)
+    , maxViewportDims{ 0, 0 }
+    , maxSamples(0)
+{
+}
+
+const char* apiName(EGLenum api)
+{
+    switch (api) {
+        case EGL_OPENGL_API:
+            return "OpenGL";
+        case EGL_OPENGL_ES_API:
+            return "OpenGL ES";
+        case EGL_OPENVG_API:
+            return "OpenVG";
+    }
+    return "unknown";
+}
+
+EGLConfig findConfig(const DisplayInfo& info, EGLint renderableBit, EGLint surfaceBits)
+{
+    for (const ConfigInfo &config : info.configs) {
+        if ((config.value(EGL_RENDERABLE_TYPE) & renderableBit) && (config.value(EGL_SURFACE_TYPE) & surfaceBits) == surfaceBits)
+            return config.config;
+    }
+    return nullptr;
+}
+
+static std::string glString(GL::Enum name)
+{
+    const GL::Ubyte *value = GL::functions().GetString(name);
+    return value ? reinterpret_cast<const char*>(value) : std::string();
+}
+
+std::string glExtensions()
+{
+    const GL::Functions &gl = GL::functions();
+    GL::Int count = 0;
+    if (gl.GetStringi) {
+        gl.GetIntegerv(GL::NUM_EXTENSIONS, &count);
+        // GL_NUM_EXTENSIONS is unknown before GL/GLES 3.0, fall back to the single string
+        if (gl.GetError() != GL::NO_ERROR)
+            count = 0;
+    }
+    if (count <= 0)
+        return glString(GL::EXTENSIONS);
+
+    std::string extensions;
+    for (GL::Int i = 0; i < count; ++i) {
+        const GL::Ubyte *extension = gl.GetStringi(GL::EXTENSIONS, i);
+        if (!extension)
+            continue;
+        if (!extensions.empty())
+            extensions += ' ';
+        extensions += reinterpret_cast<const char*>(extension);
+    }
+    return extensions;
+}
+
+/** Queries @p count values of @p name, leaving @p values untouched if the context does not know @p name. */
+static void glIntegers(GL::Enum name, EGLint* values, int count = 1)
+{
+    const GL::Functions &gl = GL::functions();
+    GL::Int data[2] = { 0, 0 };
+    gl.GetIntegerv(name, data);
+    if (gl.GetError() != GL::NO_ERROR)
+        return;
+    for (int i = 0; i < count; ++i)
+        values[i] = data[i];
+}
+
+static void queryContext(ContextInfo* context)
+{
+    const GL::Functions &gl = GL::functions();
+    // clear errors left by context creation
+    while (gl.GetError() != GL::NO_ERROR) {
+    }
+
+    context->vendor = glString(GL::VENDOR);
+    context->renderer = glString(GL::RENDERER);
+    context->version = glString(GL::VERSION);
+    context->shadingLanguageVersion = glString(GL::SHADING_LANGUAGE_VERSION);
+    context->extensions = glExtensions();
+    glIntegers(GL::MAX_TEXTURE_SIZE, &context->maxTextureSize);
+    glIntegers(GL::MAX_RENDERBUFFER_SIZE, &context->maxRenderbufferSize);
+    glIntegers(GL::MAX_VIEWPORT_DIMS, context->maxViewportDims, 2);
+    glIntegers(GL::MAX_SAMPLES, &context->maxSamples);
+}
+
+ScopedContext::ScopedContext(const DisplayInfo& info, EGLenum api)
+    : m_state(ContextInfo::Ok)
+    , m_surfaceless(hasExtension(info.extensions, "EGL_KHR_surfaceless_context"))
+    , m_noConfig(m_surfaceless && hasExtension(info.extensions, "EGL_KHR_no_config_context"))
+    , m_display(info.display)
+    , m_config(EGL_NO_CONFIG_KHR)
+    , m_context(EGL_NO_CONTEXT)
+    , m_surface(EGL_NO_SURFACE)
+{
+    if (!eglBindAPI(api)) {
+        m_state = ContextInfo::BindFailed;
+        return;
+    }
+
+    if (!m_noConfig) {
+        const EGLint renderableBit = api == EGL_OPENGL_API ? EGL_OPENGL_BIT : EGL_OPENGL_ES2_BIT;
+        m_config = findConfig(info, renderableBit, m_surfaceless ? 0 : EGL_PBUFFER_BIT);
+        if (!m_config) {
+            m_state = ContextInfo::NoConfig;
+            return;
+        }
+    }
+
+    // GLES 2 contexts are upgraded to the highest compatible version by most drivers
+    const EGLint esAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+    m_context = eglCreateContext(m_display, m_config, EGL_NO_CONTEXT, api == EGL_OPENGL_ES_API ? esAttribs : nullptr);
+    if (m_context == EGL_NO_CONTEXT) {
+        m_state = ContextInfo::CreateFailed;
+        return;
+    }
+
+    if (!m_surfaceless) {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        m_surface = eglCreatePbufferSurface(m_display, m_config, pbufferAttribs);
+        if (m_surface == EGL_NO_SURFACE) {
+            m_state = ContextInfo::SurfaceFailed;
+            return;
+        }
+    }
+
+    if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context))
+        m_state = ContextInfo::MakeCurrentFailed;
+}
+
+ScopedContext::~ScopedContext()
+{
+    if (m_state == ContextInfo::Ok)
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_surface != EGL_NO_SURFACE)
+        eglDestroySurface(m_display, m_surface);
+    if (m_context != EGL_NO_CONTEXT)
+        eglDestroyContext(m_display, m_context);
+}
+
+bool probeContext(const DisplayInfo& info, EGLenum api, ContextInfo* context)
+{
+    *context = ContextInfo();
+    context->api = api;
+
+    ScopedContext scope(info, api);
+    context->surfaceless = scope.surfaceless();
+    context->noConfig = scope.noConfig();
+    context->state = scope.state();
+    if (scope.isCurrent()) {
+        if (GL::functions().isValid())
+            queryContext(context);
+        else
+            context->state = ContextInfo::Unresolved;
+    }
+    return context->state == ContextInfo::Ok;
+}
+
+// the client API names are space separated like extensions
+static const EGLenum apis[] = { EGL_OPENGL_ES_API, EGL_OPENGL_API };
+static const char* const apiTokens[] = { "OpenGL_ES", "OpenGL" };
+
+std::vector<EGLenum> supportedApis(const DisplayInfo& info)
+{
+    std::vector<EGLenum> supported;
+    for (int i = 0; i < 2; ++i) {
+        if (hasExtension(info.clientAPIs, apiTokens[i]))
+            supported.push_back(apis[i]);
+    }
+    return supported;
+}
+
+EGLenum preferredApi(const DisplayInfo& info)
+{
+    const std::vector<EGLenum> supported = supportedApis(info);
+    return supported.empty() ? EGL_NONE : supported.front();
+}
+
+void probeContexts(const DisplayInfo& info, std::vector<ContextInfo>* contexts)
+{
+    contexts->clear();
+    if (info.state != DisplayInfo::Ok)
+        return;
+
+    for (EGLenum api : supportedApis(info)) {
+        contexts->emplace_back();
+        probeContext(info, api, &contexts->back());
+    }
+}
+
+}
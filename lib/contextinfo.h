@@ -0,0 +1,120 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_CONTEXTINFO_H
+#define EGLINFO_CONTEXTINFO_H
+
+#include "probe.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/** GL/GLES implementation details of one client API on a display, see probeContexts(). */
+struct ContextInfo {
+    enum State {
+        Ok,
+        BindFailed,
+        NoConfig,
+        CreateFailed,
+        SurfaceFailed,
+        MakeCurrentFailed,
+        Unresolved
+    } state;
+    /** EGL_OPENGL_API or EGL_OPENGL_ES_API. */
+    EGLenum api;
+    /** True if the context was made current without a surface (EGL_KHR_surfaceless_context). */
+    bool surfaceless;
+    /** True if the context was created without a config (EGL_KHR_no_config_context). */
+    bool noConfig;
+    std::string vendor;
+    std::string renderer;
+    std::string version;
+    std::string shadingLanguageVersion;
+    /** Space separated, like the EGL extension strings. */
+    std::string extensions;
+    EGLint maxTextureSize;
+    EGLint maxRenderbufferSize;
+    EGLint maxViewportDims[2];
+    /** 0 if the context does not support multisampled renderbuffers. */
+    EGLint maxSamples;
+
+    ContextInfo();
+};
+
+/**
+ * Creates a context for a client API on an initialized display and keeps it current on the
+ * calling thread for its lifetime, without config and surface where the display allows it.
+ */
+class ScopedContext
+{
+public:
+    ScopedContext(const DisplayInfo& info, EGLenum api);
+    ~ScopedContext();
+
+    ScopedContext(const ScopedContext&) = delete;
+    ScopedContext& operator=(const ScopedContext&) = delete;
+
+    /** ContextInfo::Ok if the context is current. */
+    ContextInfo::State state() const { return m_state; }
+    bool isCurrent() const { return m_state == ContextInfo::Ok; }
+    bool surfaceless() const { return m_surfaceless; }
+    bool noConfig() const { return m_noConfig; }
+    EGLDisplay display() const { return m_display; }
+    EGLConfig config() const { return m_config; }
+    EGLContext context() const { return m_context; }
+
+private:
+    ContextInfo::State m_state;
+    bool m_surfaceless;
+    bool m_noConfig;
+    EGLDisplay m_display;
+    EGLConfig m_config;
+    EGLContext m_context;
+    EGLSurface m_surface;
+};
+
+/** Returns the first config of @p info renderable with @p renderableBit and supporting @p surfaceBits, or nullptr. */
+EGLConfig findConfig(const DisplayInfo& info, EGLint renderableBit, EGLint surfaceBits);
+
+/** Returns the context client APIs of @p info in the order probeContexts() probes them. */
+std::vector<EGLenum> supportedApis(const DisplayInfo& info);
+
+/** Returns the client API probeContexts() would probe first on @p info, or EGL_NONE. */
+EGLenum preferredApi(const DisplayInfo& info);
+
+/** Returns the extensions of the GL/GLES context current on the calling thread, space separated. */
+std::string glExtensions();
+
+/** Returns the display name of @p api, e.g. "OpenGL ES". */
+const char* apiName(EGLenum api);
+
+/**
+ * Creates exactly one context per client API supported by the initialized display @p info,
+ * queries its GL strings and limits and destroys it again. Uses EGL_KHR_no_config_context and
+ * EGL_KHR_surfaceless_context where available, otherwise the first suitable config of
+ * @p info and a 1x1 pbuffer. Leaves no context current on the calling thread.
+ */
+void probeContexts(const DisplayInfo& info, std::vector<ContextInfo>* contexts);
+
+/** Probes the context for a single client @p api, see probeContexts(). */
+bool probeContext(const DisplayInfo& info, EGLenum api, ContextInfo* context);
+
+}
+
+#endif
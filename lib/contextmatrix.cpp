@@ -0,0 +1,185 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "contextmatrix.h"
+#include "contextinfo.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifndef EGL_NO_CONFIG_KHR
+#define EGL_NO_CONFIG_KHR static_cast<EGLConfig>(nullptr)
+#endif
+
+namespace EglInfo {
+
+static void addFlavors(const DisplayInfo& info, ContextMatrix* matrix)
+{
+    const bool createContext = hasExtension(info.extensions, "EGL_KHR_create_context")
+        || info.majorVersion > 1 || (info.majorVersion == 1 && info.minorVersion >= 5);
+
+    if (hasExtension(info.clientAPIs, "OpenGL_ES")) {
+        matrix->flavors.push_back({ EGL_OPENGL_ES_API, 1, -1, 0 });
+        if (createContext) {
+            static const EGLint esVersions[][2] = { { 2, 0 }, { 3, 0 }, { 3, 1 }, { 3, 2 } };
+            for (const auto &version : esVersions)
+                matrix->flavors.push_back({ EGL_OPENGL_ES_API, version[0], version[1], 0 });
+        } else {
+            matrix->flavors.push_back({ EGL_OPENGL_ES_API, 2, -1, 0 });
+            matrix->flavors.push_back({ EGL_OPENGL_ES_API, 3, -1, 0 });
+        }
+    }
+
+    if (hasExtension(info.clientAPIs, "OpenGL")) {
+        if (!createContext) {
+            matrix->flavors.push_back({ EGL_OPENGL_API, 1, -1, 0 });
+            return;
+        }
+        static const EGLint glVersions[][2] = {
+            { 2, 1 }, { 3, 0 }, { 3, 1 }, { 3, 2 }, { 3, 3 },
+            { 4, 0 }, { 4, 1 }, { 4, 2 }, { 4, 3 }, { 4, 4 }, { 4, 5 }, { 4, 6 }
+        };
+        for (const auto &version : glVersions) {
+            // profiles exist from 3.2 on
+            if (version[0] * 10 + version[1] < 32) {
+                matrix->flavors.push_back({ EGL_OPENGL_API, version[0], version[1], 0 });
+                continue;
+            }
+            matrix->flavors.push_back({ EGL_OPENGL_API, version[0], version[1], EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR });
+            matrix->flavors.push_back({ EGL_OPENGL_API, version[0], version[1], EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR });
+        }
+    }
+}
+
+static EGLint renderableBit(const ContextFlavor& flavor)
+{
+    if (flavor.api == EGL_OPENGL_API)
+        return EGL_OPENGL_BIT;
+    if (flavor.majorVersion >= 3)
+        return EGL_OPENGL_ES3_BIT_KHR;
+    return flavor.majorVersion == 2 ? EGL_OPENGL_ES2_BIT : EGL_OPENGL_ES_BIT;
+}
+
+static void attempt(const DisplayInfo& info, const ContextFlavor& flavor, bool noConfig, ContextAttempt* result)
+{
+    const EGLConfig config = noConfig ? EGL_NO_CONFIG_KHR : findConfig(info, renderableBit(flavor), 0);
+    if (!noConfig && !config) {
+        result->error = EGL_SUCCESS;
+        return;
+    }
+
+    EGLint attribs[16];
+    int count = 0;
+    if (flavor.minorVersion < 0) {
+        if (flavor.api == EGL_OPENGL_ES_API) {
+            attribs[count++] = EGL_CONTEXT_CLIENT_VERSION;
+            attribs[count++] = flavor.majorVersion;
+        }
+    } else {
+        attribs[count++] = EGL_CONTEXT_MAJOR_VERSION_KHR;
+        attribs[count++] = flavor.majorVersion;
+        attribs[count++] = EGL_CONTEXT_MINOR_VERSION_KHR;
+        attribs[count++] = flavor.minorVersion;
+    }
+    if (flavor.profile) {
+        attribs[count++] = EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR;
+        attribs[count++] = flavor.profile;
+    }
+    if (result->flags & ContextMatrix::Robust) {
+        attribs[count++] = EGL_CONTEXT_OPENGL_ROBUST_ACCESS_EXT;
+        attribs[count++] = EGL_TRUE;
+    }
+    if (result->flags & ContextMatrix::NoError) {
+        attribs[count++] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        attribs[count++] = EGL_TRUE;
+    }
+    if (result->priority) {
+        attribs[count++] = EGL_CONTEXT_PRIORITY_LEVEL_IMG;
+        attribs[count++] = result->priority;
+    }
+    attribs[count] = EGL_NONE;
+
+    // the bound API is per thread, so every worker binds its own
+    if (!eglBindAPI(flavor.api)) {
+        result->error = eglGetError();
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const EGLContext context = eglCreateContext(info.display, config, EGL_NO_CONTEXT, attribs);
+    result->nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    if (context == EGL_NO_CONTEXT) {
+        result->error = eglGetError();
+        return;
+    }
+    result->created = true;
+    result->error = EGL_SUCCESS;
+    // drivers may silently grant a lower priority than requested
+    if (result->priority && !eglQueryContext(info.display, context, EGL_CONTEXT_PRIORITY_LEVEL_IMG, &result->grantedPriority))
+        result->grantedPriority = 0;
+    eglDestroyContext(info.display, context);
+}
+
+void probeContextMatrix(const DisplayInfo& info, int threads, ContextMatrix* matrix)
+{
+    *matrix = ContextMatrix();
+    if (info.state != DisplayInfo::Ok)
+        return;
+    addFlavors(info, matrix);
+
+    matrix->flagSets.push_back(0);
+    const bool robust = hasExtension(info.extensions, "EGL_EXT_create_context_robustness");
+    const bool noError = hasExtension(info.extensions, "EGL_KHR_create_context_no_error");
+    if (robust)
+        matrix->flagSets.push_back(ContextMatrix::Robust);
+    if (noError)
+        matrix->flagSets.push_back(ContextMatrix::NoError);
+    if (robust && noError)
+        matrix->flagSets.push_back(ContextMatrix::Robust | ContextMatrix::NoError);
+
+    matrix->priorities.push_back(0);
+    if (hasExtension(info.extensions, "EGL_IMG_context_priority")) {
+        matrix->priorities.push_back(EGL_CONTEXT_PRIORITY_LOW_IMG);
+        matrix->priorities.push_back(EGL_CONTEXT_PRIORITY_MEDIUM_IMG);
+        matrix->priorities.push_back(EGL_CONTEXT_PRIORITY_HIGH_IMG);
+    }
+
+    for (size_t flavor = 0; flavor < matrix->flavors.size(); ++flavor) {
+        for (int flags : matrix->flagSets) {
+            for (EGLint priority : matrix->priorities)
+                matrix->attempts.push_back({ flags, priority, false, EGL_SUCCESS, 0, 0 });
+        }
+    }
+
+    const bool noConfig = hasExtension(info.extensions, "EGL_KHR_no_config_context");
+    const size_t perFlavor = matrix->flagSets.size() * matrix->priorities.size();
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < std::max(1, std::min<int>(threads, matrix->attempts.size())); ++i) {
+        workers.emplace_back([&] {
+            for (size_t a = next++; a < matrix->attempts.size(); a = next++)
+                attempt(info, matrix->flavors[a / perFlavor], noConfig, &matrix->attempts[a]);
+            eglReleaseThread();
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_CONTEXTMATRIX_H
+#define EGLINFO_CONTEXTMATRIX_H
+
+#include "probe.h"
+
+#include <vector>
+
+namespace EglInfo {
+
+/** Client API, version and profile of a context, one row of the ContextMatrix. */
+struct ContextFlavor {
+    EGLenum api;
+    EGLint majorVersion;
+    /** -1 if only the major version can be requested (no EGL_KHR_create_context). */
+    EGLint minorVersion;
+    /** EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR or 0. */
+    EGLint profile;
+};
+
+/** One eglCreateContext call of probeContextMatrix(). */
+struct ContextAttempt {
+    /** Combination of ContextMatrix::Flag. */
+    int flags;
+    /** Requested EGL_CONTEXT_PRIORITY_LEVEL_IMG, 0 for none. */
+    EGLint priority;
+    bool created;
+    /** EGL error if the context was not created, EGL_SUCCESS if no suitable config exists. */
+    EGLint error;
+    /** EGL_CONTEXT_PRIORITY_LEVEL_IMG the driver granted, 0 if not queried. */
+    EGLint grantedPriority;
+    /** Latency of eglCreateContext, in nanoseconds. */
+    int64_t nanoseconds;
+};
+
+/**
+ * Which combinations of context attributes a display accepts. Attempts are stored row major:
+ * for every flavor, for every flag set, for every priority.
+ */
+struct ContextMatrix {
+    enum Flag {
+        /** EGL_CONTEXT_OPENGL_ROBUST_ACCESS_EXT (EGL_EXT_create_context_robustness). */
+        Robust = 1,
+        /** EGL_CONTEXT_OPENGL_NO_ERROR_KHR (EGL_KHR_create_context_no_error). */
+        NoError = 2
+    };
+
+    std::vector<ContextFlavor> flavors;
+    /** Flag combinations attempted, 0 first, limited to the extensions of the display. */
+    std::vector<int> flagSets;
+    /** Priorities attempted, 0 (none) first, then the EGL_IMG_context_priority levels if supported. */
+    std::vector<EGLint> priorities;
+    std::vector<ContextAttempt> attempts;
+
+    const ContextAttempt& attempt(size_t flavor, size_t flagSet, size_t priority) const
+    {
+        return attempts[(flavor * flagSets.size() + flagSet) * priorities.size() + priority];
+    }
+};
+
+/**
+ * Creates and immediately destroys one context for every combination of client API version and
+ * profile, robustness, no-error and priority the initialized display @p info could support,
+ * spread over @p threads worker threads with their own API binding. Contexts are created without
+ * config where EGL_KHR_no_config_context allows it and never made current, so the latencies are
+ * those of eglCreateContext alone, including contention between the workers.
+ */
+void probeContextMatrix(const DisplayInfo& info, int threads, ContextMatrix* matrix);
+
+}
+
+#endif
@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "costmodel.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+
+namespace EglInfo {
+
+/** Storage bytes for @p bits, rounded up to a power of two. */
+static int storageBytes(int bits)
+{
+    if (bits <= 0)
+        return 0;
+    int bytes = 1;
+    while (bytes * 8 < bits)
+        bytes *= 2;
+    return bytes;
+}
+
+static int colorBytes(const ConfigInfo& config)
+{
+    return storageBytes(config.value(EGL_BUFFER_SIZE));
+}
+
+static int samples(const ConfigInfo& config)
+{
+    return config.value(EGL_SAMPLE_BUFFERS) ? std::max(1, int(config.value(EGL_SAMPLES))) : 1;
+}
+
+int bytesPerPixel(const ConfigInfo& config)
+{
+    // depth and stencil are interleaved in one buffer, as drivers do for D24S8
+    const int depthStencil = storageBytes(config.value(EGL_DEPTH_SIZE) + config.value(EGL_STENCIL_SIZE));
+    return (colorBytes(config) + depthStencil) * samples(config);
+}
+
+int64_t frameBytes(const ConfigInfo& config, const CostModel& model)
+{
+    int64_t perPixel = bytesPerPixel(config);
+    if (samples(config) > 1)
+        perPixel += colorBytes(config);
+    return perPixel * model.width * model.height;
+}
+
+int64_t writeBandwidth(const ConfigInfo& config, const CostModel& model)
+{
+    return frameBytes(config, model) * model.refreshRate;
+}
+
+bool parseResolution(const char* text, CostModel* model)
+{
+    char *end = nullptr;
+    const long width = strtol(text, &end, 10);
+    if (end == text || (*end != 'x' && *end != 'X'))
+        return false;
+    const char *heightText = end + 1;
+    const long height = strtol(heightText, &end, 10);
+    if (end == heightText || *end || width <= 0 || height <= 0 || width > 65536 || height > 65536)
+        return false;
+    model->width = width;
+    model->height = height;
+    return true;
+}
+
+bool parseByteAmount(const char* text, size_t length, int64_t* amount)
+{
+    int64_t value = 0;
+    size_t i = 0;
+    for (; i < length && isdigit(static_cast<unsigned char>(text[i])); ++i) {
+        value = value * 10 + (text[i] - '0');
+        if (value > (int64_t(1) << 40))
+            return false;
+    }
+    if (i == 0)
+        return false;
+    if (i + 1 == length) {
+        int shift = 0;
+        switch (tolower(static_cast<unsigned char>(text[i]))) {
+            case 'k':
+                shift = 10;
+                break;
+            case 'm':
+                shift = 20;
+                break;
+            case 'g':
+                shift = 30;
+                break;
+            default:
+                return false;
+        }
+        if (value > (std::numeric_limits<int64_t>::max() >> shift))
+            return false;
+        value <<= shift;
+    } else if (i != length) {
+        return false;
+    }
+    *amount = value;
+    return true;
+}
+
+void printByteAmount(std::ostream& stream, int64_t bytes)
+{
+    static const char* const units[] = { "bytes", "KiB", "MiB", "GiB", "TiB" };
+    double value = bytes;
+    int unit = 0;
+    while (value >= 1024 && unit < 4) {
+        value /= 1024;
+        ++unit;
+    }
+    if (unit == 0) {
+        stream << bytes << " " << units[0];
+        return;
+    }
+    const std::ios_base::fmtflags flags = stream.flags();
+    const std::streamsize precision = stream.precision();
+    stream << std::fixed << std::setprecision(1) << value << " " << units[unit];
+    stream.flags(flags);
+    stream.precision(precision);
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_COSTMODEL_H
+#define EGLINFO_COSTMODEL_H
+
+#include "probe.h"
+
+#include <cstdint>
+#include <ostream>
+
+namespace EglInfo {
+
+/**
+ * Resolution and refresh rate the memory cost of a config is estimated for.
+ *
+ * The estimate assumes every buffer is stored with its components rounded up to a power of two
+ * bytes per sample (e.g. RGB888 in 4 bytes, D24S8 in 4 bytes) and, for multisampled configs, one
+ * extra single sampled color buffer the samples are resolved into. Every buffer is written once
+ * per frame, so the bandwidth is a lower bound ignoring overdraw, reads and compression.
+ */
+struct CostModel {
+    int width = 3840;
+    int height = 2160;
+    int refreshRate = 60;
+};
+
+/** Bytes of color, depth and stencil storage per pixel of @p config, times its sample count. */
+int bytesPerPixel(const ConfigInfo& config);
+
+/** Estimated size of all buffers of one frame of @p config at the resolution of @p model. */
+int64_t frameBytes(const ConfigInfo& config, const CostModel& model);
+
+/** Estimated bytes written per second by @p config at the resolution and refresh rate of @p model. */
+int64_t writeBandwidth(const ConfigInfo& config, const CostModel& model);
+
+/** Parses "WIDTHxHEIGHT" into @p model. */
+bool parseResolution(const char* text, CostModel* model);
+
+/** Parses a byte amount with optional k, m or g (binary) suffix, e.g. "64m". Rejects amounts beyond int64_t. */
+bool parseByteAmount(const char* text, size_t length, int64_t* amount);
+
+/** Prints @p bytes with a binary unit, e.g. "31.6 MiB". */
+void printByteAmount(std::ostream& stream, int64_t bytes);
+
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dmabuf.h"
+#include "probe.h"
+
+#include <algorithm>
+#include <cctype>
+
+#ifndef EGL_EXT_image_dma_buf_import_modifiers
+typedef EGLBoolean (EGLAPIENTRYP PFNEGLQUERYDMABUFFORMATSEXTPROC)(EGLDisplay dpy, EGLint max_formats, EGLint* formats, EGLint* num_formats);
+typedef EGLBoolean (EGLAPIENTRYP PFNEGLQUERYDMABUFMODIFIERSEXTPROC)(EGLDisplay dpy, EGLint format, EGLint max_modifiers, EGLuint64KHR* modifiers, EGLBoolean* external_only, EGLint* num_modifiers);
+#endif
+
+namespace EglInfo {
+
+// Most drivers report fewer formats and modifiers per format than this, so the lists usually
+// take one call each instead of a count query followed by the actual query.
+enum {
+    InitialFormatCapacity = 128,
+    InitialModifierCapacity = 32
+};
+
+DmaBufFormats::DmaBufFormats()
+    : state(NotQueried)
+{
+}
+
+const DmaBufFormat* DmaBufFormats::findFormat(uint32_t fourcc) const
+{
+    const auto it = std::lower_bound(formats.begin(), formats.end(), fourcc, [](const DmaBufFormat& format, uint32_t fourcc) {
+        return format.fourcc < fourcc;
+    });
+    return it != formats.end() && it->fourcc == fourcc ? &*it : nullptr;
+}
+
+const DmaBufModifier* DmaBufFormats::findModifier(uint32_t fourcc, uint64_t modifier) const
+{
+    const DmaBufFormat *format = findFormat(fourcc);
+    if (!format)
+        return nullptr;
+    const auto begin = modifiers.begin() + format->firstModifier;
+    const auto end = begin + format->modifierCount;
+    const auto it = std::lower_bound(begin, end, modifier, [](const DmaBufModifier& entry, uint64_t modifier) {
+        return entry.modifier < modifier;
+    });
+    return it != end && it->modifier == modifier ? &*it : nullptr;
+}
+
+std::string fourccName(uint32_t fourcc)
+{
+    std::string name(4, ' ');
+    for (int i = 0; i < 4; ++i) {
+        const char c = static_cast<char>((fourcc >> (8 * i)) & 0xff);
+        name[i] = isprint(static_cast<unsigned char>(c)) ? c : '?';
+    }
+    return name;
+}
+
+/**
+ * Runs a list query with an initial buffer of @p capacity entries and only asks for the count
+ * and queries again if the buffer was filled completely.
+ */
+template <typename Query>
+static bool queryList(int capacity, Query query, EGLint* count)
+{
+    if (!query(capacity, count))
+        return false;
+    if (*count < capacity)
+        return true;
+    if (!query(0, count))
+        return false;
+    return query(*count, count);
+}
+
+bool queryDmaBufFormats(EGLDisplay display, const char* extensions, DmaBufFormats* result)
+{
+    *result = DmaBufFormats();
+    if (!hasExtension(extensions, "EGL_EXT_image_dma_buf_import_modifiers")) {
+        result->state = DmaBufFormats::Unsupported;
+        return false;
+    }
+
+    static const auto eglQueryDmaBufFormatsEXT = reinterpret_cast<PFNEGLQUERYDMABUFFORMATSEXTPROC>(eglGetProcAddress("eglQueryDmaBufFormatsEXT"));
+    static const auto eglQueryDmaBufModifiersEXT = reinterpret_cast<PFNEGLQUERYDMABUFMODIFIERSEXTPROC>(eglGetProcAddress("eglQueryDmaBufModifiersEXT"));
+    if (!eglQueryDmaBufFormatsEXT || !eglQueryDmaBufModifiersEXT) {
+        result->state = DmaBufFormats::Unresolved;
+        return false;
+    }
+
+    std::vector<EGLint> fourccs;
+    EGLint formatCount = 0;
+    const bool formatsOk = queryList(InitialFormatCapacity, [&](EGLint capacity, EGLint* count) {
+        fourccs.resize(capacity);
+        return eglQueryDmaBufFormatsEXT(display, capacity, capacity ? fourccs.data() : nullptr, count) != EGL_FALSE;
+    }, &formatCount);
+    if (!formatsOk) {
+        result->state = DmaBufFormats::QueryFailed;
+        return false;
+    }
+    fourccs.resize(formatCount);
+    std::sort(fourccs.begin(), fourccs.end(), [](EGLint a, EGLint b) { return uint32_t(a) < uint32_t(b); });
+
+    std::vector<EGLuint64KHR> modifiers;
+    std::vector<EGLBoolean> externalOnly;
+    result->formats.reserve(formatCount);
+    for (EGLint fourcc : fourccs) {
+        EGLint modifierCount = 0;
+        const bool modifiersOk = queryList(InitialModifierCapacity, [&](EGLint capacity, EGLint* count) {
+            modifiers.resize(capacity);
+            externalOnly.resize(capacity);
+            return eglQueryDmaBufModifiersEXT(display, fourcc, capacity, capacity ? modifiers.data() : nullptr,
+                                              capacity ? externalOnly.data() : nullptr, count) != EGL_FALSE;
+        }, &modifierCount);
+        if (!modifiersOk) {
+            result->state = DmaBufFormats::QueryFailed;
+            return false;
+        }
+
+        DmaBufFormat format;
+        format.fourcc = fourcc;
+        format.firstModifier = result->modifiers.size();
+        format.modifierCount = modifierCount;
+        for (EGLint i = 0; i < modifierCount; ++i)
+            result->modifiers.push_back(DmaBufModifier{ modifiers[i], externalOnly[i] != EGL_FALSE });
+        std::sort(result->modifiers.begin() + format.firstModifier, result->modifiers.end(), [](const DmaBufModifier& a, const DmaBufModifier& b) {
+            return a.modifier < b.modifier;
+        });
+        result->formats.push_back(format);
+    }
+
+    result->state = DmaBufFormats::Ok;
+    return true;
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_DMABUF_H
+#define EGLINFO_DMABUF_H
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+struct DmaBufModifier {
+    uint64_t modifier;
+    /** The format can only be imported as GL_TEXTURE_EXTERNAL_OES with this modifier. */
+    bool externalOnly;
+};
+
+struct DmaBufFormat {
+    /** DRM fourcc code. */
+    uint32_t fourcc;
+    /** Index of the first modifier of this format in DmaBufFormats::modifiers. */
+    uint32_t firstModifier;
+    uint32_t modifierCount;
+};
+
+/**
+ * DMA-BUF formats and modifiers a display can import (EGL_EXT_image_dma_buf_import_modifiers).
+ * The formats are sorted by fourcc, the modifiers of each format are sorted by value and stored
+ * contiguously in a single table, so lookups are binary searches.
+ */
+struct DmaBufFormats {
+    enum State {
+        NotQueried,
+        Unsupported,
+        Unresolved,
+        QueryFailed,
+        Ok
+    } state;
+    std::vector<DmaBufFormat> formats;
+    std::vector<DmaBufModifier> modifiers;
+
+    DmaBufFormats();
+
+    const DmaBufFormat* findFormat(uint32_t fourcc) const;
+    /** Returns nullptr if @p fourcc cannot be imported with @p modifier. */
+    const DmaBufModifier* findModifier(uint32_t fourcc, uint64_t modifier) const;
+};
+
+/** Returns @p fourcc as its four characters, e.g. "AR24" for DRM_FORMAT_ARGB8888. */
+std::string fourccName(uint32_t fourcc);
+
+/** Enumerates the formats and modifiers of the initialized @p display with the given @p extensions. */
+bool queryDmaBufFormats(EGLDisplay display, const char* extensions, DmaBufFormats* formats);
+
+}
+
+#endif
@@ -0,0 +1,571 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "encoding.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace EglInfo {
+
+static const char EncodingMagic[8] = { 'E', 'G', 'L', 'I', 'N', 'F', 'O', 'Z' };
+enum { EncodingVersion = 1 };
+
+enum Validity {
+    AllValid,
+    NoneValid,
+    ValidBitmap
+};
+
+enum ColumnMode {
+    FrameOfReference,
+    Delta
+};
+
+namespace {
+
+class Writer
+{
+public:
+    explicit Writer(std::string* out) : m_out(out) {}
+
+    void byte(uint8_t value) { m_out->push_back(static_cast<char>(value)); }
+    void bytes(const void* data, size_t size) { m_out->append(static_cast<const char*>(data), size); }
+
+    void varint(uint64_t value)
+    {
+        while (value >= 0x80) {
+            byte(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        byte(static_cast<uint8_t>(value));
+    }
+
+    void signedVarint(int64_t value) { varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); }
+
+    void u64(uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            byte(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    /** Packs the low @p bits bits of each of @p count values, LSB first. */
+    void packed(const uint64_t* values, size_t count, int bits)
+    {
+        uint64_t buffer = 0;
+        int filled = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t value = values[i];
+            int remaining = bits;
+            while (remaining > 0) {
+                const int take = std::min(remaining, 64 - filled);
+                const uint64_t part = take == 64 ? value : value & ((uint64_t(1) << take) - 1);
+                buffer |= part << filled;
+                filled += take;
+                remaining -= take;
+                value = take == 64 ? 0 : value >> take;
+                if (filled == 64) {
+                    u64(buffer);
+                    buffer = 0;
+                    filled = 0;
+                }
+            }
+        }
+        for (; filled > 0; filled -= 8) {
+            byte(static_cast<uint8_t>(buffer));
+            buffer >>= 8;
+        }
+    }
+
+private:
+    std::string* m_out;
+};
+
+class Reader
+{
+public:
+    Reader(const char* data, size_t size)
+        : m_data(reinterpret_cast<const uint8_t*>(data))
+        , m_end(m_data + size)
+        , m_ok(true)
+    {
+    }
+
+    bool ok() const { return m_ok; }
+
+    uint8_t byte()
+    {
+        if (m_data >= m_end) {
+            m_ok = false;
+            return 0;
+        }
+        return *m_data++;
+    }
+
+    const char* bytes(size_t size)
+    {
+        if (size_t(m_end - m_data) < size) {
+            m_ok = false;
+            return nullptr;
+        }
+        const char *result = reinterpret_cast<const char*>(m_data);
+        m_data += size;
+        return result;
+    }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = byte();
+            value |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80))
+                return value;
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    int64_t signedVarint()
+    {
+        const uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    uint64_t u64()
+    {
+        const char *data = bytes(8);
+        if (!data)
+            return 0;
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= uint64_t(static_cast<uint8_t>(data[i])) << (8 * i);
+        return value;
+    }
+
+    /** Unpacks @p count values of @p bits bits each, adding @p base to each. */
+    bool packed(size_t count, int bits, int64_t base, int64_t* values)
+    {
+        const size_t size = (count * bits + 7) / 8;
+        const uint8_t *data = reinterpret_cast<const uint8_t*>(bytes(size));
+        if (!data)
+            return false;
+        if (bits == 0) {
+            for (size_t i = 0; i < count; ++i)
+                values[i] = base;
+            return true;
+        }
+
+        const uint64_t mask = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        size_t bitPos = 0;
+        for (size_t i = 0; i < count; ++i, bitPos += bits) {
+            // gather the (at most 9) bytes containing this value
+            const size_t first = bitPos / 8;
+            const int shift = bitPos % 8;
+            uint64_t word = 0;
+            const size_t available = std::min<size_t>(8, size - first);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            memcpy(&word, data + first, available);
+#else
+            for (size_t j = 0; j < available; ++j)
+                word |= uint64_t(data[first + j]) << (8 * j);
+#endif
+            uint64_t value = word >> shift;
+            if (shift + bits > 64 && first + 8 < size)
+                value |= uint64_t(data[first + 8]) << (64 - shift);
+            values[i] = base + static_cast<int64_t>(value & mask);
+        }
+        return true;
+    }
+
+private:
+    const uint8_t* m_data;
+    const uint8_t* m_end;
+    bool m_ok;
+};
+
+}
+
+static int bitsFor(uint64_t range)
+{
+    int bits = 0;
+    while (bits < 64 && (range >> bits))
+        ++bits;
+    return bits;
+}
+
+static void encodeColumn(Writer& writer, const std::vector<ConfigInfo>& configs, int attribute)
+{
+    std::vector<uint8_t> bitmap((configs.size() + 7) / 8, 0);
+    std::vector<int64_t> values;
+    values.reserve(configs.size());
+    for (size_t i = 0; i < configs.size(); ++i) {
+        if (configs[i].isValid(attribute)) {
+            bitmap[i / 8] |= 1 << (i % 8);
+            values.push_back(configs[i].values[attribute]);
+        }
+    }
+
+    if (values.empty()) {
+        writer.byte(NoneValid);
+        return;
+    }
+    if (values.size() == configs.size()) {
+        writer.byte(AllValid);
+    } else {
+        writer.byte(ValidBitmap);
+        writer.bytes(bitmap.data(), bitmap.size());
+    }
+
+    const ColumnMode mode = attributes[attribute].attribute == EGL_CONFIG_ID ? Delta : FrameOfReference;
+    if (mode == Delta) {
+        for (size_t i = values.size() - 1; i > 0; --i)
+            values[i] -= values[i - 1];
+    }
+
+    int64_t minimum = values[0], maximum = values[0];
+    for (int64_t value : values) {
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+    const int bits = bitsFor(static_cast<uint64_t>(maximum - minimum));
+    std::vector<uint64_t> offsets(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        offsets[i] = static_cast<uint64_t>(values[i] - minimum);
+
+    writer.byte(mode);
+    writer.signedVarint(minimum);
+    writer.byte(bits);
+    writer.packed(offsets.data(), offsets.size(), bits);
+}
+
+static void encodeDmaBufFormats(Writer& writer, const DmaBufFormats& formats)
+{
+    writer.varint(formats.state);
+    writer.varint(formats.formats.size());
+    uint32_t previousFourcc = 0;
+    std::vector<uint64_t> externalOnly;
+    for (const DmaBufFormat &format : formats.formats) {
+        writer.varint(format.fourcc - previousFourcc);
+        previousFourcc = format.fourcc;
+        writer.varint(format.modifierCount);
+        uint64_t previousModifier = 0;
+        externalOnly.clear();
+        for (uint32_t i = 0; i < format.modifierCount; ++i) {
+            const DmaBufModifier &modifier = formats.modifiers[format.firstModifier + i];
+            writer.varint(modifier.modifier - previousModifier);
+            previousModifier = modifier.modifier;
+            externalOnly.push_back(modifier.externalOnly);
+        }
+        writer.packed(externalOnly.data(), externalOnly.size(), 1);
+    }
+}
+
+static bool decodeDmaBufFormats(Reader& reader, size_t size, DmaBufFormats* formats)
+{
+    formats->state = static_cast<DmaBufFormats::State>(reader.varint());
+    const uint64_t formatCount = reader.varint();
+    if (!reader.ok() || formatCount > size)
+        return false;
+    uint32_t fourcc = 0;
+    std::vector<int64_t> externalOnly;
+    for (uint64_t f = 0; f < formatCount && reader.ok(); ++f) {
+        fourcc += static_cast<uint32_t>(reader.varint());
+        const uint64_t modifierCount = reader.varint();
+        if (!reader.ok() || modifierCount > size)
+            return false;
+        const uint32_t firstModifier = formats->modifiers.size();
+        formats->formats.push_back(DmaBufFormat{ fourcc, firstModifier, uint32_t(modifierCount) });
+        uint64_t modifier = 0;
+        for (uint64_t i = 0; i < modifierCount; ++i) {
+            modifier += reader.varint();
+            formats->modifiers.push_back(DmaBufModifier{ modifier, false });
+        }
+        externalOnly.resize(modifierCount);
+        if (!reader.packed(modifierCount, 1, 0, externalOnly.data()))
+            return false;
+        for (uint64_t i = 0; i < modifierCount; ++i)
+            formats->modifiers[firstModifier + i].externalOnly = externalOnly[i] != 0;
+    }
+    return reader.ok();
+}
+
+static void encodeTopology(Writer& writer, const DeviceTopology& topology)
+{
+    writer.varint(topology.state);
+    if (topology.state != DeviceTopology::Ok)
+        return;
+    writer.signedVarint(topology.numaNode);
+    for (const std::string *str : { &topology.pciAddress, &topology.localCpus, &topology.renderNode }) {
+        writer.varint(str->size());
+        writer.bytes(str->data(), str->size());
+    }
+}
+
+static bool decodeTopology(Reader& reader, DeviceTopology* topology)
+{
+    const uint64_t state = reader.varint();
+    if (!reader.ok() || state > DeviceTopology::Ok)
+        return false;
+    topology->state = static_cast<DeviceTopology::State>(state);
+    if (topology->state != DeviceTopology::Ok)
+        return true;
+    topology->numaNode = static_cast<int>(reader.signedVarint());
+    for (std::string *str : { &topology->pciAddress, &topology->localCpus, &topology->renderNode }) {
+        const uint64_t length = reader.varint();
+        const char *data = reader.bytes(length);
+        if (!data)
+            return false;
+        str->assign(data, length);
+    }
+    return reader.ok();
+}
+
+static void encodeMemoryDelta(Writer& writer, const MemoryDelta& delta)
+{
+    writer.signedVarint(delta.rss);
+    writer.signedVarint(delta.pss);
+    writer.signedVarint(delta.anonymous);
+    writer.signedVarint(delta.mappedFiles);
+}
+
+static void encodeMemoryCost(Writer& writer, const MemoryCost& cost)
+{
+    writer.varint(cost.state);
+    if (cost.state != MemoryCost::Ok)
+        return;
+    encodeMemoryDelta(writer, cost.initialize);
+    encodeMemoryDelta(writer, cost.configs);
+    writer.varint(cost.initializeObjects.size());
+    for (const MappedObject &object : cost.initializeObjects) {
+        writer.varint(object.path.size());
+        writer.bytes(object.path.data(), object.path.size());
+        writer.varint(object.bytes);
+    }
+}
+
+static void decodeMemoryDelta(Reader& reader, MemoryDelta* delta)
+{
+    delta->rss = reader.signedVarint();
+    delta->pss = reader.signedVarint();
+    delta->anonymous = reader.signedVarint();
+    delta->mappedFiles = reader.signedVarint();
+}
+
+static bool decodeMemoryCost(Reader& reader, size_t size, MemoryCost* cost)
+{
+    const uint64_t state = reader.varint();
+    if (!reader.ok() || state > MemoryCost::Ok)
+        return false;
+    cost->state = static_cast<MemoryCost::State>(state);
+    if (cost->state != MemoryCost::Ok)
+        return true;
+    decodeMemoryDelta(reader, &cost->initialize);
+    decodeMemoryDelta(reader, &cost->configs);
+    const uint64_t count = reader.varint();
+    if (!reader.ok() || count > size)
+        return false;
+    cost->initializeObjects.resize(count);
+    for (MappedObject &object : cost->initializeObjects) {
+        const uint64_t length = reader.varint();
+        const char *data = reader.bytes(length);
+        if (!data)
+            return false;
+        object.path.assign(data, length);
+        object.bytes = reader.varint();
+    }
+    return reader.ok();
+}
+
+void encodeHost(const HostRecord& host, std::string* out)
+{
+    Writer writer(out);
+    writer.bytes(EncodingMagic, sizeof(EncodingMagic));
+    writer.varint(EncodingVersion);
+
+    writer.varint(attributesSize);
+    for (int i = 0; i < attributesSize; ++i)
+        writer.signedVarint(attributes[i].attribute);
+
+    // each distinct string once, displays refer to it by hash
+    std::vector<const std::string*> strings;
+    std::unordered_map<uint64_t, const std::string*> stringHashes;
+    auto addString = [&](const std::string& str) {
+        const uint64_t hash = hash64(str.data(), str.size());
+        if (stringHashes.insert(std::make_pair(hash, &str)).second)
+            strings.push_back(&str);
+        return hash;
+    };
+    std::vector<uint64_t> displayHashes;
+    for (const HostDisplay &display : host.displays) {
+        displayHashes.push_back(addString(display.vendor));
+        displayHashes.push_back(addString(display.extensions));
+    }
+
+    writer.varint(strings.size());
+    for (const std::string *str : strings) {
+        writer.u64(hash64(str->data(), str->size()));
+        writer.varint(str->size());
+        writer.bytes(str->data(), str->size());
+    }
+
+    writer.varint(host.displays.size());
+    for (size_t d = 0; d < host.displays.size(); ++d) {
+        const HostDisplay &display = host.displays[d];
+        writer.u64(displayHashes[2 * d]);
+        writer.u64(displayHashes[2 * d + 1]);
+        writer.varint(display.initializeTime);
+        encodeDmaBufFormats(writer, display.dmaBufFormats);
+        encodeTopology(writer, display.topology);
+        encodeMemoryCost(writer, display.memoryCost);
+        writer.varint(display.configs.size());
+        if (display.configs.empty())
+            continue;
+        for (int i = 0; i < attributesSize; ++i)
+            encodeColumn(writer, display.configs, i);
+    }
+}
+
+bool isEncodedHost(const char* data, size_t size)
+{
+    return size >= sizeof(EncodingMagic) && memcmp(data, EncodingMagic, sizeof(EncodingMagic)) == 0;
+}
+
+static bool decodeColumn(Reader& reader, int column, std::vector<ConfigInfo>* configs, std::vector<int64_t>* values)
+{
+    const size_t count = configs->size();
+    const uint8_t validity = reader.byte();
+    if (validity == NoneValid)
+        return reader.ok();
+
+    const char *bitmap = nullptr;
+    if (validity == ValidBitmap)
+        bitmap = reader.bytes((count + 7) / 8);
+    else if (validity != AllValid)
+        return false;
+    if (!reader.ok())
+        return false;
+
+    size_t validCount = count;
+    if (bitmap) {
+        validCount = 0;
+        for (size_t i = 0; i < count; ++i)
+            validCount += (bitmap[i / 8] >> (i % 8)) & 1;
+    }
+
+    const uint8_t mode = reader.byte();
+    const int64_t minimum = reader.signedVarint();
+    const int bits = reader.byte();
+    if (!reader.ok() || bits > 64 || (mode != FrameOfReference && mode != Delta))
+        return false;
+    values->resize(validCount);
+    if (!reader.packed(validCount, bits, minimum, values->data()))
+        return false;
+    if (mode == Delta) {
+        for (size_t i = 1; i < validCount; ++i)
+            (*values)[i] += (*values)[i - 1];
+    }
+    if (column < 0)
+        return true;
+
+    const uint32_t bit = 1u << column;
+    size_t v = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (bitmap && !((bitmap[i / 8] >> (i % 8)) & 1))
+            continue;
+        ConfigInfo &config = (*configs)[i];
+        config.values[column] = static_cast<EGLint>((*values)[v++]);
+        config.validMask |= bit;
+    }
+    return true;
+}
+
+bool decodeHost(const char* data, size_t size, HostRecord* host, std::string* errorMessage)
+{
+    Reader reader(data, size);
+    if (isEncodedHost(data, size))
+        reader.bytes(sizeof(EncodingMagic));
+    const uint64_t version = isEncodedHost(data, size) ? reader.varint() : 0;
+    if (version != EncodingVersion) {
+        *errorMessage = "unsupported encoding";
+        return false;
+    }
+
+    // encoded column -> our attribute index
+    const uint64_t columnCount = reader.varint();
+    if (!reader.ok() || columnCount > 1024) {
+        *errorMessage = "corrupt encoding";
+        return false;
+    }
+    std::vector<int> columns(columnCount);
+    for (int &column : columns)
+        column = attributeIndex(static_cast<EGLint>(reader.signedVarint()));
+
+    std::unordered_map<uint64_t, std::string> strings;
+    const uint64_t stringCount = reader.varint();
+    for (uint64_t i = 0; i < stringCount && reader.ok(); ++i) {
+        const uint64_t hash = reader.u64();
+        const uint64_t length = reader.varint();
+        const char *str = reader.bytes(length);
+        if (str)
+            strings[hash].assign(str, length);
+    }
+
+    const uint64_t displayCount = reader.varint();
+    host->displays.clear();
+    std::vector<int64_t> values;
+    for (uint64_t d = 0; d < displayCount && reader.ok(); ++d) {
+        HostDisplay display;
+        display.vendor = strings[reader.u64()];
+        display.extensions = strings[reader.u64()];
+        display.initializeTime = reader.varint();
+        if (!decodeDmaBufFormats(reader, size, &display.dmaBufFormats) || !decodeTopology(reader, &display.topology)
+            || !decodeMemoryCost(reader, size, &display.memoryCost)) {
+            *errorMessage = "corrupt encoding";
+            return false;
+        }
+        const uint64_t configCount = reader.varint();
+        if (!reader.ok() || configCount > size * 8) {
+            *errorMessage = "corrupt encoding";
+            return false;
+        }
+        display.configs.resize(configCount);
+        for (ConfigInfo &config : display.configs) {
+            config.config = nullptr;
+            config.validMask = 0;
+            config.hasFingerprint = false;
+            memset(config.values, 0, sizeof(config.values));
+        }
+        for (size_t c = 0; configCount && c < columns.size(); ++c) {
+            if (!decodeColumn(reader, columns[c], &display.configs, &values)) {
+                *errorMessage = "corrupt encoding";
+                return false;
+            }
+        }
+        host->displays.push_back(std::move(display));
+    }
+
+    if (!reader.ok()) {
+        *errorMessage = "truncated encoding";
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_ENCODING_H
+#define EGLINFO_ENCODING_H
+
+#include "hostrecord.h"
+
+#include <string>
+
+namespace EglInfo {
+
+/*
+ * Compact encoding of a HostRecord, used by eglinfo --save and understood by loadHost().
+ *
+ * Strings (vendor and extension lists) are stored once per file and referenced by their
+ * 64 bit content hash. Configs are stored per display in columns, one per attribute: each
+ * column is frame-of-reference encoded, i.e. as the minimum value followed by the
+ * differences to it bit-packed to the width needed for the column's value range. Columns
+ * with a single value thus take no space beyond their header. EGL_CONFIG_ID is delta
+ * encoded before that, as it usually increments by one from config to config.
+ * Config fingerprints are not stored, ConfigInfo::fingerprint() computes them on demand.
+ * Each display also stores its eglInitialize() time, its DMA-BUF formats and modifiers, which
+ * are delta encoded in their sorted order with the external-only flags packed into a bitmap,
+ * the sysfs topology of its device and its memory cost.
+ */
+
+/** Appends the encoding of @p host (without its name) to @p out. */
+void encodeHost(const HostRecord& host, std::string* out);
+
+/** Returns true if @p data starts with the encoding's magic number. */
+bool isEncodedHost(const char* data, size_t size);
+
+/** Decodes @p data into @p host, keeping host->name. */
+bool decodeHost(const char* data, size_t size, HostRecord* host, std::string* errorMessage);
+
+}
+
+#endif
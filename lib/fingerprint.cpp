@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "fingerprint.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace EglInfo {
+
+static bool isIdentifying(EGLint attribute)
+{
+    switch (attribute) {
+        case EGL_CONFIG_ID:
+        case EGL_NATIVE_VISUAL_ID:
+        case EGL_NATIVE_VISUAL_TYPE:
+        case EGL_MAX_PBUFFER_WIDTH:
+        case EGL_MAX_PBUFFER_HEIGHT:
+        case EGL_MAX_PBUFFER_PIXELS:
+            return false;
+    }
+    return true;
+}
+
+namespace {
+
+/** Indexes into attributes of the fingerprinted attributes, sorted by EGL enum value. */
+struct CanonicalOrder {
+    CanonicalOrder()
+        : size(0)
+    {
+        for (int i = 0; i < attributesSize; ++i) {
+            if (isIdentifying(attributes[i].attribute))
+                indexes[size++] = i;
+        }
+        std::sort(indexes, indexes + size, [](int a, int b) {
+            return attributes[a].attribute < attributes[b].attribute;
+        });
+    }
+
+    int indexes[AttributeCount];
+    int size;
+};
+
+}
+
+uint64_t configFingerprint(const ConfigInfo& config)
+{
+    static const CanonicalOrder order;
+
+    uint64_t hash = hash64(nullptr, 0);
+    for (int i = 0; i < order.size; ++i) {
+        const int index = order.indexes[i];
+        if (!config.isValid(index))
+            continue;
+        const int32_t pair[2] = { attributes[index].attribute, config.values[index] };
+        hash = hash64(pair, sizeof(pair), hash);
+    }
+
+    // FNV-1a mixes the last bytes poorly, finish with the splitmix64 finalizer
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+bool parseFingerprint(const char* text, size_t length, uint64_t* fingerprint)
+{
+    if (length > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        text += 2;
+        length -= 2;
+    }
+    if (length == 0 || length > 16)
+        return false;
+
+    char buffer[17];
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    char *end = nullptr;
+    *fingerprint = strtoull(buffer, &end, 16);
+    return *end == '\0';
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_FINGERPRINT_H
+#define EGLINFO_FINGERPRINT_H
+
+#include "probe.h"
+
+namespace EglInfo {
+
+/**
+ * Canonical 64 bit identity of a config, computed from its attribute values.
+ *
+ * Driver assigned IDs (EGL_CONFIG_ID, native visual) and device limits (max pbuffer size)
+ * are left out and the remaining attributes are hashed in order of their EGL enum value,
+ * so equivalent configs get the same fingerprint on every driver, device and host.
+ */
+uint64_t configFingerprint(const ConfigInfo& config);
+
+/** Parses a fingerprint as printed by eglinfo, i.e. 16 hex digits with optional 0x prefix. */
+bool parseFingerprint(const char* text, size_t length, uint64_t* fingerprint);
+
+}
+
+#endif
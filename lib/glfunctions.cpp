@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "glfunctions.h"
+
+#include <EGL/egl.h>
+
+namespace EglInfo {
+namespace GL {
+
+template <typename T>
+static void resolve(T* function, const char* name)
+{
+    *function = reinterpret_cast<T>(eglGetProcAddress(name));
+}
+
+static Functions resolveFunctions()
+{
+    Functions f;
+    resolve(&f.GetError, "glGetError");
+    resolve(&f.GetIntegerv, "glGetIntegerv");
+    resolve(&f.GetString, "glGetString");
+    resolve(&f.GetStringi, "glGetStringi");
+    return f;
+}
+
+const Functions& functions()
+{
+    static const Functions f = resolveFunctions();
+    return f;
+}
+
+bool ShaderFunctions::isValid() const
+{
+    return CreateShader && ShaderSource && CompileShader && GetShaderiv && GetShaderInfoLog && DeleteShader
+        && CreateProgram && AttachShader && LinkProgram && GetProgramiv && GetProgramInfoLog && DeleteProgram;
+}
+
+static ShaderFunctions resolveShaderFunctions()
+{
+    ShaderFunctions f;
+    resolve(&f.CreateShader, "glCreateShader");
+    resolve(&f.ShaderSource, "glShaderSource");
+    resolve(&f.CompileShader, "glCompileShader");
+    resolve(&f.GetShaderiv, "glGetShaderiv");
+    resolve(&f.GetShaderInfoLog, "glGetShaderInfoLog");
+    resolve(&f.DeleteShader, "glDeleteShader");
+    resolve(&f.CreateProgram, "glCreateProgram");
+    resolve(&f.AttachShader, "glAttachShader");
+    resolve(&f.LinkProgram, "glLinkProgram");
+    resolve(&f.GetProgramiv, "glGetProgramiv");
+    resolve(&f.GetProgramInfoLog, "glGetProgramInfoLog");
+    resolve(&f.DeleteProgram, "glDeleteProgram");
+    return f;
+}
+
+const ShaderFunctions& shaderFunctions()
+{
+    static const ShaderFunctions f = resolveShaderFunctions();
+    return f;
+}
+
+bool TransferFunctions::isValid() const
+{
+    return GenTextures && DeleteTextures && BindTexture && TexParameteri && TexImage2D && TexSubImage2D && PixelStorei
+        && GenFramebuffers && DeleteFramebuffers && BindFramebuffer && FramebufferTexture2D && CheckFramebufferStatus
+        && ReadPixels && Finish;
+}
+
+static TransferFunctions resolveTransferFunctions()
+{
+    TransferFunctions f;
+    resolve(&f.GenTextures, "glGenTextures");
+    resolve(&f.DeleteTextures, "glDeleteTextures");
+    resolve(&f.BindTexture, "glBindTexture");
+    resolve(&f.TexParameteri, "glTexParameteri");
+    resolve(&f.TexImage2D, "glTexImage2D");
+    resolve(&f.TexSubImage2D, "glTexSubImage2D");
+    resolve(&f.PixelStorei, "glPixelStorei");
+    resolve(&f.GenFramebuffers, "glGenFramebuffers");
+    resolve(&f.DeleteFramebuffers, "glDeleteFramebuffers");
+    resolve(&f.BindFramebuffer, "glBindFramebuffer");
+    resolve(&f.FramebufferTexture2D, "glFramebufferTexture2D");
+    resolve(&f.CheckFramebufferStatus, "glCheckFramebufferStatus");
+    resolve(&f.ReadPixels, "glReadPixels");
+    resolve(&f.Finish, "glFinish");
+    resolve(&f.GenBuffers, "glGenBuffers");
+    resolve(&f.DeleteBuffers, "glDeleteBuffers");
+    resolve(&f.BindBuffer, "glBindBuffer");
+    resolve(&f.BufferData, "glBufferData");
+    resolve(&f.MapBufferRange, "glMapBufferRange");
+    resolve(&f.UnmapBuffer, "glUnmapBuffer");
+    return f;
+}
+
+const TransferFunctions& transferFunctions()
+{
+    static const TransferFunctions f = resolveTransferFunctions();
+    return f;
+}
+
+}
+}
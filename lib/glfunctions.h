@@ -0,0 +1,157 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_GLFUNCTIONS_H
+#define EGLINFO_GLFUNCTIONS_H
+
+#include <KHR/khrplatform.h>
+
+namespace EglInfo {
+
+/**
+ * The few GL/GLES types, enums and entry points eglinfo uses, so it neither needs GL headers nor
+ * links against a GL library. All functions are resolved through eglGetProcAddress().
+ */
+namespace GL {
+
+typedef unsigned int Enum;
+typedef int Int;
+typedef unsigned int Uint;
+typedef unsigned char Ubyte;
+typedef int Sizei;
+typedef char Char;
+typedef unsigned int Bitfield;
+typedef unsigned char Boolean;
+typedef khronos_intptr_t Intptr;
+typedef khronos_ssize_t Sizeiptr;
+
+enum : Enum {
+    NO_ERROR = 0,
+    BGRA = 0x80E1,
+    COLOR_ATTACHMENT0 = 0x8CE0,
+    COMPILE_STATUS = 0x8B81,
+    EXTENSIONS = 0x1F03,
+    FRAGMENT_SHADER = 0x8B30,
+    FRAMEBUFFER = 0x8D40,
+    FRAMEBUFFER_COMPLETE = 0x8CD5,
+    IMPLEMENTATION_COLOR_READ_FORMAT = 0x8B9B,
+    IMPLEMENTATION_COLOR_READ_TYPE = 0x8B9A,
+    INFO_LOG_LENGTH = 0x8B84,
+    LINK_STATUS = 0x8B82,
+    LUMINANCE = 0x1909,
+    MAP_READ_BIT = 0x0001,
+    MAX_TEXTURE_SIZE = 0x0D33,
+    MAX_VIEWPORT_DIMS = 0x0D3A,
+    MAX_RENDERBUFFER_SIZE = 0x84E8,
+    MAX_SAMPLES = 0x8D57,
+    NEAREST = 0x2600,
+    NUM_EXTENSIONS = 0x821D,
+    PACK_ALIGNMENT = 0x0D05,
+    PIXEL_PACK_BUFFER = 0x88EB,
+    RENDERER = 0x1F01,
+    RGB = 0x1907,
+    RGBA = 0x1908,
+    SHADING_LANGUAGE_VERSION = 0x8B8C,
+    STREAM_READ = 0x88E1,
+    TEXTURE_2D = 0x0DE1,
+    TEXTURE_MIN_FILTER = 0x2801,
+    UNPACK_ALIGNMENT = 0x0CF5,
+    UNSIGNED_BYTE = 0x1401,
+    UNSIGNED_SHORT_5_6_5 = 0x8363,
+    VENDOR = 0x1F00,
+    VERSION = 0x1F02,
+    VERTEX_SHADER = 0x8B31
+};
+
+struct Functions {
+    Enum (KHRONOS_APIENTRY *GetError)();
+    void (KHRONOS_APIENTRY *GetIntegerv)(Enum name, Int* data);
+    const Ubyte* (KHRONOS_APIENTRY *GetString)(Enum name);
+    /** nullptr before GL 3.0 / GLES 3.0. */
+    const Ubyte* (KHRONOS_APIENTRY *GetStringi)(Enum name, Uint index);
+
+    /** Returns true if all mandatory functions could be resolved. */
+    bool isValid() const { return GetError && GetIntegerv && GetString; }
+};
+
+/**
+ * Returns the GL entry points, resolved on first use. The addresses are the same for every
+ * context and client API (EGL_KHR_get_all_proc_addresses), but calling them requires a current
+ * context.
+ */
+const Functions& functions();
+
+/** Shader and program entry points of GLES 2.0 and GL 2.0. */
+struct ShaderFunctions {
+    Uint (KHRONOS_APIENTRY *CreateShader)(Enum type);
+    void (KHRONOS_APIENTRY *ShaderSource)(Uint shader, Sizei count, const Char* const* strings, const Int* lengths);
+    void (KHRONOS_APIENTRY *CompileShader)(Uint shader);
+    void (KHRONOS_APIENTRY *GetShaderiv)(Uint shader, Enum name, Int* value);
+    void (KHRONOS_APIENTRY *GetShaderInfoLog)(Uint shader, Sizei size, Sizei* length, Char* log);
+    void (KHRONOS_APIENTRY *DeleteShader)(Uint shader);
+    Uint (KHRONOS_APIENTRY *CreateProgram)();
+    void (KHRONOS_APIENTRY *AttachShader)(Uint program, Uint shader);
+    void (KHRONOS_APIENTRY *LinkProgram)(Uint program);
+    void (KHRONOS_APIENTRY *GetProgramiv)(Uint program, Enum name, Int* value);
+    void (KHRONOS_APIENTRY *GetProgramInfoLog)(Uint program, Sizei size, Sizei* length, Char* log);
+    void (KHRONOS_APIENTRY *DeleteProgram)(Uint program);
+
+    bool isValid() const;
+};
+
+/** Returns the shader entry points, resolved on first use, see functions(). */
+const ShaderFunctions& shaderFunctions();
+
+/** Texture, framebuffer object and pixel transfer entry points of GLES 2.0 and GL 3.0. */
+struct TransferFunctions {
+    void (KHRONOS_APIENTRY *GenTextures)(Sizei count, Uint* textures);
+    void (KHRONOS_APIENTRY *DeleteTextures)(Sizei count, const Uint* textures);
+    void (KHRONOS_APIENTRY *BindTexture)(Enum target, Uint texture);
+    void (KHRONOS_APIENTRY *TexParameteri)(Enum target, Enum name, Int value);
+    void (KHRONOS_APIENTRY *TexImage2D)(Enum target, Int level, Int internalFormat, Sizei width, Sizei height, Int border,
+                                        Enum format, Enum type, const void* pixels);
+    void (KHRONOS_APIENTRY *TexSubImage2D)(Enum target, Int level, Int x, Int y, Sizei width, Sizei height,
+                                           Enum format, Enum type, const void* pixels);
+    void (KHRONOS_APIENTRY *PixelStorei)(Enum name, Int value);
+    void (KHRONOS_APIENTRY *GenFramebuffers)(Sizei count, Uint* framebuffers);
+    void (KHRONOS_APIENTRY *DeleteFramebuffers)(Sizei count, const Uint* framebuffers);
+    void (KHRONOS_APIENTRY *BindFramebuffer)(Enum target, Uint framebuffer);
+    void (KHRONOS_APIENTRY *FramebufferTexture2D)(Enum target, Enum attachment, Enum textureTarget, Uint texture, Int level);
+    Enum (KHRONOS_APIENTRY *CheckFramebufferStatus)(Enum target);
+    void (KHRONOS_APIENTRY *ReadPixels)(Int x, Int y, Sizei width, Sizei height, Enum format, Enum type, void* pixels);
+    void (KHRONOS_APIENTRY *Finish)();
+
+    /** Pixel buffer object entry points, nullptr before GL 3.0 / GLES 3.0. */
+    void (KHRONOS_APIENTRY *GenBuffers)(Sizei count, Uint* buffers);
+    void (KHRONOS_APIENTRY *DeleteBuffers)(Sizei count, const Uint* buffers);
+    void (KHRONOS_APIENTRY *BindBuffer)(Enum target, Uint buffer);
+    void (KHRONOS_APIENTRY *BufferData)(Enum target, Sizeiptr size, const void* data, Enum usage);
+    void* (KHRONOS_APIENTRY *MapBufferRange)(Enum target, Intptr offset, Sizeiptr length, Bitfield access);
+    Boolean (KHRONOS_APIENTRY *UnmapBuffer)(Enum target);
+
+    bool isValid() const;
+    bool hasPixelBuffers() const { return GenBuffers && DeleteBuffers && BindBuffer && BufferData && MapBufferRange && UnmapBuffer; }
+};
+
+/** Returns the pixel transfer entry points, resolved on first use, see functions(). */
+const TransferFunctions& transferFunctions();
+
+}
+
+}
+
+#endif
@@ -0,0 +1,261 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "hostrecord.h"
+#include "encoding.h"
+#include "snapshot.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace EglInfo {
+
+static void addDisplay(const DisplayInfo& info, const DeviceTopology& topology, HostRecord* host)
+{
+    HostDisplay display;
+    display.vendor = info.vendor ? info.vendor : "";
+    display.extensions = info.extensions ? info.extensions : "";
+    display.configs = info.configs;
+    display.initializeTime = info.initializeTime;
+    display.memoryCost = info.memoryCost;
+    display.dmaBufFormats = info.dmaBufFormats;
+    display.topology = topology;
+    for (ConfigInfo &config : display.configs)
+        config.config = nullptr;
+    host->displays.push_back(std::move(display));
+}
+
+void toHostRecord(const ProbeResult& result, HostRecord* host)
+{
+    host->displays.clear();
+#ifdef EGL_EXT_device_base
+    for (const DeviceInfo &device : result.devices.devices) {
+        if (device.hasDisplay)
+            addDisplay(device.display, device.topology, host);
+    }
+#endif
+    if (result.hasDefaultDisplay)
+        addDisplay(result.defaultDisplay, DeviceTopology(), host);
+}
+
+static bool startsWith(const char* line, const char* end, const char* prefix)
+{
+    const size_t length = strlen(prefix);
+    return size_t(end - line) >= length && memcmp(line, prefix, length) == 0;
+}
+
+static bool loadText(const std::string& data, HostRecord* host, std::string* errorMessage)
+{
+    HostDisplay *display = nullptr;
+    ConfigInfo *config = nullptr;
+    // printed with the device, before its display
+    DeviceTopology topology;
+    int lineNumber = 0;
+    int nextAttribute = 0;
+    for (const char *next = data.c_str(), *dataEnd = data.c_str() + data.size(); next < dataEnd;) {
+        const char *line = next;
+        const char *end = static_cast<const char*>(memchr(line, '\n', dataEnd - line));
+        if (!end)
+            end = dataEnd;
+        next = end + 1;
+        ++lineNumber;
+
+        while (line < end && *line == ' ')
+            ++line;
+        if (line == end)
+            continue;
+
+        if (startsWith(line, end, "PCI address: ")) {
+            topology.state = DeviceTopology::Ok;
+            topology.pciAddress.assign(line + 13, end);
+        } else if (startsWith(line, end, "NUMA node: ")) {
+            topology.state = DeviceTopology::Ok;
+            topology.numaNode = atoi(std::string(line + 11, end).c_str());
+        } else if (startsWith(line, end, "Local CPUs: ")) {
+            topology.state = DeviceTopology::Ok;
+            topology.localCpus.assign(line + 12, end);
+        } else if (startsWith(line, end, "Render node: ")) {
+            topology.state = DeviceTopology::Ok;
+            topology.renderNode.assign(line + 13, end);
+        } else if (startsWith(line, end, "No attached display.")) {
+            topology = DeviceTopology();
+        } else if (startsWith(line, end, "EGL version: ")) {
+            host->displays.push_back(HostDisplay());
+            display = &host->displays.back();
+            display->topology = topology;
+            topology = DeviceTopology();
+            config = nullptr;
+        } else if (!display) {
+            continue;
+        } else if (startsWith(line, end, "Vendor: ")) {
+            display->vendor.assign(line + 8, end);
+        } else if (startsWith(line, end, "Display extensions: ")) {
+            display->extensions.assign(line + 20, end);
+        } else if (startsWith(line, end, "Configuration ")) {
+            display->configs.push_back(ConfigInfo());
+            config = &display->configs.back();
+            config->config = nullptr;
+            config->validMask = 0;
+            config->hasFingerprint = false;
+            memset(config->values, 0, sizeof(config->values));
+            nextAttribute = 0;
+        } else if (config && startsWith(line, end, "EGL_")) {
+            const char *colon = static_cast<const char*>(memchr(line, ':', end - line));
+            if (!colon || colon + 1 >= end)
+                continue;
+            // eglinfo prints the attributes in table order, avoid the name lookup for that case
+            int index = nextAttribute;
+            if (index >= attributesSize || strncmp(attributes[index].displayName, line, colon - line) != 0
+                || attributes[index].displayName[colon - line] != '\0')
+                index = attributeIndex(line, colon - line);
+            if (index < 0)
+                continue;
+            nextAttribute = index + 1;
+            const char *value = colon + 2;
+            if (startsWith(value, end, "<failed>"))
+                continue;
+            if (!parseAttributeValue(&attributes[index], value, end - value, &config->values[index])) {
+                *errorMessage = "line " + std::to_string(lineNumber) + ": cannot parse \"" + std::string(line, end) + "\"";
+                return false;
+            }
+            config->validMask |= 1u << index;
+        }
+    }
+
+    return true;
+}
+
+static bool loadSnapshot(const std::string& data, HostRecord* host, std::string* errorMessage)
+{
+    if (data.size() < sizeof(SnapshotHeader)) {
+        *errorMessage = "truncated snapshot";
+        return false;
+    }
+    const SnapshotHeader *header = reinterpret_cast<const SnapshotHeader*>(data.data());
+    if (header->version != SnapshotVersion || header->sequence.load(std::memory_order_relaxed) & 1) {
+        *errorMessage = "unsupported or incomplete snapshot";
+        return false;
+    }
+    if (size_t(header->displaysOffset) + size_t(header->displayCount) * sizeof(SnapshotDisplay) > data.size()
+        || size_t(header->configsOffset) + size_t(header->configCount) * sizeof(SnapshotConfig) > data.size()
+        || size_t(header->dmaBufFormatsOffset) + size_t(header->dmaBufFormatCount) * sizeof(SnapshotDmaBufFormat) > data.size()
+        || size_t(header->dmaBufModifiersOffset) + size_t(header->dmaBufModifierCount) * sizeof(SnapshotDmaBufModifier) > data.size()) {
+        *errorMessage = "corrupt snapshot";
+        return false;
+    }
+
+    // snapshot column -> our attribute index
+    int columns[SnapshotMaxAttributes];
+    bool sameColumns = header->attributeCount == uint32_t(attributesSize);
+    for (int i = 0; i < SnapshotMaxAttributes; ++i) {
+        columns[i] = i < int(header->attributeCount) ? attributeIndex(header->attributes[i]) : -1;
+        sameColumns = sameColumns && (i >= attributesSize || columns[i] == i);
+    }
+
+    auto string = [&data](uint32_t offset) {
+        return offset && offset < data.size() ? std::string(data.c_str() + offset) : std::string();
+    };
+
+    const SnapshotDisplay *displays = reinterpret_cast<const SnapshotDisplay*>(data.data() + header->displaysOffset);
+    const SnapshotConfig *configs = reinterpret_cast<const SnapshotConfig*>(data.data() + header->configsOffset);
+    const SnapshotDmaBufFormat *formats = reinterpret_cast<const SnapshotDmaBufFormat*>(data.data() + header->dmaBufFormatsOffset);
+    const SnapshotDmaBufModifier *modifiers = reinterpret_cast<const SnapshotDmaBufModifier*>(data.data() + header->dmaBufModifiersOffset);
+    for (uint32_t i = 0; i < header->displayCount; ++i) {
+        const SnapshotDisplay &in = displays[i];
+        if (size_t(in.firstConfig) + in.configCount > header->configCount
+            || size_t(in.firstDmaBufFormat) + in.dmaBufFormatCount > header->dmaBufFormatCount) {
+            *errorMessage = "corrupt snapshot";
+            return false;
+        }
+        HostDisplay display;
+        display.vendor = string(in.vendor);
+        display.extensions = string(in.extensions);
+        display.configs.resize(in.configCount);
+        for (uint32_t j = 0; j < in.configCount; ++j) {
+            const SnapshotConfig &from = configs[in.firstConfig + j];
+            ConfigInfo &to = display.configs[j];
+            to.config = nullptr;
+            to.validMask = 0;
+            // stored for the fingerprint table, but computed over the writer's attribute table
+            to.cachedFingerprint = from.fingerprint;
+            to.hasFingerprint = sameColumns;
+            memset(to.values, 0, sizeof(to.values));
+            for (int c = 0; c < SnapshotMaxAttributes; ++c) {
+                if (columns[c] < 0 || !(from.validMask & (1u << c)))
+                    continue;
+                to.values[columns[c]] = from.values[c];
+                to.validMask |= 1u << columns[c];
+            }
+        }
+
+        display.dmaBufFormats.state = static_cast<DmaBufFormats::State>(in.dmaBufState);
+        for (uint32_t j = 0; j < in.dmaBufFormatCount; ++j) {
+            const SnapshotDmaBufFormat &from = formats[in.firstDmaBufFormat + j];
+            if (size_t(from.firstModifier) + from.modifierCount > header->dmaBufModifierCount) {
+                *errorMessage = "corrupt snapshot";
+                return false;
+            }
+            const uint32_t firstModifier = display.dmaBufFormats.modifiers.size();
+            display.dmaBufFormats.formats.push_back(DmaBufFormat{ from.fourcc, firstModifier, from.modifierCount });
+            for (uint32_t k = 0; k < from.modifierCount; ++k) {
+                const SnapshotDmaBufModifier &modifier = modifiers[from.firstModifier + k];
+                display.dmaBufFormats.modifiers.push_back(DmaBufModifier{ modifier.modifier, modifier.externalOnly != 0 });
+            }
+        }
+        display.topology.state = static_cast<DeviceTopology::State>(in.topologyState);
+        display.topology.numaNode = in.numaNode;
+        display.topology.pciAddress = string(in.pciAddress);
+        display.topology.localCpus = string(in.localCpus);
+        display.topology.renderNode = string(in.renderNode);
+        host->displays.push_back(std::move(display));
+    }
+    return true;
+}
+
+bool loadHost(const std::string& path, HostRecord* host, std::string* errorMessage)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        *errorMessage = "cannot open file";
+        return false;
+    }
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(&data[0], data.size())) {
+        *errorMessage = "cannot read file";
+        return false;
+    }
+
+    // host names contain dots themselves, only strip the suffixes results are usually saved with
+    host->name = path.substr(path.find_last_of('/') + 1);
+    for (const char *suffix : { ".txt", ".bin" }) {
+        const size_t length = strlen(suffix);
+        if (host->name.size() > length && host->name.compare(host->name.size() - length, length, suffix) == 0) {
+            host->name.resize(host->name.size() - length);
+            break;
+        }
+    }
+
+    if (data.size() >= sizeof(SnapshotMagic) && memcmp(data.data(), SnapshotMagic, sizeof(SnapshotMagic)) == 0)
+        return loadSnapshot(data, host, errorMessage);
+    if (isEncodedHost(data.data(), data.size()))
+        return decodeHost(data.data(), data.size(), host, errorMessage);
+    return loadText(data, host, errorMessage);
+}
+
+}
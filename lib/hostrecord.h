@@ -0,0 +1,62 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_HOSTRECORD_H
+#define EGLINFO_HOSTRECORD_H
+
+#include "probe.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+struct HostDisplay {
+    std::string vendor;
+    std::string extensions;
+    std::vector<ConfigInfo> configs;
+    /** See DisplayInfo::initializeTime, 0 if unknown. */
+    int64_t initializeTime = 0;
+    /** See DisplayInfo::memoryCost, NotMeasured if unknown. */
+    MemoryCost memoryCost;
+    DmaBufFormats dmaBufFormats;
+    /** Topology of the EGL device of the display, NotQueried for the default display. */
+    DeviceTopology topology;
+};
+
+/**
+ * The displays of one host with owned strings, as stored on disk. Unlike ProbeResult this
+ * does not refer to any EGL objects, so it can be loaded on machines without EGL.
+ */
+struct HostRecord {
+    std::string name;
+    std::vector<HostDisplay> displays;
+};
+
+/** Copies the displays probed in @p result, device displays first. */
+void toHostRecord(const ProbeResult& result, HostRecord* host);
+
+/**
+ * Reads @p path, which may contain eglinfo text output, a snapshot written by eglinfo --publish
+ * or an encoded snapshot written by eglinfo --save. The host is named after the file, without
+ * a .txt or .bin suffix.
+ */
+bool loadHost(const std::string& path, HostRecord* host, std::string* errorMessage);
+
+}
+
+#endif
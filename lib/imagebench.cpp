@@ -0,0 +1,360 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "imagebench.h"
+#include "glfunctions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace EglInfo {
+
+ImageBenchmark::ImageBenchmark()
+    : state(Ok)
+    , missing(nullptr)
+    , contextState(ContextInfo::Ok)
+    , error(EGL_SUCCESS)
+    , api(EGL_NONE)
+    , width(0)
+    , height(0)
+    , synchronization(Finish)
+    , framesMatched(0)
+    , framesChecked(0)
+{
+}
+
+// GL_OES_EGL_image, GLeglImageOES is a void pointer
+typedef void (KHRONOS_APIENTRY *EglImageTargetTexture2D)(GL::Enum target, void* image);
+
+namespace {
+
+/** What the producer and consumer threads send each other. */
+struct Message {
+    enum Kind {
+        Ready,
+        Import,
+        Frame,
+        Quit
+    } kind;
+    EGLImageKHR image;
+    EGLSyncKHR sync;
+    /** Ready: whether the consumer context is current; Import: import succeeded; Frame: texel was read. */
+    bool ok;
+    ContextInfo::State contextState;
+    int64_t nanoseconds;
+    GL::Ubyte texel;
+
+    explicit Message(Kind kind)
+        : kind(kind)
+        , image(EGL_NO_IMAGE_KHR)
+        , sync(EGL_NO_SYNC_KHR)
+        , ok(true)
+        , contextState(ContextInfo::Ok)
+        , nanoseconds(0)
+        , texel(0)
+    {
+    }
+};
+
+/** Hands one message at a time from one thread to another. */
+class Mailbox
+{
+public:
+    void post(const Message& message)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return !m_full; });
+        m_message = message;
+        m_full = true;
+        m_changed.notify_all();
+    }
+
+    Message take()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return m_full; });
+        m_full = false;
+        m_changed.notify_all();
+        return m_message;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_full = false;
+    Message m_message = Message(Message::Quit);
+};
+
+/** The EGL entry points both threads use, resolved once by the producer. */
+struct ImageFunctions {
+    PFNEGLCREATEIMAGEKHRPROC createImage;
+    PFNEGLDESTROYIMAGEKHRPROC destroyImage;
+    PFNEGLCREATESYNCKHRPROC createSync;
+    PFNEGLDESTROYSYNCKHRPROC destroySync;
+    PFNEGLCLIENTWAITSYNCKHRPROC clientWaitSync;
+    PFNEGLWAITSYNCKHRPROC waitSync;
+    EglImageTargetTexture2D imageTargetTexture2D;
+};
+
+}
+
+static int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/** Inserts a fence into the current context and flushes it, so another context can wait for it. */
+static EGLSyncKHR flushedFence(EGLDisplay display, const ImageFunctions& egl)
+{
+    EGLSyncKHR sync = egl.createSync(display, EGL_SYNC_FENCE_KHR, nullptr);
+    if (sync != EGL_NO_SYNC_KHR)
+        egl.clientWaitSync(display, sync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, 0);
+    return sync;
+}
+
+static void waitForFence(EGLDisplay display, const ImageFunctions& egl, ImageBenchmark::Synchronization synchronization, EGLSyncKHR sync)
+{
+    if (sync == EGL_NO_SYNC_KHR)
+        return;
+    if (synchronization == ImageBenchmark::ServerWait)
+        egl.waitSync(display, sync, 0);
+    else
+        egl.clientWaitSync(display, sync, 0, EGL_FOREVER_KHR);
+    egl.destroySync(display, sync);
+}
+
+static void consume(const DisplayInfo& info, EGLenum api, const ImageFunctions& egl, ImageBenchmark::Synchronization synchronization,
+                    Mailbox* inbox, Mailbox* outbox)
+{
+    ScopedContext context(info, api);
+    Message ready(Message::Ready);
+    ready.ok = context.isCurrent();
+    ready.contextState = context.state();
+    outbox->post(ready);
+    if (!ready.ok)
+        return;
+
+    const GL::Functions &functions = GL::functions();
+    const GL::TransferFunctions &gl = GL::transferFunctions();
+    GL::Uint texture = 0;
+    GL::Uint framebuffer = 0;
+    gl.GenFramebuffers(1, &framebuffer);
+    bool readable = false;
+    for (;;) {
+        const Message message = inbox->take();
+        if (message.kind == Message::Quit)
+            break;
+
+        Message reply(message.kind);
+        if (message.kind == Message::Import) {
+            if (texture)
+                gl.DeleteTextures(1, &texture);
+            while (functions.GetError() != GL::NO_ERROR) {
+            }
+            const auto start = std::chrono::steady_clock::now();
+            gl.GenTextures(1, &texture);
+            gl.BindTexture(GL::TEXTURE_2D, texture);
+            egl.imageTargetTexture2D(GL::TEXTURE_2D, message.image);
+            reply.nanoseconds = elapsed(start);
+            reply.ok = functions.GetError() == GL::NO_ERROR;
+
+            // frames read the shared texel back through the imported texture
+            gl.TexParameteri(GL::TEXTURE_2D, GL::TEXTURE_MIN_FILTER, GL::NEAREST);
+            gl.BindFramebuffer(GL::FRAMEBUFFER, framebuffer);
+            gl.FramebufferTexture2D(GL::FRAMEBUFFER, GL::COLOR_ATTACHMENT0, GL::TEXTURE_2D, texture, 0);
+            readable = reply.ok && gl.CheckFramebufferStatus(GL::FRAMEBUFFER) == GL::FRAMEBUFFER_COMPLETE;
+        } else {
+            waitForFence(info.display, egl, synchronization, message.sync);
+            GL::Ubyte texel[4] = { 0, 0, 0, 0 };
+            if (readable)
+                gl.ReadPixels(0, 0, 1, 1, GL::RGBA, GL::UNSIGNED_BYTE, texel);
+            reply.ok = readable;
+            reply.texel = texel[0];
+            if (synchronization != ImageBenchmark::Finish)
+                reply.sync = flushedFence(info.display, egl);
+        }
+        outbox->post(reply);
+    }
+
+    gl.BindFramebuffer(GL::FRAMEBUFFER, 0);
+    gl.DeleteFramebuffers(1, &framebuffer);
+    if (texture)
+        gl.DeleteTextures(1, &texture);
+}
+
+bool benchmarkImages(const DisplayInfo& info, int iterations, ImageBenchmark* result)
+{
+    *result = ImageBenchmark();
+    for (const char *extension : { "EGL_KHR_image_base", "EGL_KHR_gl_texture_2D_image" }) {
+        if (!hasExtension(info.extensions, extension)) {
+            result->state = ImageBenchmark::Unsupported;
+            result->missing = extension;
+            return false;
+        }
+    }
+
+    ImageFunctions egl;
+    egl.createImage = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(eglGetProcAddress("eglCreateImageKHR"));
+    egl.destroyImage = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(eglGetProcAddress("eglDestroyImageKHR"));
+    egl.createSync = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+    egl.destroySync = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+    egl.clientWaitSync = reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+    egl.waitSync = reinterpret_cast<PFNEGLWAITSYNCKHRPROC>(eglGetProcAddress("eglWaitSyncKHR"));
+    egl.imageTargetTexture2D = reinterpret_cast<EglImageTargetTexture2D>(eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+    if (!egl.createImage || !egl.destroyImage || !egl.imageTargetTexture2D) {
+        result->state = ImageBenchmark::Unresolved;
+        return false;
+    }
+    if (egl.createSync && egl.destroySync && egl.clientWaitSync && hasExtension(info.extensions, "EGL_KHR_fence_sync"))
+        result->synchronization = egl.waitSync && hasExtension(info.extensions, "EGL_KHR_wait_sync") ? ImageBenchmark::ServerWait : ImageBenchmark::ClientWait;
+
+    result->api = preferredApi(info);
+    ScopedContext producer(info, result->api);
+    if (!producer.isCurrent()) {
+        result->state = ImageBenchmark::ContextFailed;
+        result->contextState = producer.state();
+        return false;
+    }
+    const GL::Functions &functions = GL::functions();
+    const GL::TransferFunctions &gl = GL::transferFunctions();
+    if (!functions.isValid() || !gl.isValid()) {
+        result->state = ImageBenchmark::Unresolved;
+        return false;
+    }
+    if (!hasExtension(glExtensions().c_str(), "GL_OES_EGL_image")) {
+        result->state = ImageBenchmark::Unsupported;
+        result->missing = "GL_OES_EGL_image";
+        return false;
+    }
+
+    // a video frame, the size decoders typically share
+    GL::Int maxTextureSize = 0;
+    functions.GetIntegerv(GL::MAX_TEXTURE_SIZE, &maxTextureSize);
+    result->width = std::min<int>(1920, maxTextureSize);
+    result->height = std::min<int>(1080, maxTextureSize);
+
+    Mailbox toConsumer;
+    Mailbox toProducer;
+    std::thread consumer(consume, std::cref(info), result->api, std::cref(egl), result->synchronization, &toConsumer, &toProducer);
+    const Message ready = toProducer.take();
+    if (!ready.ok) {
+        consumer.join();
+        result->state = ImageBenchmark::ContextFailed;
+        result->contextState = ready.contextState;
+        return false;
+    }
+
+    const EGLDisplay display = info.display;
+    const EGLint imageAttribs[] = { EGL_GL_TEXTURE_LEVEL_KHR, 0, EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE };
+    auto newTexture = [&]() {
+        GL::Uint texture = 0;
+        gl.GenTextures(1, &texture);
+        gl.BindTexture(GL::TEXTURE_2D, texture);
+        // complete without mipmaps, EGL_KHR_gl_texture_2D_image rejects incomplete textures
+        gl.TexParameteri(GL::TEXTURE_2D, GL::TEXTURE_MIN_FILTER, GL::NEAREST);
+        gl.TexImage2D(GL::TEXTURE_2D, 0, GL::RGBA, result->width, result->height, 0, GL::RGBA, GL::UNSIGNED_BYTE, nullptr);
+        gl.Finish();
+        return texture;
+    };
+    auto createImage = [&](GL::Uint texture) {
+        const EGLClientBuffer buffer = reinterpret_cast<EGLClientBuffer>(static_cast<uintptr_t>(texture));
+        const EGLImageKHR image = egl.createImage(display, producer.context(), EGL_GL_TEXTURE_2D_KHR, buffer, imageAttribs);
+        if (image == EGL_NO_IMAGE_KHR) {
+            result->state = ImageBenchmark::CreateFailed;
+            result->error = eglGetError();
+        }
+        return image;
+    };
+    auto import = [&](EGLImageKHR image) {
+        Message message(Message::Import);
+        message.image = image;
+        toConsumer.post(message);
+        const Message reply = toProducer.take();
+        if (!reply.ok)
+            result->state = ImageBenchmark::ImportFailed;
+        return reply;
+    };
+
+    // image life cycle, the first iteration warms up both contexts and is not recorded
+    result->create.reserve(iterations);
+    result->import.reserve(iterations);
+    result->destroy.reserve(iterations);
+    for (int i = 0; i <= iterations && result->state == ImageBenchmark::Ok; ++i) {
+        GL::Uint texture = newTexture();
+        auto start = std::chrono::steady_clock::now();
+        const EGLImageKHR image = createImage(texture);
+        const int64_t created = elapsed(start);
+        if (image != EGL_NO_IMAGE_KHR) {
+            const Message imported = import(image);
+            start = std::chrono::steady_clock::now();
+            egl.destroyImage(display, image);
+            const int64_t destroyed = elapsed(start);
+            if (i > 0 && imported.ok) {
+                result->create.add(created);
+                result->import.add(imported.nanoseconds);
+                result->destroy.add(destroyed);
+            }
+        }
+        gl.DeleteTextures(1, &texture);
+    }
+
+    // steady state, one image shared for all frames
+    if (result->state == ImageBenchmark::Ok) {
+        GL::Uint texture = newTexture();
+        const EGLImageKHR image = createImage(texture);
+        if (image != EGL_NO_IMAGE_KHR && import(image).ok) {
+            result->frame.reserve(iterations);
+            for (int i = 0; i <= iterations; ++i) {
+                // a different value every frame, so a stale texel shows
+                const GL::Ubyte value = static_cast<GL::Ubyte>(i * 37 + 1);
+                const GL::Ubyte texel[4] = { value, 0, 0, 255 };
+                const auto start = std::chrono::steady_clock::now();
+                gl.TexSubImage2D(GL::TEXTURE_2D, 0, 0, 0, 1, 1, GL::RGBA, GL::UNSIGNED_BYTE, texel);
+                Message frame(Message::Frame);
+                if (result->synchronization == ImageBenchmark::Finish)
+                    gl.Finish();
+                else
+                    frame.sync = flushedFence(display, egl);
+                toConsumer.post(frame);
+                const Message reply = toProducer.take();
+                waitForFence(display, egl, result->synchronization, reply.sync);
+                const int64_t nanoseconds = elapsed(start);
+                if (i == 0)
+                    continue;
+                result->frame.add(nanoseconds);
+                if (reply.ok) {
+                    ++result->framesChecked;
+                    if (reply.texel == value)
+                        ++result->framesMatched;
+                }
+            }
+        }
+        if (image != EGL_NO_IMAGE_KHR)
+            egl.destroyImage(display, image);
+        gl.DeleteTextures(1, &texture);
+    }
+
+    toConsumer.post(Message(Message::Quit));
+    consumer.join();
+    return result->state == ImageBenchmark::Ok;
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_IMAGEBENCH_H
+#define EGLINFO_IMAGEBENCH_H
+
+#include "contextinfo.h"
+#include "latency.h"
+
+namespace EglInfo {
+
+/** EGLImage texture sharing latencies between two contexts of one display, see benchmarkImages(). */
+struct ImageBenchmark {
+    enum State {
+        Ok,
+        /** A required extension is missing, see missing. */
+        Unsupported,
+        Unresolved,
+        ContextFailed,
+        /** eglCreateImageKHR failed, see error. */
+        CreateFailed,
+        /** glEGLImageTargetTexture2DOES failed in the consumer context. */
+        ImportFailed
+    } state;
+    /** Extension missing if state is Unsupported. */
+    const char* missing;
+    /** Reason if state is ContextFailed. */
+    ContextInfo::State contextState;
+    /** eglGetError() if state is CreateFailed. */
+    EGLint error;
+    EGLenum api;
+    /** Size of the shared texture. */
+    int width;
+    int height;
+
+    /** How frames are handed between the contexts. */
+    enum Synchronization {
+        /** No EGL_KHR_fence_sync, the producer calls glFinish before the hand off. */
+        Finish,
+        /** EGL_KHR_fence_sync, waited for on the CPU with eglClientWaitSyncKHR. */
+        ClientWait,
+        /** EGL_KHR_wait_sync, waited for by the GPU with eglWaitSyncKHR. */
+        ServerWait
+    } synchronization;
+
+    /** eglCreateImageKHR from a freshly allocated texture in the producer context. */
+    LatencyHistogram create;
+    /** Texture creation and glEGLImageTargetTexture2DOES in the consumer context. */
+    LatencyHistogram import;
+    /** eglDestroyImageKHR while the consumer's texture still refers to the image. */
+    LatencyHistogram destroy;
+    /**
+     * One steady state frame: the producer updates a texel and fences, the consumer waits, reads
+     * the texel through its imported texture and fences back, and the producer waits for that.
+     * Includes both thread hand offs.
+     */
+    LatencyHistogram frame;
+    /** Frames in which the consumer read the texel the producer wrote, and all frames checked. */
+    int framesMatched;
+    int framesChecked;
+
+    ImageBenchmark();
+};
+
+/**
+ * Measures sharing a texture between two contexts through EGL_KHR_gl_texture_2D_image on the
+ * initialized display @p info over @p iterations iterations: the producer context on the calling
+ * thread creates the images, a consumer context on a second thread imports them with
+ * GL_OES_EGL_image. Both contexts use the preferred client API and are surfaceless where possible.
+ * Leaves no context current on the calling thread.
+ */
+bool benchmarkImages(const DisplayInfo& info, int iterations, ImageBenchmark* result);
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "latency.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+namespace EglInfo {
+
+void LatencyHistogram::add(int64_t nanoseconds)
+{
+    if (!m_samples.empty() && nanoseconds < m_samples.back())
+        m_sorted = false;
+    m_samples.push_back(nanoseconds);
+}
+
+void LatencyHistogram::sort() const
+{
+    if (!m_sorted)
+        std::sort(m_samples.begin(), m_samples.end());
+    m_sorted = true;
+}
+
+int64_t LatencyHistogram::min() const
+{
+    sort();
+    return m_samples.empty() ? 0 : m_samples.front();
+}
+
+int64_t LatencyHistogram::max() const
+{
+    sort();
+    return m_samples.empty() ? 0 : m_samples.back();
+}
+
+int64_t LatencyHistogram::mean() const
+{
+    if (m_samples.empty())
+        return 0;
+    int64_t total = 0;
+    for (int64_t sample : m_samples)
+        total += sample;
+    return total / int64_t(m_samples.size());
+}
+
+int64_t LatencyHistogram::percentile(int percent) const
+{
+    sort();
+    if (m_samples.empty())
+        return 0;
+    const size_t index = std::min(m_samples.size() - 1, m_samples.size() * size_t(percent) / 100);
+    return m_samples[index];
+}
+
+std::string formatDuration(int64_t nanoseconds)
+{
+    char buffer[32];
+    if (nanoseconds < 10000)
+        snprintf(buffer, sizeof(buffer), "%lld ns", static_cast<long long>(nanoseconds));
+    else if (nanoseconds < 10000000)
+        snprintf(buffer, sizeof(buffer), "%.1f us", nanoseconds / 1e3);
+    else
+        snprintf(buffer, sizeof(buffer), "%.1f ms", nanoseconds / 1e6);
+    return buffer;
+}
+
+static int log2Floor(int64_t value)
+{
+    int bits = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++bits;
+    }
+    return bits;
+}
+
+void LatencyHistogram::print(std::ostream& out, const char* name, const char* indent) const
+{
+    if (m_samples.empty()) {
+        out << indent << name << ": no samples" << std::endl;
+        return;
+    }
+
+    out << indent << name << ": " << count() << " iterations, min " << formatDuration(min())
+        << ", median " << formatDuration(percentile(50)) << ", mean " << formatDuration(mean())
+        << ", p99 " << formatDuration(percentile(99)) << ", max " << formatDuration(max()) << std::endl;
+
+    const int first = log2Floor(std::max<int64_t>(1, min()));
+    const int last = log2Floor(std::max<int64_t>(1, max()));
+    std::vector<size_t> buckets(last - first + 1, 0);
+    for (int64_t sample : m_samples)
+        ++buckets[log2Floor(std::max<int64_t>(1, sample)) - first];
+    const size_t largest = *std::max_element(buckets.begin(), buckets.end());
+
+    enum { BarWidth = 40 };
+    for (int i = first; i <= last; ++i) {
+        const size_t samples = buckets[i - first];
+        const std::string range = formatDuration(int64_t(1) << i) + " - " + formatDuration(int64_t(1) << (i + 1));
+        out << indent << "  " << std::left << std::setw(22) << range << std::right << std::setw(8) << samples << " "
+            << std::string((samples * BarWidth + largest - 1) / largest, '#') << std::endl;
+    }
+}
+
+}
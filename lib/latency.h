@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_LATENCY_H
+#define EGLINFO_LATENCY_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/** Formats @p nanoseconds with a unit keeping three significant digits, e.g. "12.3 us". */
+std::string formatDuration(int64_t nanoseconds);
+
+/** Latency samples of one benchmarked operation, in nanoseconds. */
+class LatencyHistogram
+{
+public:
+    void reserve(size_t count) { m_samples.reserve(count); }
+    void add(int64_t nanoseconds);
+
+    size_t count() const { return m_samples.size(); }
+    bool isEmpty() const { return m_samples.empty(); }
+    int64_t min() const;
+    int64_t max() const;
+    int64_t mean() const;
+    /** Returns the @p percent percentile (0 - 100). */
+    int64_t percentile(int percent) const;
+
+    /**
+     * Prints a summary line followed by one line per power of two bucket between the fastest
+     * and the slowest sample, each with its sample count and a bar.
+     */
+    void print(std::ostream& out, const char* name, const char* indent) const;
+
+private:
+    void sort() const;
+
+    mutable std::vector<int64_t> m_samples;
+    mutable bool m_sorted = true;
+};
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+TEMPLATE = lib
+TARGET = eglinfo
+CONFIG += staticlib
+include(../eglinfo.pri)
+HEADERS += \
+    asyncprobe.h \
+    attributes.h \
+    contextinfo.h \
+    contextmatrix.h \
+    costmodel.h \
+    dmabuf.h \
+    encoding.h \
+    fingerprint.h \
+    glfunctions.h \
+    hash.h \
+    hostrecord.h \
+    imagebench.h \
+    latency.h \
+    memorycost.h \
+    pbufferlimit.h \
+    probe.h \
+    query.h \
+    recommend.h \
+    serverprotocol.h \
+    shaderbench.h \
+    snapshot.h \
+    snapshotwriter.h \
+    syncbench.h \
+    timeline.h \
+    tracepoints.h \
+    topology.h \
+    transferbench.h
+SOURCES += \
+    asyncprobe.cpp \
+    attributes.cpp \
+    contextinfo.cpp \
+    contextmatrix.cpp \
+    costmodel.cpp \
+    dmabuf.cpp \
+    encoding.cpp \
+    fingerprint.cpp \
+    glfunctions.cpp \
+    hostrecord.cpp \
+    imagebench.cpp \
+    latency.cpp \
+    memorycost.cpp \
+    pbufferlimit.cpp \
+    probe.cpp \
+    query.cpp \
+    recommend.cpp \
+    shaderbench.cpp \
+    snapshotwriter.cpp \
+    syncbench.cpp \
+    timeline.cpp \
+    topology.cpp \
+    transferbench.cpp
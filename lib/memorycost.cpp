@@ -0,0 +1,128 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "memorycost.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace EglInfo {
+
+/** Reads the "Rss:", "Pss:" and "Anonymous:" lines of smaps_rollup, which are in kB. */
+static bool readSmapsRollup(MemorySample* sample)
+{
+    FILE *file = fopen("/proc/self/smaps_rollup", "re");
+    if (!file)
+        return false;
+    char line[256];
+    int found = 0;
+    while (fgets(line, sizeof(line), file)) {
+        int64_t kilobytes;
+        if (sscanf(line, "Rss: %" SCNd64, &kilobytes) == 1) {
+            sample->rss = kilobytes * 1024;
+            ++found;
+        } else if (sscanf(line, "Pss: %" SCNd64, &kilobytes) == 1) {
+            sample->pss = kilobytes * 1024;
+            ++found;
+        } else if (sscanf(line, "Anonymous: %" SCNd64, &kilobytes) == 1) {
+            sample->anonymous = kilobytes * 1024;
+            ++found;
+        }
+    }
+    fclose(file);
+    return found > 0;
+}
+
+static bool readStatm(MemorySample* sample)
+{
+    FILE *file = fopen("/proc/self/statm", "re");
+    if (!file)
+        return false;
+    long long size, resident;
+    const bool ok = fscanf(file, "%lld %lld", &size, &resident) == 2;
+    fclose(file);
+    if (ok)
+        sample->rss = resident * sysconf(_SC_PAGESIZE);
+    return ok;
+}
+
+static bool readMaps(MemorySample* sample)
+{
+    FILE *file = fopen("/proc/self/maps", "re");
+    if (!file)
+        return false;
+    char line[4096 + 128];
+    while (fgets(line, sizeof(line), file)) {
+        unsigned long long start, end;
+        int pathOffset = 0;
+        if (sscanf(line, "%llx-%llx %*s %*s %*s %*s %n", &start, &end, &pathOffset) < 2 || !pathOffset)
+            continue;
+        char *path = line + pathOffset;
+        if (*path != '/')
+            continue;
+        path[strcspn(path, "\n")] = '\0';
+        sample->files[path] += end - start;
+    }
+    fclose(file);
+    return true;
+}
+
+bool sampleMemory(MemorySample* sample)
+{
+    *sample = MemorySample();
+    if (!readSmapsRollup(sample) && !readStatm(sample))
+        return false;
+    return readMaps(sample);
+}
+
+MemoryDelta memoryDelta(const MemorySample& before, const MemorySample& after, std::vector<MappedObject>* objects)
+{
+    MemoryDelta delta;
+    delta.rss = after.rss - before.rss;
+    if (before.pss >= 0 && after.pss >= 0)
+        delta.pss = after.pss - before.pss;
+    if (before.anonymous >= 0 && after.anonymous >= 0)
+        delta.anonymous = after.anonymous - before.anonymous;
+
+    auto b = before.files.begin();
+    for (const auto &file : after.files) {
+        while (b != before.files.end() && b->first < file.first)
+            delta.mappedFiles -= (b++)->second;
+        int64_t previous = 0;
+        if (b != before.files.end() && b->first == file.first)
+            previous = (b++)->second;
+        delta.mappedFiles += file.second - previous;
+        if (objects && file.second > previous)
+            objects->push_back(MappedObject{ file.first, file.second - previous });
+    }
+    for (; b != before.files.end(); ++b)
+        delta.mappedFiles -= b->second;
+
+    if (objects) {
+        std::stable_sort(objects->begin(), objects->end(), [](const MappedObject& lhs, const MappedObject& rhs) {
+            return lhs.bytes > rhs.bytes;
+        });
+    }
+    return delta;
+}
+
+}
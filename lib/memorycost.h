@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_MEMORYCOST_H
+#define EGLINFO_MEMORYCOST_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/** Memory of the process at one point in time, in bytes. */
+struct MemorySample {
+    /** From /proc/self/smaps_rollup, or /proc/self/statm on kernels without it. */
+    int64_t rss = 0;
+    /** -1 if only /proc/self/statm is available. */
+    int64_t pss = -1;
+    int64_t anonymous = -1;
+    /** Size of the file-backed mappings by path, from /proc/self/maps. */
+    std::map<std::string, int64_t> files;
+};
+
+/** Growth of the process memory across one probe phase, in bytes; negative if it shrank. */
+struct MemoryDelta {
+    int64_t rss = 0;
+    /** 0 if unknown. */
+    int64_t pss = 0;
+    int64_t anonymous = 0;
+    int64_t mappedFiles = 0;
+};
+
+struct MappedObject {
+    std::string path;
+    int64_t bytes;
+};
+
+/**
+ * Memory cost of probing a display. The process is measured as a whole, so a driver shared
+ * by several displays is attributed to the first one initialized, and the numbers are only
+ * meaningful while no other thread loads or maps anything.
+ */
+struct MemoryCost {
+    enum State {
+        NotMeasured,
+        /** /proc is not available. */
+        Unavailable,
+        Ok
+    } state = NotMeasured;
+    MemoryDelta initialize;
+    MemoryDelta configs;
+    /** Files newly mapped by eglInitialize(), typically the driver DSOs, largest first. */
+    std::vector<MappedObject> initializeObjects;
+};
+
+/** Fills @p sample from /proc/self. Returns false if /proc is not available. */
+bool sampleMemory(MemorySample* sample);
+
+/** Returns the growth from @p before to @p after; adds files that grew to @p objects if given. */
+MemoryDelta memoryDelta(const MemorySample& before, const MemorySample& after, std::vector<MappedObject>* objects = nullptr);
+
+}
+
+#endif
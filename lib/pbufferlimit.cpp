@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "pbufferlimit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace EglInfo {
+
+/** Fallback search bound for drivers reporting no pbuffer limits. */
+static const EGLint unreportedLimit = 16384;
+
+PbufferLimit::PbufferLimit()
+    : state(Ok)
+    , reportedWidth(0)
+    , reportedHeight(0)
+    , reportedPixels(0)
+    , size(0)
+    , budgetExceeded(false)
+{
+}
+
+static bool tryCreate(EGLDisplay display, EGLConfig config, EGLint size, PbufferLimit* result)
+{
+    const EGLint attribs[] = { EGL_WIDTH, size, EGL_HEIGHT, size, EGL_NONE };
+    PbufferAttempt attempt;
+    attempt.width = size;
+    attempt.height = size;
+    const auto start = std::chrono::steady_clock::now();
+    const EGLSurface surface = eglCreatePbufferSurface(display, config, attribs);
+    attempt.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    attempt.error = surface == EGL_NO_SURFACE ? eglGetError() : EGL_SUCCESS;
+    // release right away, the next attempt may need the memory
+    if (surface != EGL_NO_SURFACE)
+        eglDestroySurface(display, surface);
+    result->attempts.push_back(attempt);
+    return attempt.error == EGL_SUCCESS;
+}
+
+bool probePbufferLimit(EGLDisplay display, const ConfigInfo& config, int budgetMs, PbufferLimit* result)
+{
+    *result = PbufferLimit();
+    if (!(config.value(EGL_SURFACE_TYPE) & EGL_PBUFFER_BIT)) {
+        result->state = PbufferLimit::Unsupported;
+        return false;
+    }
+    result->reportedWidth = config.value(EGL_MAX_PBUFFER_WIDTH);
+    result->reportedHeight = config.value(EGL_MAX_PBUFFER_HEIGHT);
+    result->reportedPixels = config.value(EGL_MAX_PBUFFER_PIXELS);
+
+    EGLint high = std::min(result->reportedWidth > 0 ? result->reportedWidth : unreportedLimit,
+                           result->reportedHeight > 0 ? result->reportedHeight : unreportedLimit);
+    if (result->reportedPixels > 0)
+        high = std::min<EGLint>(high, std::sqrt(double(result->reportedPixels)));
+    high = std::max<EGLint>(high, 1);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMs);
+    if (tryCreate(display, config.config, high, result)) {
+        result->size = high;
+        return true;
+    }
+    if (high == 1 || !tryCreate(display, config.config, 1, result)) {
+        result->state = PbufferLimit::CreateFailed;
+        return false;
+    }
+
+    // invariant: low can be created, high cannot
+    EGLint low = 1;
+    while (high - low > 1) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            result->budgetExceeded = true;
+            break;
+        }
+        const EGLint middle = low + (high - low) / 2;
+        if (tryCreate(display, config.config, middle, result))
+            low = middle;
+        else
+            high = middle;
+    }
+    result->size = low;
+    return true;
+}
+
+}
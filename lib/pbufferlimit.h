@@ -0,0 +1,71 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_PBUFFERLIMIT_H
+#define EGLINFO_PBUFFERLIMIT_H
+
+#include "probe.h"
+
+#include <vector>
+
+namespace EglInfo {
+
+/** One pbuffer allocation attempt of probePbufferLimit(). */
+struct PbufferAttempt {
+    EGLint width;
+    EGLint height;
+    /** EGL_SUCCESS if eglCreatePbufferSurface succeeded, its error otherwise. */
+    EGLint error;
+    /** Latency of eglCreatePbufferSurface, in nanoseconds. */
+    int64_t nanoseconds;
+};
+
+/** Largest pbuffer a config could actually allocate, compared to its EGL_MAX_PBUFFER_* attributes. */
+struct PbufferLimit {
+    enum State {
+        Ok,
+        /** The config does not support pbuffer surfaces. */
+        Unsupported,
+        /** Not even a 1x1 pbuffer could be created. */
+        CreateFailed
+    } state;
+    EGLint reportedWidth;
+    EGLint reportedHeight;
+    EGLint reportedPixels;
+    /** Largest square pbuffer edge created, 0 unless state is Ok. */
+    EGLint size;
+    /** True if the time budget ran out before the search converged. */
+    bool budgetExceeded;
+    /** Attempts in the order they were made. */
+    std::vector<PbufferAttempt> attempts;
+
+    PbufferLimit();
+};
+
+/**
+ * Searches for the largest square pbuffer @p config can allocate on @p display, within the size
+ * its EGL_MAX_PBUFFER_* attributes allow. The reported maximum is tried first, then a binary search
+ * runs until it converges or @p budgetMs milliseconds have passed. Every surface is destroyed right
+ * after it was created. Drivers which defer allocation until first use may report success for
+ * sizes they cannot back.
+ */
+bool probePbufferLimit(EGLDisplay display, const ConfigInfo& config, int budgetMs, PbufferLimit* result);
+
+}
+
+#endif
@@ -0,0 +1,385 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "probe.h"
+#include "fingerprint.h"
+#include "timeline.h"
+#include "tracepoints.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+
+namespace EglInfo {
+
+static_assert(AttributeCount <= 32, "ConfigInfo::validMask cannot hold all attributes");
+
+EGLint ConfigInfo::value(EGLint attribute, EGLint defaultValue) const
+{
+    const int index = attributeIndex(attribute);
+    if (index < 0 || !isValid(index))
+        return defaultValue;
+    return values[index];
+}
+
+uint64_t ConfigInfo::fingerprint() const
+{
+    if (!hasFingerprint) {
+        cachedFingerprint = configFingerprint(*this);
+        hasFingerprint = true;
+    }
+    return cachedFingerprint;
+}
+
+DisplayInfo::DisplayInfo()
+    : state(Ok)
+    , display(EGL_NO_DISPLAY)
+    , majorVersion(0)
+    , minorVersion(0)
+    , clientAPIs(nullptr)
+    , vendor(nullptr)
+    , extensions(nullptr)
+    , outputLayers{ OutputCount::NotQueried, 0 }
+    , outputPorts{ OutputCount::NotQueried, 0 }
+    , numConfigs(0)
+    , initializeTime(0)
+{
+}
+
+#ifdef EGL_EXT_device_base
+DeviceInfo::DeviceInfo()
+    : device(nullptr)
+    , extensions(nullptr)
+    , hasDisplay(false)
+{
+    memset(properties, 0, sizeof(properties));
+}
+
+DeviceList::DeviceList()
+    : state(NotQueried)
+{
+}
+#endif
+
+ProbeResult::ProbeResult()
+    : clientExtensions(nullptr)
+    , hasDefaultDisplay(false)
+{
+}
+
+ProbeOptions::ProbeOptions()
+    : measureMemory(false)
+    , sysfsRoot("/sys")
+{
+}
+
+bool hasExtension(const char* extensions, const char* name)
+{
+    if (!extensions || !name)
+        return false;
+
+    const size_t length = strlen(name);
+    for (const char* pos = strstr(extensions, name); pos; pos = strstr(pos + length, name)) {
+        if ((pos == extensions || pos[-1] == ' ') && (pos[length] == ' ' || pos[length] == '\0'))
+            return true;
+    }
+    return false;
+}
+
+// Extension entry points are resolved once per process: their addresses do not depend on the
+// display, and every eglGetProcAddress() is a driver round trip on remoted EGL implementations.
+
+/** Returns the result of @p call, an EGL call on @p display, between egl_call tracepoints. */
+template <typename F>
+static auto tracedCall(const char* function, EGLDisplay display, F call) -> decltype(call())
+{
+    EGLINFO_TRACE2(egl_call_entry, function, display);
+    const auto result = call();
+    EGLINFO_TRACE3(egl_call_return, function, display, result);
+    return result;
+}
+
+static void queryOutputLayers(EGLDisplay display, OutputCount* result)
+{
+#ifdef EGL_EXT_output_base
+    static const auto eglGetOutputLayersEXT = reinterpret_cast<PFNEGLGETOUTPUTLAYERSEXTPROC>(eglGetProcAddress("eglGetOutputLayersEXT"));
+    if (!eglGetOutputLayersEXT) {
+        result->state = OutputCount::Unresolved;
+        return;
+    }
+
+    result->count = 0;
+    if (!tracedCall("eglGetOutputLayersEXT", display, [&] { return eglGetOutputLayersEXT(display, nullptr, nullptr, 0, &result->count); })) {
+        result->state = OutputCount::QueryFailed;
+        return;
+    }
+    result->state = OutputCount::Ok;
+#else
+    (void)display;
+    (void)result;
+#endif
+}
+
+static void queryOutputPorts(EGLDisplay display, OutputCount* result)
+{
+#ifdef EGL_EXT_output_base
+    static const auto eglGetOutputPortsEXT = reinterpret_cast<PFNEGLGETOUTPUTPORTSEXTPROC>(eglGetProcAddress("eglGetOutputPortsEXT"));
+    if (!eglGetOutputPortsEXT) {
+        result->state = OutputCount::Unresolved;
+        return;
+    }
+
+    result->count = 0;
+    if (!tracedCall("eglGetOutputPortsEXT", display, [&] { return eglGetOutputPortsEXT(display, nullptr, nullptr, 0, &result->count); })) {
+        result->state = OutputCount::QueryFailed;
+        return;
+    }
+    result->state = OutputCount::Ok;
+#else
+    (void)display;
+    (void)result;
+#endif
+}
+
+const char* queryClientExtensions()
+{
+    TimelineSpan span("client extensions");
+    return tracedCall("eglQueryString", EGL_NO_DISPLAY, [] { return eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS); });
+}
+
+static bool queryDisplay(EGLDisplay display, DisplayInfo* info, const ProbeOptions& options)
+{
+    *info = DisplayInfo();
+    info->display = display;
+
+    MemorySample before, after;
+    bool measureMemory = options.measureMemory && sampleMemory(&before);
+
+    const auto initializeStart = std::chrono::steady_clock::now();
+    EGLBoolean initialized;
+    {
+        TimelineSpan initializeSpan("eglInitialize");
+        initialized = tracedCall("eglInitialize", display, [&] { return eglInitialize(display, &info->majorVersion, &info->minorVersion); });
+    }
+    info->initializeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - initializeStart).count();
+    if (options.measureMemory) {
+        measureMemory = measureMemory && sampleMemory(&after);
+        info->memoryCost.state = measureMemory ? MemoryCost::Ok : MemoryCost::Unavailable;
+    }
+    if (measureMemory) {
+        info->memoryCost.initialize = memoryDelta(before, after, &info->memoryCost.initializeObjects);
+        before = std::move(after);
+    }
+    if (!initialized) {
+        info->state = DisplayInfo::InitializeFailed;
+        return false;
+    }
+
+    info->clientAPIs = tracedCall("eglQueryString", display, [&] { return eglQueryString(display, EGL_CLIENT_APIS); });
+    info->vendor = tracedCall("eglQueryString", display, [&] { return eglQueryString(display, EGL_VENDOR); });
+    info->extensions = tracedCall("eglQueryString", display, [&] { return eglQueryString(display, EGL_EXTENSIONS); });
+
+    if (hasExtension(info->extensions, "EGL_EXT_output_base")) {
+        queryOutputLayers(display, &info->outputLayers);
+        queryOutputPorts(display, &info->outputPorts);
+    }
+
+    std::vector<EGLConfig> configs;
+    {
+        TimelineSpan configsSpan("eglGetConfigs");
+        if (!tracedCall("eglGetConfigs", display, [&] { return eglGetConfigs(display, nullptr, 0, &info->numConfigs); })) {
+            info->state = DisplayInfo::ConfigCountFailed;
+            return false;
+        }
+
+        configs.resize(info->numConfigs);
+        if (!tracedCall("eglGetConfigs", display, [&] { return eglGetConfigs(display, configs.data(), info->numConfigs, &info->numConfigs); })) {
+            info->state = DisplayInfo::ConfigsFailed;
+            return false;
+        }
+    }
+
+    TimelineSpan attributesSpan("config attributes", isTimelineEnabled() ? std::to_string(info->numConfigs) + " configs" : std::string());
+    info->configs.resize(info->numConfigs);
+    for (int i = 0; i < info->numConfigs; ++i) {
+        EGLINFO_TRACE2(config_entry, display, i);
+        ConfigInfo &config = info->configs[i];
+        config.config = configs[i];
+        config.validMask = 0;
+        for (int j = 0; j < attributesSize; ++j) {
+            config.values[j] = 0;
+            EGLINFO_TRACE3(get_config_attrib_entry, display, i, attributes[j].attribute);
+            const EGLBoolean ok = eglGetConfigAttrib(display, configs[i], attributes[j].attribute, &config.values[j]);
+            EGLINFO_TRACE5(get_config_attrib_return, display, i, attributes[j].attribute, config.values[j], ok);
+            if (ok)
+                config.validMask |= 1u << j;
+        }
+        config.cachedFingerprint = configFingerprint(config);
+        config.hasFingerprint = true;
+        EGLINFO_TRACE3(config_return, display, i, config.validMask);
+    }
+
+    if (measureMemory && sampleMemory(&after))
+        info->memoryCost.configs = memoryDelta(before, after);
+    return true;
+}
+
+bool probeDisplay(EGLDisplay display, DisplayInfo* info, const ProbeOptions& options)
+{
+    TimelineSpan span("probeDisplay");
+    EGLINFO_TRACE1(probe_display_entry, display);
+    const bool ok = queryDisplay(display, info, options);
+    EGLINFO_TRACE2(probe_display_return, display, static_cast<int>(info->state));
+    return ok;
+}
+
+#ifdef EGL_EXT_device_base
+
+EGLDisplay displayForDevice(EGLDeviceEXT device)
+{
+    TimelineSpan span("displayForDevice");
+#ifdef EGL_EXT_platform_base
+    static const auto eglGetPlatformDisplayExt = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    EGLINFO_TRACE1(display_for_device_entry, device);
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (eglGetPlatformDisplayExt) {
+        EGLint attribs[] = { EGL_NONE };
+        display = tracedCall("eglGetPlatformDisplayEXT", EGL_NO_DISPLAY, [&] { return eglGetPlatformDisplayExt(EGL_PLATFORM_DEVICE_EXT, device, attribs); });
+    }
+    EGLINFO_TRACE2(display_for_device_return, device, display);
+    return display;
+#else
+#warning "Compiling without EGL_EXT_platform_base extension support!"
+    (void)device;
+    return EGL_NO_DISPLAY;
+#endif
+}
+
+bool queryDevices(DeviceList* list)
+{
+    TimelineSpan span("queryDevices");
+    list->devices.clear();
+
+    static const auto eglQueryDevicesEXT = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    EGLDeviceEXT devices[32];
+    EGLint num_devices = 0;
+    if (!eglQueryDevicesEXT || !tracedCall("eglQueryDevicesEXT", EGL_NO_DISPLAY, [&] { return eglQueryDevicesEXT(32, devices, &num_devices); })) {
+        list->state = DeviceList::QueryFailed;
+        return false;
+    }
+    list->state = DeviceList::Ok;
+    if (num_devices == 0)
+        return true;
+
+    static const auto eglQueryDeviceAttribEXT = reinterpret_cast<PFNEGLQUERYDEVICEATTRIBEXTPROC>(eglGetProcAddress("eglQueryDeviceAttribEXT"));
+    static const auto eglQueryDeviceStringEXT = reinterpret_cast<PFNEGLQUERYDEVICESTRINGEXTPROC>(eglGetProcAddress("eglQueryDeviceStringEXT"));
+
+    list->devices.resize(num_devices);
+    for (int i = 0; i < num_devices; ++i) {
+        DeviceInfo &info = list->devices[i];
+        info.device = devices[i];
+        info.extensions = tracedCall("eglQueryDeviceStringEXT", EGL_NO_DISPLAY, [&] { return eglQueryDeviceStringEXT(info.device, EGL_EXTENSIONS); });
+
+        for (int j = 0; j < devicePropertiesSize; ++j) {
+            const auto &property = deviceProperties[j];
+            if (!hasExtension(info.extensions, property.extension))
+                continue;
+            DevicePropertyValue &value = info.properties[j];
+            switch (property.type) {
+                case device_property_t::String:
+                    value.string = tracedCall("eglQueryDeviceStringEXT", EGL_NO_DISPLAY, [&] { return eglQueryDeviceStringEXT(info.device, property.name); });
+                    value.present = value.string != nullptr;
+                    break;
+                case device_property_t::Attribute:
+                    value.present = tracedCall("eglQueryDeviceAttribEXT", EGL_NO_DISPLAY, [&] { return eglQueryDeviceAttribEXT(info.device, property.name, &value.attrib); }) != EGL_FALSE;
+                    break;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool probeDeviceDisplay(DeviceInfo* device, const ProbeOptions& options)
+{
+    EGLDisplay display = displayForDevice(device->device);
+    device->hasDisplay = display != EGL_NO_DISPLAY;
+    if (!device->hasDisplay)
+        return false;
+    return probeDisplay(display, &device->display, options);
+}
+
+bool probeDevice(DeviceList* list, size_t index, const ProbeOptions& options)
+{
+    TimelineSpan span("device", isTimelineEnabled() ? "device " + std::to_string(index) : std::string());
+    EGLINFO_TRACE1(device_entry, index);
+    DeviceInfo &device = list->devices[index];
+    const bool ok = probeDeviceDisplay(&device, options);
+    if (!options.sysfsRoot.empty())
+        queryDeviceTopology(drmDeviceFile(device), options.sysfsRoot, &device.topology);
+    EGLINFO_TRACE2(device_return, index, device.hasDisplay);
+    return ok;
+}
+
+bool probeDevices(DeviceList* list, const ProbeOptions& options)
+{
+    if (!queryDevices(list))
+        return false;
+
+    for (size_t i = 0; i < list->devices.size(); ++i)
+        probeDevice(list, i, options);
+    return true;
+}
+
+const char* drmDeviceFile(const DeviceInfo& device)
+{
+#ifdef EGL_DRM_DEVICE_FILE_EXT
+    for (int i = 0; i < devicePropertiesSize; ++i) {
+        if (deviceProperties[i].name == EGL_DRM_DEVICE_FILE_EXT && device.properties[i].present)
+            return device.properties[i].string;
+    }
+#else
+    (void)device;
+#endif
+    return nullptr;
+}
+#endif
+
+bool probeDefaultDisplay(ProbeResult* result, const ProbeOptions& options)
+{
+    TimelineSpan span("default display");
+    EGLDisplay display = tracedCall("eglGetDisplay", EGL_NO_DISPLAY, [] { return eglGetDisplay(EGL_DEFAULT_DISPLAY); });
+    result->hasDefaultDisplay = display != EGL_NO_DISPLAY;
+    return result->hasDefaultDisplay && probeDisplay(display, &result->defaultDisplay, options);
+}
+
+void probe(ProbeResult* result, const ProbeOptions& options)
+{
+    TimelineSpan span("probe");
+    EGLINFO_TRACE0(probe_entry);
+    result->clientExtensions = queryClientExtensions();
+
+#ifdef EGL_EXT_device_base
+    if (hasExtension(result->clientExtensions, "EGL_EXT_device_base"))
+        probeDevices(&result->devices, options);
+#endif
+
+    probeDefaultDisplay(result, options);
+    EGLINFO_TRACE0(probe_return);
+}
+
+}
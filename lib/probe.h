@@ -0,0 +1,194 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_PROBE_H
+#define EGLINFO_PROBE_H
+
+#include "attributes.h"
+#include "dmabuf.h"
+#include "memorycost.h"
+#include "topology.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/** Attribute values of a single EGLConfig, indexed like attributes. */
+struct ConfigInfo {
+    EGLConfig config;
+    EGLint values[AttributeCount];
+    /** Bit i is set if eglGetConfigAttrib succeeded for attributes[i]. */
+    uint32_t validMask;
+    /** fingerprint() once hasFingerprint is set. Clear that when changing values. */
+    mutable uint64_t cachedFingerprint;
+    mutable bool hasFingerprint;
+
+    bool isValid(int index) const { return validMask & (1u << index); }
+    /** Returns the value of @p attribute, or @p defaultValue if it was not retrieved. */
+    EGLint value(EGLint attribute, EGLint defaultValue = 0) const;
+    /**
+     * Returns configFingerprint() of this config. Decoded configs compute it on first use, so
+     * loading stored results does not pay for fingerprints nobody asks for.
+     */
+    uint64_t fingerprint() const;
+};
+
+/** Result of an EGL_EXT_output_base layer or port count query. */
+struct OutputCount {
+    enum State {
+        NotQueried,
+        Unresolved,
+        QueryFailed,
+        Ok
+    } state;
+    EGLint count;
+};
+
+/**
+ * Everything the probe learns about an EGLDisplay.
+ * The strings are owned by the EGL implementation and stay valid until the display is terminated.
+ */
+struct DisplayInfo {
+    enum State {
+        Ok,
+        InitializeFailed,
+        ConfigCountFailed,
+        ConfigsFailed
+    } state;
+    EGLDisplay display;
+    EGLint majorVersion;
+    EGLint minorVersion;
+    const char* clientAPIs;
+    const char* vendor;
+    const char* extensions;
+    OutputCount outputLayers;
+    OutputCount outputPorts;
+    EGLint numConfigs;
+    std::vector<ConfigInfo> configs;
+    /** Time spent in eglInitialize(), in nanoseconds. */
+    int64_t initializeTime;
+    /** Memory mapped and touched by eglInitialize() and the config enumeration. */
+    MemoryCost memoryCost;
+    /** Only filled by queryDmaBufFormats(). */
+    DmaBufFormats dmaBufFormats;
+
+    DisplayInfo();
+};
+
+#ifdef EGL_EXT_device_base
+struct DevicePropertyValue {
+    bool present;
+    const char* string;
+    EGLAttrib attrib;
+};
+
+struct DeviceInfo {
+    EGLDeviceEXT device;
+    /** nullptr if the device extensions could not be retrieved. */
+    const char* extensions;
+    /** Indexed like deviceProperties; only entries whose extension is supported are present. */
+    DevicePropertyValue properties[MaxDeviceProperties];
+    bool hasDisplay;
+    DisplayInfo display;
+    /** Read from ProbeOptions::sysfsRoot by probeDevice(), NotQueried if that is empty. */
+    DeviceTopology topology;
+
+    DeviceInfo();
+};
+
+struct DeviceList {
+    enum State {
+        NotQueried,
+        QueryFailed,
+        Ok
+    } state;
+    std::vector<DeviceInfo> devices;
+
+    DeviceList();
+};
+#endif
+
+/** Result of a full probe, mirroring what the eglinfo tool prints. */
+struct ProbeResult {
+    /** nullptr if the implementation has no client extensions. */
+    const char* clientExtensions;
+#ifdef EGL_EXT_device_base
+    DeviceList devices;
+#endif
+    bool hasDefaultDisplay;
+    DisplayInfo defaultDisplay;
+
+    ProbeResult();
+};
+
+/** What the probe measures beyond the EGL queries. */
+struct ProbeOptions {
+    /**
+     * Samples the process' memory around eglInitialize() and the config enumeration, see
+     * DisplayInfo::memoryCost. The samples cover the whole process, so only enable this if no
+     * other thread initializes a display at the same time. Costs about 2 ms per display.
+     */
+    bool measureMemory;
+    /** Root of the sysfs tree device topologies are read from, "/sys" by default. Empty skips them. */
+    std::string sysfsRoot;
+
+    ProbeOptions();
+};
+
+/** Returns true if the space separated @p extensions list contains exactly @p name. */
+bool hasExtension(const char* extensions, const char* name);
+
+/** Returns the client extension string, nullptr if the implementation has no client extensions. */
+const char* queryClientExtensions();
+
+/** Initializes @p display and fills @p info. Returns false if any step failed, see DisplayInfo::state. */
+bool probeDisplay(EGLDisplay display, DisplayInfo* info, const ProbeOptions& options = ProbeOptions());
+
+#ifdef EGL_EXT_device_base
+/** Returns the platform display of @p device, or EGL_NO_DISPLAY. */
+EGLDisplay displayForDevice(EGLDeviceEXT device);
+
+/** Enumerates all EGL devices and their properties, without touching their displays. */
+bool queryDevices(DeviceList* list);
+
+/** Probes the platform display of @p device, if it has one. */
+bool probeDeviceDisplay(DeviceInfo* device, const ProbeOptions& options = ProbeOptions());
+
+/**
+ * Probes the display and the topology of the device at @p index of @p list, one step of
+ * probeDevices() that can run concurrently with the other devices.
+ */
+bool probeDevice(DeviceList* list, size_t index, const ProbeOptions& options = ProbeOptions());
+
+/** Enumerates all EGL devices and probes their displays. */
+bool probeDevices(DeviceList* list, const ProbeOptions& options = ProbeOptions());
+
+/** Returns the EGL_DRM_DEVICE_FILE_EXT of @p device, or nullptr. */
+const char* drmDeviceFile(const DeviceInfo& device);
+#endif
+
+/** Probes the default display of @p result. Returns false if there is none or probing it failed. */
+bool probeDefaultDisplay(ProbeResult* result, const ProbeOptions& options = ProbeOptions());
+
+/** Probes the client extensions, all devices (if supported) and the default display. */
+void probe(ProbeResult* result, const ProbeOptions& options = ProbeOptions());
+
+}
+
+#endif
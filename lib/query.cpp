@@ -0,0 +1,176 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "query.h"
+#include "fingerprint.h"
+
+#include <cctype>
+#include <cstring>
+
+#include <strings.h>
+
+namespace EglInfo {
+
+template <typename T>
+static bool compare(QueryTerm::Op op, T lhs, T rhs)
+{
+    switch (op) {
+        case QueryTerm::Equal:
+            return lhs == rhs;
+        case QueryTerm::NotEqual:
+            return lhs != rhs;
+        case QueryTerm::Less:
+            return lhs < rhs;
+        case QueryTerm::LessEqual:
+            return lhs <= rhs;
+        case QueryTerm::Greater:
+            return lhs > rhs;
+        case QueryTerm::GreaterEqual:
+            return lhs >= rhs;
+        case QueryTerm::HasBits:
+            return (lhs & rhs) == rhs;
+    }
+    return false;
+}
+
+bool QueryTerm::matches(EGLint attributeValue) const
+{
+    return compare(op, attributeValue, value);
+}
+
+bool QueryTerm::matchesAmount(int64_t value) const
+{
+    return compare(op, value, amount);
+}
+
+static bool parseTerm(const char* text, size_t length, QueryTerm* term)
+{
+    static const struct {
+        const char* token;
+        QueryTerm::Op op;
+    } ops[] = {
+        // two character operators first, so "<=" is not taken for "<"
+        { "!=", QueryTerm::NotEqual },
+        { "<=", QueryTerm::LessEqual },
+        { ">=", QueryTerm::GreaterEqual },
+        { "=", QueryTerm::Equal },
+        { "<", QueryTerm::Less },
+        { ">", QueryTerm::Greater },
+        { "&", QueryTerm::HasBits }
+    };
+
+    size_t nameLength = 0;
+    while (nameLength < length && strchr("!<>=&", text[nameLength]) == nullptr)
+        ++nameLength;
+    if (nameLength == 0 || nameLength == length)
+        return false;
+
+    const char *opText = text + nameLength;
+    size_t opLength = 0;
+    for (const auto &op : ops) {
+        const size_t tokenLength = strlen(op.token);
+        if (nameLength + tokenLength <= length && strncmp(opText, op.token, tokenLength) == 0) {
+            term->op = op.op;
+            opLength = tokenLength;
+            break;
+        }
+    }
+    if (opLength == 0)
+        return false;
+
+    const char *value = opText + opLength;
+    const size_t valueLength = length - nameLength - opLength;
+    if (valueLength == 0)
+        return false;
+
+    term->value = 0;
+    term->fingerprint = 0;
+    term->amount = 0;
+    if (nameLength == 3 && strncasecmp(text, "ext", 3) == 0) {
+        if (term->op != QueryTerm::Equal && term->op != QueryTerm::NotEqual)
+            return false;
+        term->attribute = QueryTerm::ExtensionTerm;
+        term->extension.assign(value, valueLength);
+        return true;
+    }
+    if (nameLength == 11 && strncasecmp(text, "fingerprint", 11) == 0) {
+        if (term->op != QueryTerm::Equal && term->op != QueryTerm::NotEqual)
+            return false;
+        term->attribute = QueryTerm::FingerprintTerm;
+        return parseFingerprint(value, valueLength, &term->fingerprint);
+    }
+    const bool frameBytes = nameLength == 11 && strncasecmp(text, "frame_bytes", 11) == 0;
+    if (frameBytes || (nameLength == 9 && strncasecmp(text, "bandwidth", 9) == 0)) {
+        if (term->op == QueryTerm::HasBits)
+            return false;
+        term->attribute = frameBytes ? QueryTerm::FrameBytesTerm : QueryTerm::BandwidthTerm;
+        return parseByteAmount(value, valueLength, &term->amount);
+    }
+
+    term->attribute = attributeIndex(text, nameLength);
+    if (term->attribute < 0)
+        return false;
+    return parseAttributeValue(&attributes[term->attribute], value, valueLength, &term->value);
+}
+
+bool parseQuery(const char* text, Query* query, std::string* errorMessage)
+{
+    query->clear();
+    while (*text) {
+        while (*text && isspace(static_cast<unsigned char>(*text)))
+            ++text;
+        size_t length = 0;
+        while (text[length] && !isspace(static_cast<unsigned char>(text[length])))
+            ++length;
+        if (length == 0)
+            break;
+
+        QueryTerm term;
+        if (!parseTerm(text, length, &term)) {
+            if (errorMessage)
+                *errorMessage = "Invalid query term \"" + std::string(text, length) + "\"";
+            return false;
+        }
+        query->push_back(term);
+        text += length;
+    }
+    return true;
+}
+
+bool matchesConfig(const Query& query, const ConfigInfo& config, const char* displayExtensions, const CostModel& model)
+{
+    for (const QueryTerm &term : query) {
+        if (term.attribute == QueryTerm::ExtensionTerm) {
+            if (hasExtension(displayExtensions, term.extension.c_str()) != (term.op == QueryTerm::Equal))
+                return false;
+        } else if (term.attribute == QueryTerm::FingerprintTerm) {
+            if ((config.fingerprint() == term.fingerprint) != (term.op == QueryTerm::Equal))
+                return false;
+        } else if (term.attribute == QueryTerm::FrameBytesTerm) {
+            if (!term.matchesAmount(frameBytes(config, model)))
+                return false;
+        } else if (term.attribute == QueryTerm::BandwidthTerm) {
+            if (!term.matchesAmount(writeBandwidth(config, model)))
+                return false;
+        } else if (!config.isValid(term.attribute) || !term.matches(config.values[term.attribute])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
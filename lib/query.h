@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_QUERY_H
+#define EGLINFO_QUERY_H
+
+#include "costmodel.h"
+#include "probe.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/**
+ * One condition of a config query, written as NAME OP VALUE:
+ * - NAME is a config attribute with or without EGL_ prefix (case insensitive),
+ *   "ext" for a display extension, "fingerprint" for the config fingerprint or
+ *   "frame_bytes" and "bandwidth" for the estimates of the CostModel, in bytes
+ *   and bytes per second with optional k, m or g suffix, e.g. "bandwidth<2g";
+ * - OP is one of = != < <= > >= and & (all flags in VALUE are set);
+ * - VALUE is a number or a name as printed by eglinfo, with '_' for spaces and
+ *   '|' between flags, e.g. "renderable_type&OpenGL_ES3|OpenGL_ES2".
+ */
+struct QueryTerm {
+    enum Op {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        HasBits
+    };
+
+    enum {
+        ExtensionTerm = -1,
+        FingerprintTerm = -2,
+        FrameBytesTerm = -3,
+        BandwidthTerm = -4
+    };
+
+    /** Index into attributes, or one of the term kinds above. */
+    int attribute;
+    Op op;
+    EGLint value;
+    /** Display extension required (op Equal) or excluded (op NotEqual) by an extension term. */
+    std::string extension;
+    /** Fingerprint required (op Equal) or excluded (op NotEqual) by a fingerprint term. */
+    uint64_t fingerprint;
+    /** Byte amount compared against by a FrameBytesTerm or BandwidthTerm. */
+    int64_t amount;
+
+    bool matches(EGLint attributeValue) const;
+    bool matchesAmount(int64_t value) const;
+};
+
+/** Whitespace separated terms, all of which must match. */
+typedef std::vector<QueryTerm> Query;
+
+/** Parses @p text into @p query. On failure, @p errorMessage describes the offending term. */
+bool parseQuery(const char* text, Query* query, std::string* errorMessage);
+
+/**
+ * Returns true if @p config on a display with @p displayExtensions satisfies all terms of @p query,
+ * estimating frame_bytes and bandwidth with @p model.
+ */
+bool matchesConfig(const Query& query, const ConfigInfo& config, const char* displayExtensions, const CostModel& model = CostModel());
+
+}
+
+#endif
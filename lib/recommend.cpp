@@ -0,0 +1,169 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "recommend.h"
+#include "costmodel.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace EglInfo {
+
+namespace {
+
+struct BuiltinProfile {
+    const char* name;
+    const char* description;
+    const char* clauses;
+};
+
+const BuiltinProfile builtins[] = {
+    { "video-overlay", "video planes composited over the UI: RGB(A) window surfaces, no depth, cheap to scan out",
+      "require surface_type&window color_buffer_type=RGB red_size>=8 green_size>=8 blue_size>=8\n"
+      "prefer 100 config_caveat=none\n"
+      "prefer 20 alpha_size=8\n"
+      "prefer 10 depth_size=0 stencil_size=0\n"
+      "prefer 10 samples=0\n"
+      "cost 1\n" },
+    { "3d-ui", "GLES user interfaces with 3D content: depth, stencil and 4x MSAA window surfaces",
+      "require surface_type&window renderable_type&OpenGL_ES2 depth_size>=16\n"
+      "prefer 100 config_caveat=none\n"
+      "prefer 30 samples=4\n"
+      "prefer 20 renderable_type&OpenGL_ES3\n"
+      "prefer 10 depth_size>=24\n"
+      "prefer 10 stencil_size>=8\n"
+      "prefer 5 red_size>=8 green_size>=8 blue_size>=8\n"
+      "cost 1\n" },
+    { "offscreen-compute", "GLES 3 rendering into pbuffers or FBOs without presenting: no ancillary buffers",
+      "require surface_type&pbuffer renderable_type&OpenGL_ES3\n"
+      "prefer 100 config_caveat=none\n"
+      "prefer 10 samples=0\n"
+      "prefer 10 depth_size=0 stencil_size=0\n"
+      "prefer 5 red_size=8 green_size=8 blue_size=8 alpha_size=8\n"
+      "cost 2\n" },
+};
+
+}
+
+bool parseProfile(const char* text, Profile* profile, std::string* errorMessage)
+{
+    profile->requirements.clear();
+    profile->preferences.clear();
+    profile->costWeight = 0;
+
+    int lineNumber = 0;
+    for (const char *line = text; *line;) {
+        const char *end = strchr(line, '\n');
+        if (!end)
+            end = line + strlen(line);
+        const std::string clause(line, end);
+        line = *end ? end + 1 : end;
+        ++lineNumber;
+
+        const size_t start = clause.find_first_not_of(" \t");
+        if (start == std::string::npos || clause[start] == '#')
+            continue;
+        const size_t keywordEnd = clause.find_first_of(" \t", start);
+        const std::string keyword = clause.substr(start, keywordEnd - start);
+        const std::string rest = keywordEnd == std::string::npos ? std::string() : clause.substr(keywordEnd);
+
+        std::string error;
+        if (keyword == "require") {
+            Query terms;
+            if (!parseQuery(rest.c_str(), &terms, &error)) {
+                *errorMessage = "line " + std::to_string(lineNumber) + ": " + error;
+                return false;
+            }
+            profile->requirements.insert(profile->requirements.end(), terms.begin(), terms.end());
+        } else if (keyword == "prefer" || keyword == "cost") {
+            char *weightEnd = nullptr;
+            const long weight = strtol(rest.c_str(), &weightEnd, 10);
+            if (weightEnd == rest.c_str()) {
+                *errorMessage = "line " + std::to_string(lineNumber) + ": missing weight";
+                return false;
+            }
+            if (keyword == "cost") {
+                profile->costWeight = static_cast<int>(weight);
+                continue;
+            }
+            Profile::Preference preference;
+            preference.weight = static_cast<int>(weight);
+            if (!parseQuery(weightEnd, &preference.terms, &error) || preference.terms.empty()) {
+                *errorMessage = "line " + std::to_string(lineNumber) + ": " + (error.empty() ? "missing terms" : error);
+                return false;
+            }
+            profile->preferences.push_back(std::move(preference));
+        } else {
+            *errorMessage = "line " + std::to_string(lineNumber) + ": unknown clause \"" + keyword + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::vector<Profile>& builtinProfiles()
+{
+    static const std::vector<Profile> profiles = [] {
+        std::vector<Profile> result;
+        for (const BuiltinProfile &builtin : builtins) {
+            Profile profile;
+            profile.name = builtin.name;
+            profile.description = builtin.description;
+            std::string error;
+            if (parseProfile(builtin.clauses, &profile, &error))
+                result.push_back(std::move(profile));
+        }
+        return result;
+    }();
+    return profiles;
+}
+
+const Profile* findProfile(const std::string& name)
+{
+    for (const Profile &profile : builtinProfiles()) {
+        if (profile.name == name)
+            return &profile;
+    }
+    return nullptr;
+}
+
+Recommendation recommendConfig(const Profile& profile, const std::vector<ConfigInfo>& configs, const char* displayExtensions)
+{
+    Recommendation best;
+    EGLint bestId = 0;
+    for (int i = 0; i < static_cast<int>(configs.size()); ++i) {
+        const ConfigInfo &config = configs[i];
+        if (!matchesConfig(profile.requirements, config, displayExtensions))
+            continue;
+
+        int64_t score = -int64_t(profile.costWeight) * bytesPerPixel(config);
+        for (const Profile::Preference &preference : profile.preferences) {
+            if (matchesConfig(preference.terms, config, displayExtensions))
+                score += preference.weight;
+        }
+
+        const EGLint id = config.value(EGL_CONFIG_ID);
+        if (best.configIndex < 0 || score > best.score || (score == best.score && id < bestId)) {
+            best.configIndex = i;
+            best.score = score;
+            bestId = id;
+        }
+    }
+    return best;
+}
+
+}
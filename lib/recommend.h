@@ -0,0 +1,73 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_RECOMMEND_H
+#define EGLINFO_RECOMMEND_H
+
+#include "query.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/**
+ * Declarative description of a workload used to pick a config for it, written one clause per
+ * line (empty lines and lines starting with '#' are ignored):
+ *
+ *   require TERMS        all TERMS (query syntax, see QueryTerm) must match
+ *   prefer WEIGHT TERMS  configs matching all TERMS score WEIGHT points
+ *   cost WEIGHT          configs lose WEIGHT points per byte of color, depth and stencil
+ *                        storage per pixel, see bytesPerPixel()
+ *
+ * Of the configs meeting all requirements, the one with the highest score is recommended,
+ * ties going to the lower EGL_CONFIG_ID.
+ */
+struct Profile {
+    struct Preference {
+        int weight;
+        Query terms;
+    };
+
+    std::string name;
+    std::string description;
+    Query requirements;
+    std::vector<Preference> preferences;
+    int costWeight = 0;
+};
+
+/** Parses the clauses in @p text into @p profile; @p errorMessage names the offending line. */
+bool parseProfile(const char* text, Profile* profile, std::string* errorMessage);
+
+/** The profiles shipped with eglinfo: video-overlay, 3d-ui and offscreen-compute. */
+const std::vector<Profile>& builtinProfiles();
+
+/** Returns the built-in profile called @p name, or nullptr. */
+const Profile* findProfile(const std::string& name);
+
+struct Recommendation {
+    /** Index into the configs passed to recommendConfig(), -1 if no config qualifies. */
+    int configIndex = -1;
+    int64_t score = 0;
+};
+
+/** Scores all @p configs of a display with @p displayExtensions and returns the best. */
+Recommendation recommendConfig(const Profile& profile, const std::vector<ConfigInfo>& configs, const char* displayExtensions);
+
+}
+
+#endif
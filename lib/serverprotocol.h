@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_SERVERPROTOCOL_H
+#define EGLINFO_SERVERPROTOCOL_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+/*
+ * Wire format of the query socket served by eglinfo --serve.
+ *
+ * Every request and reply is a ServerMessageHeader followed by ServerMessageHeader::size
+ * payload bytes. Replies carry the type and tag of their request, so clients may pipeline
+ * requests on one connection; they are answered in order. All integers are in host byte
+ * order, the socket is local. Strings are a uint32_t length followed by that many bytes.
+ *
+ * Requests and their payloads:
+ * - ServerHello: none. Reply: uint32_t protocol version, uint32_t display count.
+ * - ServerDisplayInfo: uint32_t display. Reply: uint32_t config count, the vendor and the
+ *   display extensions as strings.
+ * - ServerFindConfigs: uint32_t display or ServerAllDisplays, uint32_t maximum number of
+ *   results (0 for all), then the query in eglinfo --filter syntax filling the rest of the
+ *   payload. Reply: uint32_t match count, then that many ServerMatch.
+ * - ServerConfigAttributes: uint32_t display, uint32_t config. Reply: ServerAttribute for
+ *   every attribute the probe retrieved.
+ *
+ * A reply with a status other than ServerOk has no payload, except for ServerBadQuery whose
+ * payload is the error message. Requests larger than ServerMaxRequestSize close the connection.
+ *
+ * This header must not depend on EGL, clients query the server without loading it.
+ */
+
+#define EGLINFO_SERVER_SOCKET_NAME "eglinfo.sock"
+
+namespace EglInfo {
+
+/**
+ * Returns the default socket path, EGLINFO_SERVER_SOCKET_NAME in $XDG_RUNTIME_DIR. That directory
+ * belongs to the user, so other users can neither bind the socket first nor replace it. Returns
+ * an empty string if XDG_RUNTIME_DIR is unset or relative, an explicit path is needed then.
+ */
+inline std::string defaultServerPath()
+{
+    const char *runtimeDir = getenv("XDG_RUNTIME_DIR");
+    if (!runtimeDir || runtimeDir[0] != '/')
+        return std::string();
+    return std::string(runtimeDir) + "/" EGLINFO_SERVER_SOCKET_NAME;
+}
+
+enum {
+    ServerProtocolVersion = 1,
+    ServerMaxRequestSize = 64 * 1024
+};
+
+enum ServerMessageType : uint16_t {
+    ServerHello = 1,
+    ServerDisplayInfo,
+    ServerFindConfigs,
+    ServerConfigAttributes
+};
+
+enum ServerStatus : uint16_t {
+    ServerOk = 0,
+    /** Unknown message type. */
+    ServerBadType,
+    /** The payload is too short for the message type. */
+    ServerBadRequest,
+    /** Display or config index out of range. */
+    ServerBadIndex,
+    ServerBadQuery
+};
+
+static const uint32_t ServerAllDisplays = 0xffffffff;
+
+struct ServerMessageHeader {
+    /** Payload bytes following the header. */
+    uint32_t size;
+    uint16_t type;
+    /** ServerStatus of a reply, 0 in requests. */
+    uint16_t status;
+    /** Chosen by the client, echoed in the reply. */
+    uint32_t tag;
+};
+
+struct ServerMatch {
+    uint32_t display;
+    uint32_t config;
+    /** See EglInfo::configFingerprint(). */
+    uint64_t fingerprint;
+};
+
+struct ServerAttribute {
+    int32_t attribute;
+    int32_t value;
+};
+
+}
+
+#endif
@@ -0,0 +1,329 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "shaderbench.h"
+#include "glfunctions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include <unistd.h>
+
+namespace EglInfo {
+
+ShaderBenchmark::ShaderBenchmark()
+    : state(Ok)
+    , contextState(ContextInfo::Ok)
+    , api(EGL_NONE)
+    , language("")
+    , blobCache(false)
+    , cacheStores(0)
+    , cacheHits(0)
+{
+}
+
+// written in the common subset of GLSL ES 1.00 and GLSL 1.20
+struct CorpusProgram {
+    const char* name;
+    const char* vertex;
+    const char* fragment;
+};
+
+static const char quadVertex[] =
+    "attribute vec2 position;\n"
+    "attribute vec2 texCoord;\n"
+    "uniform mat4 transform;\n"
+    "varying vec2 v_texCoord;\n"
+    "void main()\n"
+    "{\n"
+    "    v_texCoord = texCoord;\n"
+    "    gl_Position = transform * vec4(position, 0.0, 1.0);\n"
+    "}\n";
+
+static const CorpusProgram corpus[] = {
+    { "textured-quad", quadVertex,
+      "uniform sampler2D source;\n"
+      "uniform lowp float opacity;\n"
+      "varying vec2 v_texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "    gl_FragColor = texture2D(source, v_texCoord) * opacity;\n"
+      "}\n" },
+    { "gaussian-blur", quadVertex,
+      "uniform sampler2D source;\n"
+      "uniform vec2 step;\n"
+      "uniform float weights[5];\n"
+      "varying vec2 v_texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "    vec4 sum = texture2D(source, v_texCoord) * weights[0];\n"
+      "    for (int i = 1; i < 5; ++i) {\n"
+      "        vec2 offset = step * float(i);\n"
+      "        sum += (texture2D(source, v_texCoord + offset) + texture2D(source, v_texCoord - offset)) * weights[i];\n"
+      "    }\n"
+      "    gl_FragColor = sum;\n"
+      "}\n" },
+    { "yuv-video", quadVertex,
+      "uniform sampler2D lumaTexture;\n"
+      "uniform sampler2D chromaTexture;\n"
+      "uniform mat3 colorMatrix;\n"
+      "uniform vec3 offset;\n"
+      "uniform float opacity;\n"
+      "varying vec2 v_texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "    vec3 yuv = vec3(texture2D(lumaTexture, v_texCoord).r, texture2D(chromaTexture, v_texCoord).rg) - offset;\n"
+      "    gl_FragColor = vec4(clamp(colorMatrix * yuv, 0.0, 1.0), 1.0) * opacity;\n"
+      "}\n" },
+    { "normal-mapped-phong",
+      "attribute vec3 position;\n"
+      "attribute vec3 normal;\n"
+      "attribute vec3 tangent;\n"
+      "attribute vec2 texCoord;\n"
+      "uniform mat4 modelViewProjection;\n"
+      "uniform mat4 model;\n"
+      "uniform mat3 normalMatrix;\n"
+      "varying vec3 v_position;\n"
+      "varying vec3 v_normal;\n"
+      "varying vec3 v_tangent;\n"
+      "varying vec2 v_texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "    v_position = (model * vec4(position, 1.0)).xyz;\n"
+      "    v_normal = normalize(normalMatrix * normal);\n"
+      "    v_tangent = normalize(normalMatrix * tangent);\n"
+      "    v_texCoord = texCoord;\n"
+      "    gl_Position = modelViewProjection * vec4(position, 1.0);\n"
+      "}\n",
+      "uniform sampler2D diffuseMap;\n"
+      "uniform sampler2D normalMap;\n"
+      "uniform vec3 lightPositions[4];\n"
+      "uniform vec3 lightColors[4];\n"
+      "uniform vec3 eyePosition;\n"
+      "uniform float shininess;\n"
+      "varying vec3 v_position;\n"
+      "varying vec3 v_normal;\n"
+      "varying vec3 v_tangent;\n"
+      "varying vec2 v_texCoord;\n"
+      "void main()\n"
+      "{\n"
+      "    vec3 n = normalize(v_normal);\n"
+      "    vec3 t = normalize(v_tangent - n * dot(n, v_tangent));\n"
+      "    n = normalize(mat3(t, cross(n, t), n) * (texture2D(normalMap, v_texCoord).xyz * 2.0 - 1.0));\n"
+      "    vec3 albedo = texture2D(diffuseMap, v_texCoord).rgb;\n"
+      "    vec3 v = normalize(eyePosition - v_position);\n"
+      "    vec3 color = vec3(0.0);\n"
+      "    for (int i = 0; i < 4; ++i) {\n"
+      "        vec3 l = lightPositions[i] - v_position;\n"
+      "        float attenuation = 1.0 / (1.0 + dot(l, l));\n"
+      "        l = normalize(l);\n"
+      "        float specular = pow(max(dot(n, normalize(l + v)), 0.0), shininess);\n"
+      "        color += lightColors[i] * attenuation * (albedo * max(dot(n, l), 0.0) + specular);\n"
+      "    }\n"
+      "    gl_FragColor = vec4(color, 1.0);\n"
+      "}\n" },
+    { "skinned-mesh",
+      "attribute vec3 position;\n"
+      "attribute vec3 normal;\n"
+      "attribute vec4 boneIndices;\n"
+      "attribute vec4 boneWeights;\n"
+      "uniform mat4 bones[32];\n"
+      "uniform mat4 viewProjection;\n"
+      "varying vec3 v_normal;\n"
+      "void main()\n"
+      "{\n"
+      "    mat4 skin = bones[int(boneIndices.x)] * boneWeights.x + bones[int(boneIndices.y)] * boneWeights.y\n"
+      "        + bones[int(boneIndices.z)] * boneWeights.z + bones[int(boneIndices.w)] * boneWeights.w;\n"
+      "    v_normal = normalize((skin * vec4(normal, 0.0)).xyz);\n"
+      "    gl_Position = viewProjection * skin * vec4(position, 1.0);\n"
+      "}\n",
+      "uniform vec3 lightDirection;\n"
+      "uniform vec3 color;\n"
+      "varying vec3 v_normal;\n"
+      "void main()\n"
+      "{\n"
+      "    gl_FragColor = vec4(color * (0.2 + 0.8 * max(dot(normalize(v_normal), -lightDirection), 0.0)), 1.0);\n"
+      "}\n" },
+};
+
+static const char esPrelude[] = "#version 100\nprecision mediump float;\n";
+static const char glPrelude[] = "#version 120\n#define lowp\n#define mediump\n#define highp\n";
+
+// EGL_ANDROID_blob_cache callbacks carry no user data, so there is one cache per process
+static std::mutex cacheMutex;
+static std::unordered_map<std::string, std::string> cache;
+static std::atomic<int> cacheStores(0);
+static std::atomic<int> cacheHits(0);
+
+static void EGLAPIENTRY setBlob(const void* key, EGLsizeiANDROID keySize, const void* value, EGLsizeiANDROID valueSize)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache[std::string(static_cast<const char*>(key), keySize)].assign(static_cast<const char*>(value), valueSize);
+    ++cacheStores;
+}
+
+static EGLsizeiANDROID getBlob(const void* key, EGLsizeiANDROID keySize, void* value, EGLsizeiANDROID valueSize)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    const auto it = cache.find(std::string(static_cast<const char*>(key), keySize));
+    if (it == cache.end())
+        return 0;
+    // drivers first ask for the size with a too small buffer
+    if (static_cast<size_t>(valueSize) >= it->second.size()) {
+        memcpy(value, it->second.data(), it->second.size());
+        ++cacheHits;
+    }
+    return it->second.size();
+}
+
+/** Installs the cache on @p display; the callbacks can only be set once per display. */
+static bool installBlobCache(const DisplayInfo& info)
+{
+    if (!hasExtension(info.extensions, "EGL_ANDROID_blob_cache"))
+        return false;
+    static const auto eglSetBlobCacheFuncsANDROID = reinterpret_cast<PFNEGLSETBLOBCACHEFUNCSANDROIDPROC>(eglGetProcAddress("eglSetBlobCacheFuncsANDROID"));
+    if (!eglSetBlobCacheFuncsANDROID)
+        return false;
+    static std::set<EGLDisplay> installed;
+    if (installed.count(info.display))
+        return true;
+    eglSetBlobCacheFuncsANDROID(info.display, setBlob, getBlob);
+    if (eglGetError() != EGL_SUCCESS)
+        return false;
+    installed.insert(info.display);
+    return true;
+}
+
+static int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string infoLog(const GL::ShaderFunctions& gl, GL::Uint object, bool program)
+{
+    GL::Int length = 0;
+    (program ? gl.GetProgramiv : gl.GetShaderiv)(object, GL::INFO_LOG_LENGTH, &length);
+    std::string log(std::max<GL::Int>(length, 1), '\0');
+    (program ? gl.GetProgramInfoLog : gl.GetShaderInfoLog)(object, log.size(), &length, &log[0]);
+    log.resize(std::max<GL::Int>(length, 0));
+    return log;
+}
+
+static GL::Uint compile(const GL::ShaderFunctions& gl, GL::Enum type, const char* const sources[3], LatencyHistogram* latency, std::string* log)
+{
+    const GL::Uint shader = gl.CreateShader(type);
+    gl.ShaderSource(shader, 3, sources, nullptr);
+    GL::Int status = 0;
+    // querying the status waits for drivers which compile on a background thread
+    const auto start = std::chrono::steady_clock::now();
+    gl.CompileShader(shader);
+    gl.GetShaderiv(shader, GL::COMPILE_STATUS, &status);
+    latency->add(elapsed(start));
+    if (!status) {
+        *log += infoLog(gl, shader, false);
+        gl.DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+/** Compiles and links @p program once with @p prelude and @p unique, returns false on errors. */
+static bool build(const GL::ShaderFunctions& gl, const CorpusProgram& program, const char* prelude, const std::string& unique,
+                  ShaderStageLatency* latency, std::string* log)
+{
+    const char* vertexSources[] = { prelude, unique.c_str(), program.vertex };
+    const char* fragmentSources[] = { prelude, unique.c_str(), program.fragment };
+    const GL::Uint vertex = compile(gl, GL::VERTEX_SHADER, vertexSources, &latency->vertex, log);
+    const GL::Uint fragment = compile(gl, GL::FRAGMENT_SHADER, fragmentSources, &latency->fragment, log);
+    bool ok = vertex && fragment;
+    if (ok) {
+        const GL::Uint object = gl.CreateProgram();
+        gl.AttachShader(object, vertex);
+        gl.AttachShader(object, fragment);
+        GL::Int status = 0;
+        const auto start = std::chrono::steady_clock::now();
+        gl.LinkProgram(object);
+        gl.GetProgramiv(object, GL::LINK_STATUS, &status);
+        latency->link.add(elapsed(start));
+        ok = status;
+        if (!ok)
+            *log += infoLog(gl, object, true);
+        gl.DeleteProgram(object);
+    }
+    if (vertex)
+        gl.DeleteShader(vertex);
+    if (fragment)
+        gl.DeleteShader(fragment);
+    return ok;
+}
+
+bool benchmarkShaders(const DisplayInfo& info, EGLenum api, int iterations, ShaderBenchmark* result)
+{
+    *result = ShaderBenchmark();
+    result->api = api;
+    // before the context exists, so the driver picks the cache up for it
+    result->blobCache = installBlobCache(info);
+
+    ScopedContext context(info, api);
+    if (!context.isCurrent()) {
+        result->state = ShaderBenchmark::ContextFailed;
+        result->contextState = context.state();
+        return false;
+    }
+    const GL::Functions &functions = GL::functions();
+    const GL::ShaderFunctions &gl = GL::shaderFunctions();
+    if (!functions.isValid() || !gl.isValid()) {
+        result->state = ShaderBenchmark::Unresolved;
+        return false;
+    }
+    if (const GL::Ubyte *version = functions.GetString(GL::VERSION))
+        result->version = reinterpret_cast<const char*>(version);
+
+    const bool es = api == EGL_OPENGL_ES_API;
+    const char *prelude = es ? esPrelude : glPrelude;
+    result->language = es ? "GLSL ES 1.00" : "GLSL 1.20";
+
+    const int storesBefore = cacheStores;
+    const int hitsBefore = cacheHits;
+    // unique per process and iteration, so neither earlier runs nor the driver's own disk cache help
+    const std::string run = "#define EGLINFO_RUN_" + std::to_string(getpid()) + "_"
+        + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_";
+    for (const CorpusProgram &program : corpus) {
+        result->programs.emplace_back();
+        ShaderProgramBenchmark &bench = result->programs.back();
+        bench.name = program.name;
+        bench.ok = true;
+        for (int i = 0; i < iterations && bench.ok; ++i) {
+            // programs share vertex shaders, which must not hit the driver's in-memory cache either
+            const std::string unique = run + std::to_string(result->programs.size()) + "_" + std::to_string(i) + "\n";
+            bench.ok = build(gl, program, prelude, unique, &bench.cold, &bench.log);
+            if (bench.ok && result->blobCache)
+                bench.ok = build(gl, program, prelude, unique, &bench.warm, &bench.log);
+        }
+    }
+    result->cacheStores = cacheStores - storesBefore;
+    result->cacheHits = cacheHits - hitsBefore;
+    return true;
+}
+
+}
@@ -0,0 +1,87 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_SHADERBENCH_H
+#define EGLINFO_SHADERBENCH_H
+
+#include "contextinfo.h"
+#include "latency.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/** Compile and link latencies of one program of the shader corpus. */
+struct ShaderStageLatency {
+    /** glCompileShader of the vertex shader until its compile status is known. */
+    LatencyHistogram vertex;
+    /** glCompileShader of the fragment shader until its compile status is known. */
+    LatencyHistogram fragment;
+    /** glLinkProgram until its link status is known. */
+    LatencyHistogram link;
+};
+
+struct ShaderProgramBenchmark {
+    const char* name;
+    /** False if a shader failed to compile or the program failed to link, see log. */
+    bool ok;
+    std::string log;
+    /** Sources never seen before by the driver. */
+    ShaderStageLatency cold;
+    /** The same sources again, served from EGL_ANDROID_blob_cache; empty without it. */
+    ShaderStageLatency warm;
+};
+
+/** Shader corpus latencies on one client API of a display, see benchmarkShaders(). */
+struct ShaderBenchmark {
+    enum State {
+        Ok,
+        ContextFailed,
+        Unresolved
+    } state;
+    /** Reason if state is ContextFailed. */
+    ContextInfo::State contextState;
+    EGLenum api;
+    /** GL_VERSION of the context. */
+    std::string version;
+    /** Shading language version the corpus was compiled as, e.g. "GLSL ES 1.00". */
+    const char* language;
+    /** True if a warm pass ran against the EGL_ANDROID_blob_cache cache. */
+    bool blobCache;
+    /** Binaries the driver stored into and found in the blob cache. */
+    int cacheStores;
+    int cacheHits;
+    std::vector<ShaderProgramBenchmark> programs;
+
+    ShaderBenchmark();
+};
+
+/**
+ * Compiles and links every program of the bundled shader corpus @p iterations times on a
+ * context of @p api on the initialized display @p info, surfaceless where possible. The corpus
+ * is written in GLSL ES 1.00 for GLES and GLSL 1.20 for GL, which every GLES 2 / GL 2.1 or later
+ * implementation accepts. Each iteration uses sources with a unique define so the driver cannot
+ * serve it from an earlier compile. If the display supports EGL_ANDROID_blob_cache, eglinfo
+ * installs an in-memory cache and every iteration is compiled a second time against it.
+ */
+bool benchmarkShaders(const DisplayInfo& info, EGLenum api, int iterations, ShaderBenchmark* result);
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_SNAPSHOT_H
+#define EGLINFO_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Fixed layout of the probe snapshot published to shared memory by eglinfo --publish.
+ *
+ * The mapping starts with a SnapshotHeader, followed by the display table, the config
+ * table, the fingerprint table, the DMA-BUF format and modifier tables, the recommendation
+ * table and the string table;
+ * all references are byte offsets from the start of the mapping, 0 meaning "not available". The last byte of the mapping is always 0, so
+ * strings are terminated even while a publish is in progress.
+ *
+ * Updates are protected by SnapshotHeader::sequence: the writer makes it odd before
+ * and even again after modifying the snapshot. Readers retry if it was odd or changed
+ * during the read. The mapping only ever grows.
+ *
+ * This header must not depend on EGL, consumers read the snapshot without loading it.
+ */
+
+#define EGLINFO_SNAPSHOT_DEFAULT_NAME "/eglinfo"
+
+namespace EglInfo {
+
+enum {
+    SnapshotVersion = 1,
+    SnapshotMaxAttributes = 32
+};
+
+static const char SnapshotMagic[8] = { 'E', 'G', 'L', 'I', 'N', 'F', 'O', '\0' };
+
+struct SnapshotConfig {
+    /** See EglInfo::configFingerprint(). */
+    uint64_t fingerprint;
+    /** Bit i is set if values[i] is valid. */
+    uint32_t validMask;
+    /** Indexed like SnapshotHeader::attributes. */
+    int32_t values[SnapshotMaxAttributes];
+};
+
+/** Entry of the fingerprint table, which has one entry per config sorted by fingerprint. */
+struct SnapshotFingerprint {
+    uint64_t fingerprint;
+    /** Global index into the config table. */
+    uint32_t config;
+    uint32_t reserved;
+};
+
+/** DMA-BUF format of a display, sorted by fourcc within the display. */
+struct SnapshotDmaBufFormat {
+    uint32_t fourcc;
+    /** Global index into the modifier table; the modifiers of a format are sorted. */
+    uint32_t firstModifier;
+    uint32_t modifierCount;
+    uint32_t reserved;
+};
+
+struct SnapshotDmaBufModifier {
+    uint64_t modifier;
+    uint32_t externalOnly;
+    uint32_t reserved;
+};
+
+/** Config recommended for a profile (see EglInfo::Profile) on a display, computed at publish time. */
+struct SnapshotRecommendation {
+    /** Offset of the profile name. */
+    uint32_t profile;
+    uint32_t displayIndex;
+    /** Global index into the config table, UINT32_MAX if no config qualifies. */
+    uint32_t config;
+    uint32_t reserved;
+    int64_t score;
+};
+
+struct SnapshotDisplay {
+    /** Index of the EGL device, -1 for the default display. */
+    int32_t deviceIndex;
+    /** EglInfo::DisplayInfo::State */
+    int32_t state;
+    int32_t majorVersion;
+    int32_t minorVersion;
+    uint32_t vendor;
+    uint32_t clientAPIs;
+    uint32_t extensions;
+    uint32_t deviceExtensions;
+    uint32_t firstConfig;
+    uint32_t configCount;
+    /** EglInfo::DmaBufFormats::State */
+    int32_t dmaBufState;
+    uint32_t firstDmaBufFormat;
+    uint32_t dmaBufFormatCount;
+    /** EglInfo::DeviceTopology::State */
+    int32_t topologyState;
+    /** NUMA node of the device, -1 if unknown. */
+    int32_t numaNode;
+    /** PCI address of the device, e.g. "0000:03:00.0". */
+    uint32_t pciAddress;
+    /** CPUs local to the device in sysfs list format, e.g. "0-15,32-47". */
+    uint32_t localCpus;
+    uint32_t renderNode;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    std::atomic<uint32_t> sequence;
+    uint32_t version;
+    /** Size of the mapping in bytes. */
+    uint32_t size;
+    uint32_t attributeCount;
+    /** CLOCK_REALTIME of the publish, in nanoseconds. */
+    int64_t timestamp;
+    uint32_t clientExtensions;
+    uint32_t displayCount;
+    uint32_t displaysOffset;
+    uint32_t configCount;
+    uint32_t configsOffset;
+    uint32_t fingerprintsOffset;
+    uint32_t dmaBufFormatCount;
+    uint32_t dmaBufFormatsOffset;
+    uint32_t dmaBufModifierCount;
+    uint32_t dmaBufModifiersOffset;
+    uint32_t recommendationCount;
+    uint32_t recommendationsOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    /** EGL attribute names of the config columns. */
+    int32_t attributes[SnapshotMaxAttributes];
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "snapshot sequence counter must be lock-free");
+
+}
+
+#endif
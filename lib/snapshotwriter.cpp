@@ -0,0 +1,255 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "snapshotwriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EglInfo {
+
+static_assert(int(AttributeCount) <= int(SnapshotMaxAttributes), "snapshot cannot hold all attributes");
+
+namespace {
+
+class SnapshotBuilder
+{
+public:
+    SnapshotBuilder()
+    {
+        // offset 0 is reserved for "not available"
+        m_strings.push_back('\0');
+    }
+
+    uint32_t addString(const char* str)
+    {
+        if (!str)
+            return 0;
+        const uint32_t offset = m_strings.size();
+        m_strings.append(str, strlen(str) + 1);
+        return offset;
+    }
+
+    uint32_t addString(const std::string& str)
+    {
+        return str.empty() ? 0 : addString(str.c_str());
+    }
+
+    void addDisplay(const DisplayInfo& info, int deviceIndex, const char* deviceExtensions, const DeviceTopology& topology)
+    {
+        SnapshotDisplay display;
+        memset(&display, 0, sizeof(display));
+        display.deviceIndex = deviceIndex;
+        display.state = info.state;
+        display.majorVersion = info.majorVersion;
+        display.minorVersion = info.minorVersion;
+        display.vendor = addString(info.vendor);
+        display.clientAPIs = addString(info.clientAPIs);
+        display.extensions = addString(info.extensions);
+        display.deviceExtensions = addString(deviceExtensions);
+        display.firstConfig = m_configs.size();
+        display.configCount = info.configs.size();
+        m_displayInfos.push_back(&info);
+        display.dmaBufState = info.dmaBufFormats.state;
+        display.firstDmaBufFormat = m_dmaBufFormats.size();
+        display.dmaBufFormatCount = info.dmaBufFormats.formats.size();
+        display.topologyState = topology.state;
+        display.numaNode = topology.numaNode;
+        display.pciAddress = addString(topology.pciAddress);
+        display.localCpus = addString(topology.localCpus);
+        display.renderNode = addString(topology.renderNode);
+        m_displays.push_back(display);
+
+        for (const DmaBufFormat &format : info.dmaBufFormats.formats) {
+            const uint32_t firstModifier = m_dmaBufModifiers.size();
+            m_dmaBufFormats.push_back(SnapshotDmaBufFormat{ format.fourcc, firstModifier, format.modifierCount, 0 });
+            for (uint32_t i = 0; i < format.modifierCount; ++i) {
+                const DmaBufModifier &modifier = info.dmaBufFormats.modifiers[format.firstModifier + i];
+                m_dmaBufModifiers.push_back(SnapshotDmaBufModifier{ modifier.modifier, modifier.externalOnly, 0 });
+            }
+        }
+
+        for (const ConfigInfo &info : info.configs) {
+            SnapshotConfig config;
+            memset(&config, 0, sizeof(config));
+            config.fingerprint = info.fingerprint();
+            config.validMask = info.validMask;
+            memcpy(config.values, info.values, sizeof(info.values));
+            m_configs.push_back(config);
+        }
+    }
+
+    std::vector<SnapshotDisplay> m_displays;
+    std::vector<const DisplayInfo*> m_displayInfos;
+    std::vector<SnapshotConfig> m_configs;
+    std::vector<SnapshotDmaBufFormat> m_dmaBufFormats;
+    std::vector<SnapshotDmaBufModifier> m_dmaBufModifiers;
+    std::string m_strings;
+};
+
+}
+
+bool publishSnapshot(const ProbeResult& result, const char* name, const std::vector<Profile>& profiles)
+{
+    SnapshotBuilder builder;
+    const uint32_t clientExtensions = builder.addString(result.clientExtensions);
+#ifdef EGL_EXT_device_base
+    for (int i = 0; i < static_cast<int>(result.devices.devices.size()); ++i) {
+        const DeviceInfo &device = result.devices.devices[i];
+        if (device.hasDisplay)
+            builder.addDisplay(device.display, i, device.extensions, device.topology);
+    }
+#endif
+    if (result.hasDefaultDisplay)
+        builder.addDisplay(result.defaultDisplay, -1, nullptr, DeviceTopology());
+
+    // answered once here, so applications only look up the result
+    std::vector<SnapshotRecommendation> recommendations;
+    for (const Profile &profile : profiles) {
+        const uint32_t profileName = builder.addString(profile.name.c_str());
+        for (uint32_t d = 0; d < builder.m_displays.size(); ++d) {
+            const DisplayInfo &info = *builder.m_displayInfos[d];
+            const Recommendation recommendation = recommendConfig(profile, info.configs, info.extensions);
+            const uint32_t config = recommendation.configIndex < 0 ? UINT32_MAX : builder.m_displays[d].firstConfig + recommendation.configIndex;
+            recommendations.push_back(SnapshotRecommendation{ profileName, d, config, 0, recommendation.score });
+        }
+    }
+
+    std::vector<SnapshotFingerprint> fingerprints(builder.m_configs.size());
+    for (size_t i = 0; i < fingerprints.size(); ++i)
+        fingerprints[i] = SnapshotFingerprint{ builder.m_configs[i].fingerprint, uint32_t(i), 0 };
+    std::sort(fingerprints.begin(), fingerprints.end(), [](const SnapshotFingerprint& a, const SnapshotFingerprint& b) {
+        return a.fingerprint < b.fingerprint;
+    });
+
+    // keep the tables 8 byte aligned for the 64 bit members
+    auto align = [](size_t offset) { return (offset + 7) & ~size_t(7); };
+    const size_t displaysOffset = align(sizeof(SnapshotHeader));
+    const size_t configsOffset = align(displaysOffset + builder.m_displays.size() * sizeof(SnapshotDisplay));
+    const size_t fingerprintsOffset = align(configsOffset + builder.m_configs.size() * sizeof(SnapshotConfig));
+    const size_t dmaBufFormatsOffset = align(fingerprintsOffset + fingerprints.size() * sizeof(SnapshotFingerprint));
+    const size_t dmaBufModifiersOffset = align(dmaBufFormatsOffset + builder.m_dmaBufFormats.size() * sizeof(SnapshotDmaBufFormat));
+    const size_t recommendationsOffset = align(dmaBufModifiersOffset + builder.m_dmaBufModifiers.size() * sizeof(SnapshotDmaBufModifier));
+    const size_t stringsOffset = recommendationsOffset + recommendations.size() * sizeof(SnapshotRecommendation);
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    // one extra byte for the terminating 0 at the end of the mapping
+    const size_t needed = (stringsOffset + builder.m_strings.size() + 1 + pageSize - 1) / pageSize * pageSize;
+    if (needed > UINT32_MAX) {
+        errno = EFBIG;
+        return false;
+    }
+
+    const int fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return false;
+
+    // serializes concurrent publishers, readers never take the lock
+    if (flock(fd, LOCK_EX) != 0) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (static_cast<size_t>(st.st_size) < needed && ftruncate(fd, needed) != 0)) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return false;
+    }
+    const size_t size = std::max<size_t>(st.st_size, needed);
+
+    void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        const int error = errno;
+        close(fd);
+        errno = error;
+        return false;
+    }
+
+    char *base = static_cast<char*>(data);
+    SnapshotHeader *header = static_cast<SnapshotHeader*>(data);
+    uint32_t sequence = 0;
+    if (memcmp(header->magic, SnapshotMagic, sizeof(SnapshotMagic)) == 0)
+        sequence = header->sequence.load(std::memory_order_relaxed);
+    // already odd if a previous publisher died mid-update
+    sequence |= 1;
+    header->sequence.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(header->magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header->version = SnapshotVersion;
+    header->size = size;
+    header->attributeCount = attributesSize;
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    header->timestamp = static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    header->clientExtensions = clientExtensions ? stringsOffset + clientExtensions : 0;
+    header->displayCount = builder.m_displays.size();
+    header->displaysOffset = displaysOffset;
+    header->configCount = builder.m_configs.size();
+    header->configsOffset = configsOffset;
+    header->fingerprintsOffset = fingerprintsOffset;
+    header->dmaBufFormatCount = builder.m_dmaBufFormats.size();
+    header->dmaBufFormatsOffset = dmaBufFormatsOffset;
+    header->dmaBufModifierCount = builder.m_dmaBufModifiers.size();
+    header->dmaBufModifiersOffset = dmaBufModifiersOffset;
+    header->recommendationCount = recommendations.size();
+    header->recommendationsOffset = recommendationsOffset;
+    header->stringsOffset = stringsOffset;
+    header->stringsSize = builder.m_strings.size();
+    for (int i = 0; i < SnapshotMaxAttributes; ++i)
+        header->attributes[i] = i < attributesSize ? attributes[i].attribute : EGL_NONE;
+
+    // string references are relative to the string table while building
+    for (SnapshotDisplay &display : builder.m_displays) {
+        for (uint32_t *str : { &display.vendor, &display.clientAPIs, &display.extensions, &display.deviceExtensions,
+                               &display.pciAddress, &display.localCpus, &display.renderNode }) {
+            if (*str)
+                *str += stringsOffset;
+        }
+    }
+    memcpy(base + displaysOffset, builder.m_displays.data(), builder.m_displays.size() * sizeof(SnapshotDisplay));
+    memcpy(base + configsOffset, builder.m_configs.data(), builder.m_configs.size() * sizeof(SnapshotConfig));
+    memcpy(base + fingerprintsOffset, fingerprints.data(), fingerprints.size() * sizeof(SnapshotFingerprint));
+    memcpy(base + dmaBufFormatsOffset, builder.m_dmaBufFormats.data(), builder.m_dmaBufFormats.size() * sizeof(SnapshotDmaBufFormat));
+    memcpy(base + dmaBufModifiersOffset, builder.m_dmaBufModifiers.data(), builder.m_dmaBufModifiers.size() * sizeof(SnapshotDmaBufModifier));
+    for (SnapshotRecommendation &recommendation : recommendations)
+        recommendation.profile += stringsOffset;
+    memcpy(base + recommendationsOffset, recommendations.data(), recommendations.size() * sizeof(SnapshotRecommendation));
+    memcpy(base + stringsOffset, builder.m_strings.data(), builder.m_strings.size());
+    memset(base + stringsOffset + builder.m_strings.size(), 0, size - stringsOffset - builder.m_strings.size());
+
+    header->sequence.store(sequence + 1, std::memory_order_release);
+
+    munmap(data, size);
+    close(fd);
+    return true;
+}
+
+}
@@ -0,0 +1,37 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_SNAPSHOTWRITER_H
+#define EGLINFO_SNAPSHOTWRITER_H
+
+#include "probe.h"
+#include "recommend.h"
+#include "snapshot.h"
+
+namespace EglInfo {
+
+/**
+ * Publishes @p result as a snapshot in the POSIX shared memory object @p name,
+ * updating an existing snapshot in place. The recommended config of each display for each of
+ * @p profiles is stored along with it. Returns false and leaves errno set on failure.
+ */
+bool publishSnapshot(const ProbeResult& result, const char* name = EGLINFO_SNAPSHOT_DEFAULT_NAME,
+                     const std::vector<Profile>& profiles = builtinProfiles());
+
+}
+
+#endif
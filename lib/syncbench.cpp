@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "syncbench.h"
+
+#include <chrono>
+
+#include <unistd.h>
+
+namespace EglInfo {
+
+SyncBenchmark::SyncBenchmark()
+    : state(Ok)
+    , contextState(ContextInfo::Ok)
+    , api(EGL_NONE)
+{
+}
+
+static int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool benchmarkSync(const DisplayInfo& info, int iterations, SyncBenchmark* result)
+{
+    *result = SyncBenchmark();
+    if (!hasExtension(info.extensions, "EGL_KHR_fence_sync")) {
+        result->state = SyncBenchmark::Unsupported;
+        return false;
+    }
+
+    static const auto eglCreateSyncKHR = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+    static const auto eglDestroySyncKHR = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+    static const auto eglClientWaitSyncKHR = reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+    static const auto eglWaitSyncKHR = reinterpret_cast<PFNEGLWAITSYNCKHRPROC>(eglGetProcAddress("eglWaitSyncKHR"));
+    static const auto eglDupNativeFenceFDANDROID = reinterpret_cast<PFNEGLDUPNATIVEFENCEFDANDROIDPROC>(eglGetProcAddress("eglDupNativeFenceFDANDROID"));
+    if (!eglCreateSyncKHR || !eglDestroySyncKHR || !eglClientWaitSyncKHR) {
+        result->state = SyncBenchmark::Unresolved;
+        return false;
+    }
+    const bool serverWait = eglWaitSyncKHR && hasExtension(info.extensions, "EGL_KHR_wait_sync");
+    const bool nativeFence = eglDupNativeFenceFDANDROID && hasExtension(info.extensions, "EGL_ANDROID_native_fence_sync");
+
+    // fences are inserted into the command stream of the current context
+    result->api = preferredApi(info);
+    ScopedContext context(info, result->api);
+    if (!context.isCurrent()) {
+        result->state = SyncBenchmark::ContextFailed;
+        result->contextState = context.state();
+        return false;
+    }
+
+    const EGLDisplay display = info.display;
+    result->clientWait.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        EGLSyncKHR sync = eglCreateSyncKHR(display, EGL_SYNC_FENCE_KHR, nullptr);
+        if (sync == EGL_NO_SYNC_KHR) {
+            result->state = SyncBenchmark::SyncFailed;
+            return false;
+        }
+        const EGLint status = eglClientWaitSyncKHR(display, sync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, EGL_FOREVER_KHR);
+        result->clientWait.add(elapsed(start));
+        eglDestroySyncKHR(display, sync);
+        if (status != EGL_CONDITION_SATISFIED_KHR) {
+            result->state = SyncBenchmark::SyncFailed;
+            return false;
+        }
+    }
+
+    if (serverWait) {
+        result->serverWait.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            EGLSyncKHR sync = eglCreateSyncKHR(display, EGL_SYNC_FENCE_KHR, nullptr);
+            if (sync == EGL_NO_SYNC_KHR)
+                break;
+            const EGLint ok = eglWaitSyncKHR(display, sync, 0);
+            result->serverWait.add(elapsed(start));
+            eglDestroySyncKHR(display, sync);
+            if (!ok)
+                break;
+        }
+    }
+
+    if (nativeFence) {
+        result->nativeFence.reserve(iterations);
+        for (int i = 0; i < iterations; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            EGLSyncKHR sync = eglCreateSyncKHR(display, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
+            if (sync == EGL_NO_SYNC_KHR)
+                break;
+            // the fence fd only exists once the fence was flushed
+            eglClientWaitSyncKHR(display, sync, EGL_SYNC_FLUSH_COMMANDS_BIT_KHR, 0);
+            const int fd = eglDupNativeFenceFDANDROID(display, sync);
+            result->nativeFence.add(elapsed(start));
+            eglDestroySyncKHR(display, sync);
+            if (fd < 0)
+                break;
+            close(fd);
+        }
+    }
+
+    return true;
+}
+
+}
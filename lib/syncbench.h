@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_SYNCBENCH_H
+#define EGLINFO_SYNCBENCH_H
+
+#include "contextinfo.h"
+#include "latency.h"
+
+namespace EglInfo {
+
+/** Fence sync round trip latencies of one display, see benchmarkSync(). */
+struct SyncBenchmark {
+    enum State {
+        Ok,
+        Unsupported,
+        Unresolved,
+        ContextFailed,
+        SyncFailed
+    } state;
+    /** Reason if state is ContextFailed. */
+    ContextInfo::State contextState;
+    EGLenum api;
+    /** eglCreateSyncKHR(EGL_SYNC_FENCE_KHR) followed by a flushing eglClientWaitSyncKHR. */
+    LatencyHistogram clientWait;
+    /** eglCreateSyncKHR followed by eglWaitSyncKHR, empty without EGL_KHR_wait_sync. */
+    LatencyHistogram serverWait;
+    /** Native fence creation, flush and eglDupNativeFenceFDANDROID, empty without EGL_ANDROID_native_fence_sync. */
+    LatencyHistogram nativeFence;
+
+    SyncBenchmark();
+};
+
+/**
+ * Measures the fence sync round trip latency on the initialized display @p info over
+ * @p iterations iterations, on a surfaceless context where possible. Requires EGL_KHR_fence_sync.
+ */
+bool benchmarkSync(const DisplayInfo& info, int iterations, SyncBenchmark* result);
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "timeline.h"
+
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace EglInfo {
+
+namespace {
+
+struct Span {
+    const char* name;
+    std::string detail;
+    int64_t start;
+    int64_t duration;
+    long tid;
+};
+
+struct Timeline {
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    std::mutex mutex;
+    std::vector<Span> spans;
+};
+
+std::atomic<Timeline*> timeline(nullptr);
+
+}
+
+void startTimeline()
+{
+    // never freed, spans may still end while the process exits
+    if (!timeline.load())
+        timeline = new Timeline;
+}
+
+bool isTimelineEnabled()
+{
+    return timeline.load(std::memory_order_relaxed) != nullptr;
+}
+
+TimelineSpan::TimelineSpan(const char* name, const std::string& detail)
+    : m_name(nullptr)
+{
+    if (!isTimelineEnabled())
+        return;
+    m_name = name;
+    m_detail = detail;
+    m_start = std::chrono::steady_clock::now();
+}
+
+TimelineSpan::~TimelineSpan()
+{
+    if (!m_name)
+        return;
+    const auto end = std::chrono::steady_clock::now();
+    Timeline *t = timeline.load(std::memory_order_relaxed);
+    const Span span = {
+        m_name,
+        std::move(m_detail),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(m_start - t->origin).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count(),
+        syscall(SYS_gettid)
+    };
+    std::lock_guard<std::mutex> lock(t->mutex);
+    t->spans.push_back(span);
+}
+
+static void writeJsonString(FILE* file, const char* str)
+{
+    fputc('"', file);
+    for (; *str; ++str) {
+        const unsigned char c = *str;
+        if (c == '"' || c == '\\')
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+bool writeTimeline(const char* path)
+{
+    Timeline *t = timeline.load();
+    if (!t)
+        return true;
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    std::lock_guard<std::mutex> lock(t->mutex);
+    const long pid = getpid();
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%ld,\"args\":{\"name\":\"eglinfo\"}}", pid, pid);
+    // timestamps are in microseconds, keep nanosecond resolution
+    for (const Span &span : t->spans) {
+        fprintf(file, ",\n{\"name\":");
+        writeJsonString(file, span.name);
+        fprintf(file, ",\"cat\":\"probe\",\"ph\":\"X\",\"pid\":%ld,\"tid\":%ld,\"ts\":%lld.%03lld,\"dur\":%lld.%03lld",
+                pid, span.tid, static_cast<long long>(span.start / 1000), static_cast<long long>(span.start % 1000),
+                static_cast<long long>(span.duration / 1000), static_cast<long long>(span.duration % 1000));
+        if (!span.detail.empty()) {
+            fprintf(file, ",\"args\":{\"detail\":");
+            writeJsonString(file, span.detail.c_str());
+            fputc('}', file);
+        }
+        fputc('}', file);
+    }
+    fprintf(file, "\n]}\n");
+    const bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_TIMELINE_H
+#define EGLINFO_TIMELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace EglInfo {
+
+/**
+ * Probe timeline for trace viewers. Recording is off until startTimeline() is called; until
+ * then a TimelineSpan costs one relaxed atomic load.
+ */
+void startTimeline();
+bool isTimelineEnabled();
+
+/**
+ * Writes the spans recorded so far to @p path as Chrome trace-event JSON, which
+ * chrome://tracing and Perfetto load. Returns false and leaves errno set on failure.
+ */
+bool writeTimeline(const char* path);
+
+/** Records the time between construction and destruction on the calling thread. */
+class TimelineSpan
+{
+public:
+    /** @p name must outlive the timeline, e.g. a string literal. @p detail is shown as argument. */
+    explicit TimelineSpan(const char* name, const std::string& detail = std::string());
+    ~TimelineSpan();
+
+    TimelineSpan(const TimelineSpan&) = delete;
+    TimelineSpan& operator=(const TimelineSpan&) = delete;
+
+private:
+    const char* m_name;
+    std::string m_detail;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}
+
+#endif
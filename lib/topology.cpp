@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "topology.h"
+
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <dirent.h>
+
+namespace EglInfo {
+
+/** Returns the first line of @p path, or an empty string if it cannot be read. */
+static std::string readLine(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+/** Returns true for domain:bus:device.function, e.g. "0000:03:00.0". */
+static bool isPciAddress(const std::string& name)
+{
+    static const char pattern[] = "xxxx:xx:xx.x";
+    if (name.size() != sizeof(pattern) - 1)
+        return false;
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (pattern[i] == 'x' ? !isxdigit(static_cast<unsigned char>(name[i])) : name[i] != pattern[i])
+            return false;
+    }
+    return true;
+}
+
+bool queryDeviceTopology(const char* drmDeviceFile, const std::string& sysfsRoot, DeviceTopology* topology)
+{
+    *topology = DeviceTopology();
+    if (!drmDeviceFile || !*drmDeviceFile) {
+        topology->state = DeviceTopology::NoDrmDevice;
+        return false;
+    }
+
+    const char *name = strrchr(drmDeviceFile, '/');
+    name = name ? name + 1 : drmDeviceFile;
+    char resolved[PATH_MAX];
+    if (!realpath((sysfsRoot + "/class/drm/" + name + "/device").c_str(), resolved)) {
+        topology->state = DeviceTopology::NotFound;
+        return false;
+    }
+    const std::string device = resolved;
+
+    const std::string busId = device.substr(device.rfind('/') + 1);
+    if (isPciAddress(busId))
+        topology->pciAddress = busId;
+    const std::string numaNode = readLine(device + "/numa_node");
+    if (!numaNode.empty())
+        topology->numaNode = atoi(numaNode.c_str());
+    topology->localCpus = readLine(device + "/local_cpulist");
+
+    // the card and render nodes of a device are siblings below its drm directory
+    if (DIR *dir = opendir((device + "/drm").c_str())) {
+        while (dirent *entry = readdir(dir)) {
+            if (strncmp(entry->d_name, "renderD", 7) == 0) {
+                topology->renderNode = std::string("/dev/dri/") + entry->d_name;
+                break;
+            }
+        }
+        closedir(dir);
+    }
+
+    topology->state = DeviceTopology::Ok;
+    return true;
+}
+
+}
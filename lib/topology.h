@@ -0,0 +1,55 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_TOPOLOGY_H
+#define EGLINFO_TOPOLOGY_H
+
+#include <string>
+
+namespace EglInfo {
+
+/** Where an EGL device sits in the machine, read from sysfs, see queryDeviceTopology(). */
+struct DeviceTopology {
+    enum State {
+        NotQueried,
+        /** The device has no DRM device file (no EGL_EXT_device_drm). */
+        NoDrmDevice,
+        /** The DRM device file is not known to sysfs. */
+        NotFound,
+        Ok
+    } state = NotQueried;
+    /** PCI address, e.g. "0000:03:00.0"; empty for devices on other buses. */
+    std::string pciAddress;
+    /** NUMA node of the device, -1 if unknown or the machine is not NUMA. */
+    int numaNode = -1;
+    /** CPUs local to the device in sysfs list format, e.g. "0-15,32-47"; empty if unknown. */
+    std::string localCpus;
+    /** Render node of the device, e.g. "/dev/dri/renderD128"; empty if it has none. */
+    std::string renderNode;
+};
+
+/**
+ * Maps the DRM device file @p drmDeviceFile (e.g. "/dev/dri/card0") to its PCI address, NUMA node,
+ * local CPUs and render node through the sysfs tree mounted at @p sysfsRoot. The mapping goes by
+ * device name via class/drm, so a fake tree without device numbers works as well.
+ */
+bool queryDeviceTopology(const char* drmDeviceFile, const std::string& sysfsRoot, DeviceTopology* topology);
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_TRACEPOINTS_H
+#define EGLINFO_TRACEPOINTS_H
+
+/*
+ * USDT tracepoints of provider "eglinfo" for perf, bpftrace and SystemTap, e.g.
+ *
+ *   bpftrace -e 'usdt:./eglinfo:eglinfo:egl_call_return { @[str(arg0)] = count(); }'
+ *
+ * An unattached tracepoint is a single nop; its arguments are only evaluated into registers
+ * or stack slots. They are compiled in when <sys/sdt.h> is available (systemtap-sdt-dev) and
+ * EGLINFO_NO_USDT is not defined (CONFIG += no_usdt), and generate no code otherwise.
+ *
+ * Tracepoints and their arguments; "display" and "device" are the EGL handles:
+ * - probe_entry, probe_return
+ * - device_entry(index), device_return(index, hasDisplay) around probing each EGL device
+ * - display_for_device_entry(device), display_for_device_return(device, display)
+ * - probe_display_entry(display), probe_display_return(display, DisplayInfo::State)
+ * - egl_call_entry(function name, display), egl_call_return(function name, display, result)
+ *   around the EGL calls of the probe, except for eglGetConfigAttrib
+ * - config_entry(display, config index), config_return(display, config index, valid mask)
+ *   around each iteration of the config attribute loop
+ * - get_config_attrib_entry(display, config index, attribute),
+ *   get_config_attrib_return(display, config index, attribute, value, result)
+ * - print_devices_entry(device count), print_devices_return
+ * - print_display_entry(display), print_display_return(display)
+ */
+
+#if !defined(EGLINFO_NO_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define EGLINFO_HAVE_USDT 1
+#endif
+#endif
+
+#ifdef EGLINFO_HAVE_USDT
+#define EGLINFO_TRACE0(name) DTRACE_PROBE(eglinfo, name)
+#define EGLINFO_TRACE1(name, a) DTRACE_PROBE1(eglinfo, name, a)
+#define EGLINFO_TRACE2(name, a, b) DTRACE_PROBE2(eglinfo, name, a, b)
+#define EGLINFO_TRACE3(name, a, b, c) DTRACE_PROBE3(eglinfo, name, a, b, c)
+#define EGLINFO_TRACE5(name, a, b, c, d, e) DTRACE_PROBE5(eglinfo, name, a, b, c, d, e)
+#else
+// the arguments stay unevaluated, but count as used
+#define EGLINFO_TRACE0(name) ((void)0)
+#define EGLINFO_TRACE1(name, a) ((void)sizeof(a))
+#define EGLINFO_TRACE2(name, a, b) ((void)sizeof(a), (void)sizeof(b))
+#define EGLINFO_TRACE3(name, a, b, c) ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c))
+#define EGLINFO_TRACE5(name, a, b, c, d, e) ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c), (void)sizeof(d), (void)sizeof(e))
+#endif
+
+#endif
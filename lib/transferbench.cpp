@@ -0,0 +1,297 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "transferbench.h"
+#include "glfunctions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace EglInfo {
+
+TransferBenchmark::TransferBenchmark()
+    : state(Ok)
+    , contextState(ContextInfo::Ok)
+    , api(EGL_NONE)
+    , pixelBuffers(false)
+{
+}
+
+double TransferMeasurement::throughput() const
+{
+    if (latency.isEmpty())
+        return 0;
+    // bytes per nanosecond are gigabytes per second
+    return static_cast<double>(bytes) / std::max<int64_t>(1, latency.percentile(50));
+}
+
+const char* transferPathName(TransferMeasurement::Path path)
+{
+    switch (path) {
+        case TransferMeasurement::ReadPixels:
+            return "glReadPixels";
+        case TransferMeasurement::PixelBufferReadback:
+            return "PBO readback";
+        case TransferMeasurement::Upload:
+            return "glTexSubImage2D";
+    }
+    return "unknown";
+}
+
+struct PixelFormat {
+    const char* name;
+    GL::Enum internalFormat;
+    GL::Enum format;
+    GL::Enum type;
+    int bytesPerPixel;
+};
+
+static const PixelFormat uploadFormats[] = {
+    { "RGBA8", GL::RGBA, GL::RGBA, GL::UNSIGNED_BYTE, 4 },
+    { "RGB565", GL::RGB, GL::RGB, GL::UNSIGNED_SHORT_5_6_5, 2 },
+    // GL_RED needs GLES 3.0, luminance works on GLES 2.0 and compatibility contexts
+    { "L8", GL::LUMINANCE, GL::LUMINANCE, GL::UNSIGNED_BYTE, 1 }
+};
+
+// readback always works on an RGBA8 framebuffer, see preferredReadFormat() for the other one
+static const PixelFormat readFormat = uploadFormats[0];
+
+static const struct {
+    int width;
+    int height;
+} sizes[] = {
+    { 256, 256 },
+    { 1280, 720 },
+    { 1920, 1080 },
+    { 3840, 2160 }
+};
+
+static int64_t elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void clearErrors(const GL::Functions& functions)
+{
+    // bounded, a lost context may report errors forever
+    for (int i = 0; i < 16 && functions.GetError() != GL::NO_ERROR; ++i) {
+    }
+}
+
+/** Returns the major * 10 + minor version of a GL_VERSION string, e.g. 32 for "OpenGL ES 3.2 Mesa". */
+static int parseVersion(const std::string& version)
+{
+    const size_t digit = version.find_first_of("0123456789");
+    int major = 0;
+    int minor = 0;
+    if (digit == std::string::npos || sscanf(version.c_str() + digit, "%d.%d", &major, &minor) != 2)
+        return 0;
+    return major * 10 + minor;
+}
+
+/**
+ * Returns the implementation's preferred readback format of the bound framebuffer if it differs
+ * from RGBA8 and eglinfo knows its pixel size.
+ */
+static bool preferredReadFormat(const GL::Functions& functions, PixelFormat* result)
+{
+    GL::Int format = 0;
+    GL::Int type = 0;
+    functions.GetIntegerv(GL::IMPLEMENTATION_COLOR_READ_FORMAT, &format);
+    functions.GetIntegerv(GL::IMPLEMENTATION_COLOR_READ_TYPE, &type);
+    // not queryable before GL 4.1 without GL_ARB_ES2_compatibility
+    if (functions.GetError() != GL::NO_ERROR)
+        return false;
+    if (static_cast<GL::Enum>(format) == readFormat.format && static_cast<GL::Enum>(type) == readFormat.type)
+        return false;
+
+    *result = PixelFormat{ nullptr, GL::RGBA, static_cast<GL::Enum>(format), static_cast<GL::Enum>(type), 0 };
+    if (result->format == GL::BGRA && result->type == GL::UNSIGNED_BYTE)
+        *result = PixelFormat{ "BGRA8", GL::RGBA, GL::BGRA, GL::UNSIGNED_BYTE, 4 };
+    else if (result->format == GL::RGB && result->type == GL::UNSIGNED_BYTE)
+        *result = PixelFormat{ "RGB8", GL::RGBA, GL::RGB, GL::UNSIGNED_BYTE, 3 };
+    else if (result->format == GL::RGB && result->type == GL::UNSIGNED_SHORT_5_6_5)
+        *result = PixelFormat{ "RGB565", GL::RGBA, GL::RGB, GL::UNSIGNED_SHORT_5_6_5, 2 };
+    return result->name;
+}
+
+/**
+ * Runs @p transfer once untimed, which also catches GL errors, then @p iterations times into
+ * measurement->latency. @p transfer gets whether the call is timed.
+ */
+template <typename Transfer>
+static void measure(const GL::Functions& functions, int iterations, TransferMeasurement* measurement, const Transfer& transfer)
+{
+    clearErrors(functions);
+    transfer(false);
+    measurement->ok = functions.GetError() == GL::NO_ERROR;
+    if (!measurement->ok)
+        return;
+    measurement->latency.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        transfer(true);
+        measurement->latency.add(elapsed(start));
+    }
+}
+
+bool benchmarkTransfers(const DisplayInfo& info, EGLenum api, int iterations, TransferBenchmark* result)
+{
+    *result = TransferBenchmark();
+    result->api = api;
+
+    ScopedContext context(info, api);
+    if (!context.isCurrent()) {
+        result->state = TransferBenchmark::ContextFailed;
+        result->contextState = context.state();
+        return false;
+    }
+    const GL::Functions &functions = GL::functions();
+    const GL::TransferFunctions &gl = GL::transferFunctions();
+    if (!functions.isValid() || !gl.isValid()) {
+        result->state = TransferBenchmark::Unresolved;
+        return false;
+    }
+    if (const GL::Ubyte *version = functions.GetString(GL::VERSION))
+        result->version = reinterpret_cast<const char*>(version);
+    result->pixelBuffers = gl.hasPixelBuffers() && parseVersion(result->version) >= 30;
+
+    GL::Int maxTextureSize = 0;
+    functions.GetIntegerv(GL::MAX_TEXTURE_SIZE, &maxTextureSize);
+    gl.PixelStorei(GL::PACK_ALIGNMENT, 1);
+    gl.PixelStorei(GL::UNPACK_ALIGNMENT, 1);
+
+    // the pattern keeps drivers from taking shortcuts for zeroed memory
+    const auto &largest = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+    std::vector<unsigned char> pixels(static_cast<size_t>(largest.width) * largest.height * 4);
+    for (size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<unsigned char>(i * 31);
+    std::vector<unsigned char> destination(pixels.size());
+
+    GL::Uint framebuffer = 0;
+    gl.GenFramebuffers(1, &framebuffer);
+    GL::Uint pixelBuffer = 0;
+    if (result->pixelBuffers)
+        gl.GenBuffers(1, &pixelBuffer);
+
+    auto addMeasurement = [result](TransferMeasurement::Path path, const PixelFormat& format, int width, int height) {
+        result->measurements.emplace_back();
+        TransferMeasurement &measurement = result->measurements.back();
+        measurement.path = path;
+        measurement.format = format.name;
+        measurement.width = width;
+        measurement.height = height;
+        measurement.bytes = static_cast<int64_t>(width) * height * format.bytesPerPixel;
+        measurement.ok = false;
+        return &measurement;
+    };
+
+    // readback is from a texture, so the source does not depend on a surface
+    auto attachTexture = [&](int width, int height) {
+        GL::Uint texture = 0;
+        gl.GenTextures(1, &texture);
+        gl.BindTexture(GL::TEXTURE_2D, texture);
+        gl.TexParameteri(GL::TEXTURE_2D, GL::TEXTURE_MIN_FILTER, GL::NEAREST);
+        gl.TexImage2D(GL::TEXTURE_2D, 0, readFormat.internalFormat, width, height, 0, readFormat.format, readFormat.type, pixels.data());
+        gl.BindFramebuffer(GL::FRAMEBUFFER, framebuffer);
+        gl.FramebufferTexture2D(GL::FRAMEBUFFER, GL::COLOR_ATTACHMENT0, GL::TEXTURE_2D, texture, 0);
+        return texture;
+    };
+    auto detachTexture = [&](GL::Uint texture) {
+        gl.BindFramebuffer(GL::FRAMEBUFFER, 0);
+        gl.DeleteTextures(1, &texture);
+    };
+
+    // the preferred read format depends on the framebuffer format only, not on its size
+    std::vector<PixelFormat> readFormats(1, readFormat);
+    {
+        const GL::Uint texture = attachTexture(1, 1);
+        PixelFormat preferred;
+        if (gl.CheckFramebufferStatus(GL::FRAMEBUFFER) == GL::FRAMEBUFFER_COMPLETE && preferredReadFormat(functions, &preferred))
+            readFormats.push_back(preferred);
+        detachTexture(texture);
+    }
+
+    for (TransferMeasurement::Path path : { TransferMeasurement::ReadPixels, TransferMeasurement::PixelBufferReadback }) {
+        if (path == TransferMeasurement::PixelBufferReadback && !result->pixelBuffers)
+            continue;
+        for (const PixelFormat &format : readFormats) {
+            for (const auto &size : sizes) {
+                if (size.width > maxTextureSize || size.height > maxTextureSize)
+                    continue;
+                TransferMeasurement *readback = addMeasurement(path, format, size.width, size.height);
+                const GL::Uint texture = attachTexture(size.width, size.height);
+                if (gl.CheckFramebufferStatus(GL::FRAMEBUFFER) != GL::FRAMEBUFFER_COMPLETE) {
+                    detachTexture(texture);
+                    continue;
+                }
+                if (path == TransferMeasurement::ReadPixels) {
+                    measure(functions, iterations, readback, [&](bool) {
+                        gl.ReadPixels(0, 0, size.width, size.height, format.format, format.type, destination.data());
+                    });
+                } else {
+                    const int64_t bytes = readback->bytes;
+                    gl.BindBuffer(GL::PIXEL_PACK_BUFFER, pixelBuffer);
+                    gl.BufferData(GL::PIXEL_PACK_BUFFER, bytes, nullptr, GL::STREAM_READ);
+                    measure(functions, iterations, readback, [&](bool timed) {
+                        const auto start = std::chrono::steady_clock::now();
+                        gl.ReadPixels(0, 0, size.width, size.height, format.format, format.type, nullptr);
+                        if (timed)
+                            readback->issue.add(elapsed(start));
+                        // a pipeline would do other work here; mapping waits for the copy to finish
+                        if (const void *mapped = gl.MapBufferRange(GL::PIXEL_PACK_BUFFER, 0, bytes, GL::MAP_READ_BIT)) {
+                            memcpy(destination.data(), mapped, bytes);
+                            gl.UnmapBuffer(GL::PIXEL_PACK_BUFFER);
+                        }
+                    });
+                    gl.BindBuffer(GL::PIXEL_PACK_BUFFER, 0);
+                }
+                detachTexture(texture);
+            }
+        }
+    }
+
+    for (const PixelFormat &format : uploadFormats) {
+        for (const auto &size : sizes) {
+            if (size.width > maxTextureSize || size.height > maxTextureSize)
+                continue;
+            TransferMeasurement *upload = addMeasurement(TransferMeasurement::Upload, format, size.width, size.height);
+            GL::Uint texture = 0;
+            gl.GenTextures(1, &texture);
+            gl.BindTexture(GL::TEXTURE_2D, texture);
+            clearErrors(functions);
+            gl.TexImage2D(GL::TEXTURE_2D, 0, format.internalFormat, size.width, size.height, 0, format.format, format.type, nullptr);
+            if (functions.GetError() == GL::NO_ERROR) {
+                // glTexSubImage2D may only queue the copy, glFinish waits until the texture has the pixels
+                measure(functions, iterations, upload, [&](bool) {
+                    gl.TexSubImage2D(GL::TEXTURE_2D, 0, 0, 0, size.width, size.height, format.format, format.type, pixels.data());
+                    gl.Finish();
+                });
+            }
+            gl.DeleteTextures(1, &texture);
+        }
+    }
+
+    if (pixelBuffer)
+        gl.DeleteBuffers(1, &pixelBuffer);
+    gl.DeleteFramebuffers(1, &framebuffer);
+    return true;
+}
+
+}
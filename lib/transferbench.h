@@ -0,0 +1,90 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_TRANSFERBENCH_H
+#define EGLINFO_TRANSFERBENCH_H
+
+#include "contextinfo.h"
+#include "latency.h"
+
+#include <string>
+#include <vector>
+
+namespace EglInfo {
+
+/** Throughput of one pixel transfer path for one format and size, see benchmarkTransfers(). */
+struct TransferMeasurement {
+    enum Path {
+        /** Synchronous glReadPixels into client memory. */
+        ReadPixels,
+        /** glReadPixels into a pixel pack buffer, then mapped and copied into client memory. */
+        PixelBufferReadback,
+        /** glTexSubImage2D from client memory, followed by glFinish. */
+        Upload
+    } path;
+    /** Short name of the format and type, e.g. "RGBA8" or "RGB565". */
+    std::string format;
+    int width;
+    int height;
+    /** Bytes transferred per iteration. */
+    int64_t bytes;
+    /** False if the driver rejected the format or size; no samples then. */
+    bool ok;
+    /** Complete transfer until the pixels are usable at the destination. */
+    LatencyHistogram latency;
+    /** PixelBufferReadback only: until glReadPixels returns, the time the caller is blocked. */
+    LatencyHistogram issue;
+
+    /** Decimal gigabytes per second at the median latency, 0 without samples. */
+    double throughput() const;
+};
+
+/** Pixel transfer throughput on one client API of a display, see benchmarkTransfers(). */
+struct TransferBenchmark {
+    enum State {
+        Ok,
+        ContextFailed,
+        Unresolved
+    } state;
+    /** Reason if state is ContextFailed. */
+    ContextInfo::State contextState;
+    EGLenum api;
+    /** GL_VERSION of the context. */
+    std::string version;
+    /** True if the context has pixel buffer objects (GL 3.0, GLES 3.0) and PixelBufferReadback was measured. */
+    bool pixelBuffers;
+    std::vector<TransferMeasurement> measurements;
+
+    TransferBenchmark();
+};
+
+/** Returns the display name of @p path, e.g. "glReadPixels". */
+const char* transferPathName(TransferMeasurement::Path path);
+
+/**
+ * Measures readback and upload throughput on a context of @p api on the initialized display
+ * @p info, surfaceless where possible, over @p iterations iterations after one untimed warm up.
+ * Readback reads a texture attached to a framebuffer object, as RGBA8 and, if it differs, in the
+ * implementation's preferred read format. Uploads cover RGBA8, RGB565 and 8 bit luminance, the
+ * latter standing in for a video luma plane. Sizes range from 256x256 to 3840x2160, limited by
+ * GL_MAX_TEXTURE_SIZE. Leaves no context current on the calling thread.
+ */
+bool benchmarkTransfers(const DisplayInfo& info, EGLenum api, int iterations, TransferBenchmark* result);
+
+}
+
+#endif
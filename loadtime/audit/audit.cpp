@@ -0,0 +1,90 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/*
+ * LD_AUDIT module logging when the dynamic loader maps objects, see auditlog.h:
+ *
+ *   EGLINFO_AUDIT_FD=3 LD_AUDIT=libeglinfo-audit.so eglinfo-loadtime 3>audit.log
+ *
+ * eglinfo-loadtime --audit=PATH sets this up itself. Without EGLINFO_AUDIT_FD the module
+ * stays passive.
+ */
+
+#include "auditlog.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <link.h>
+#include <unistd.h>
+
+using namespace EglInfo;
+
+static int logFd = -1;
+
+static void logEvent(AuditEventKind kind, const char* name)
+{
+    if (logFd < 0)
+        return;
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    char line[4096 + 64];
+    const int size = snprintf(line, sizeof(line), "%lld %c %s\n",
+                              static_cast<long long>(now.tv_sec) * 1000000000ll + now.tv_nsec, kind, name);
+    if (size > 0 && size < int(sizeof(line)) && write(logFd, line, size) != size)
+        logFd = -1;
+}
+
+extern "C" unsigned int la_version(unsigned int version)
+{
+    if (const char *fd = getenv(EGLINFO_AUDIT_FD_VARIABLE))
+        logFd = atoi(fd);
+    return version < LAV_CURRENT ? version : LAV_CURRENT;
+}
+
+extern "C" void la_activity(uintptr_t* cookie, unsigned int flag)
+{
+    (void)cookie;
+    switch (flag) {
+    case LA_ACT_ADD:
+        logEvent(AuditAdd, "");
+        break;
+    case LA_ACT_DELETE:
+        logEvent(AuditDelete, "");
+        break;
+    case LA_ACT_CONSISTENT:
+        logEvent(AuditConsistent, "");
+        break;
+    }
+}
+
+extern "C" unsigned int la_objopen(link_map* map, Lmid_t lmid, uintptr_t* cookie)
+{
+    (void)lmid;
+    // the cookie identifies the object in later callbacks
+    *cookie = reinterpret_cast<uintptr_t>(map);
+    logEvent(AuditObjectOpen, map->l_name);
+    return 0;
+}
+
+extern "C" unsigned int la_objclose(uintptr_t* cookie)
+{
+    logEvent(AuditObjectClose, reinterpret_cast<link_map*>(*cookie)->l_name);
+    return 0;
+}
@@ -0,0 +1,7 @@
+TEMPLATE = lib
+TARGET = eglinfo-audit
+CONFIG += plugin egl_headers_only
+INCLUDEPATH += $$PWD/..
+include(../../eglinfo.pri)
+HEADERS += ../auditlog.h
+SOURCES += audit.cpp
@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef EGLINFO_AUDITLOG_H
+#define EGLINFO_AUDITLOG_H
+
+/*
+ * Log written by the LD_AUDIT module libeglinfo-audit.so for eglinfo-loadtime.
+ *
+ * The module appends one line per dynamic loader event to the file descriptor named by
+ * EGLINFO_AUDIT_FD: "TIME KIND NAME", TIME being CLOCK_MONOTONIC in nanoseconds and KIND
+ * one of the AuditEventKind characters. NAME is the object path for AuditObjectOpen and
+ * AuditObjectClose and empty otherwise.
+ */
+
+#define EGLINFO_AUDIT_FD_VARIABLE "EGLINFO_AUDIT_FD"
+
+namespace EglInfo {
+
+enum AuditEventKind : char {
+    /** la_activity(LA_ACT_ADD): the loader starts adding objects, e.g. in dlopen(). */
+    AuditAdd = 'a',
+    /** la_activity(LA_ACT_DELETE) */
+    AuditDelete = 'd',
+    /** la_activity(LA_ACT_CONSISTENT): the link map is consistent again. */
+    AuditConsistent = 'c',
+    /** la_objopen(): an object was mapped. */
+    AuditObjectOpen = 'o',
+    /** la_objclose() */
+    AuditObjectClose = 'x'
+};
+
+}
+
+#endif
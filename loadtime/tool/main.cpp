@@ -0,0 +1,295 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/*
+ * Breaks down the startup cost of the EGL stack: loads libEGL with dlopen() instead of at link
+ * time and times that and each of the first EGL calls, listing the shared objects that got
+ * loaded during each stage (found with dl_iterate_phdr()). With --audit=PATH it re-executes
+ * itself with PATH (libeglinfo-audit.so) as LD_AUDIT module, which timestamps every object the
+ * dynamic loader maps, to also report how long each stage spent finding and mapping objects.
+ */
+
+#include "auditlog.h"
+#include "latency.h"
+
+#include <EGL/egl.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace EglInfo;
+
+namespace {
+
+struct Stage {
+    string name;
+    int64_t start = 0;
+    int64_t end = 0;
+    bool ok = true;
+    /** Objects that appeared during the stage, in load order. */
+    vector<string> objects;
+};
+
+struct AuditEvent {
+    int64_t time;
+    char kind;
+    string name;
+};
+
+}
+
+static int64_t now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static vector<string> loadedObjects()
+{
+    vector<string> objects;
+    dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) {
+        if (info->dlpi_name && *info->dlpi_name)
+            static_cast<vector<string>*>(data)->push_back(info->dlpi_name);
+        return 0;
+    }, &objects);
+    return objects;
+}
+
+template <typename F>
+static void runStage(vector<Stage>* stages, const string& name, F f)
+{
+    Stage stage;
+    stage.name = name;
+    const vector<string> before = loadedObjects();
+    stage.start = now();
+    stage.ok = f();
+    stage.end = now();
+    const set<string> known(before.begin(), before.end());
+    for (const string &object : loadedObjects()) {
+        if (!known.count(object))
+            stage.objects.push_back(object);
+    }
+    stages->push_back(move(stage));
+}
+
+static vector<AuditEvent> readAuditLog(int fd)
+{
+    vector<AuditEvent> events;
+    string log;
+    char buffer[65536];
+    off_t offset = 0;
+    ssize_t size;
+    while ((size = pread(fd, buffer, sizeof(buffer), offset)) > 0) {
+        log.append(buffer, size);
+        offset += size;
+    }
+    istringstream in(log);
+    string line;
+    while (getline(in, line)) {
+        AuditEvent event;
+        char kind;
+        int nameOffset = 0;
+        long long time;
+        if (sscanf(line.c_str(), "%lld %c %n", &time, &kind, &nameOffset) < 2)
+            continue;
+        event.time = time;
+        event.kind = kind;
+        event.name = line.substr(nameOffset);
+        events.push_back(move(event));
+    }
+    return events;
+}
+
+/** Re-executes the program with the audit module @p auditModule. Only returns on failure. */
+static void execAudited(const char* auditModule, char** argv)
+{
+    const int fd = memfd_create("eglinfo-audit", 0);
+    if (fd < 0) {
+        perror("memfd_create");
+        return;
+    }
+    setenv(EGLINFO_AUDIT_FD_VARIABLE, to_string(fd).c_str(), 1);
+    setenv("LD_AUDIT", auditModule, 1);
+    execv("/proc/self/exe", argv);
+    perror("Could not re-execute with LD_AUDIT");
+    close(fd);
+}
+
+static void printStages(const vector<Stage>& stages, const vector<AuditEvent>& events, bool audited)
+{
+    size_t nameWidth = 5;
+    for (const Stage &stage : stages)
+        nameWidth = max(nameWidth, stage.name.size());
+
+    cout << left << setw(nameWidth) << "Stage" << right << setw(12) << "Time" << setw(9) << "Objects";
+    if (audited)
+        cout << setw(12) << "Mapping";
+    cout << endl;
+
+    int64_t totalTime = 0, totalMapping = 0;
+    size_t totalObjects = 0;
+    vector<vector<pair<string, int64_t>>> objectTimes(stages.size());
+    for (size_t s = 0; s < stages.size(); ++s) {
+        const Stage &stage = stages[s];
+        // mapping is the time between LA_ACT_ADD and LA_ACT_CONSISTENT, which precedes relocation
+        // and constructors; each object is charged the time since the previous event, i.e. for
+        // finding and mapping it
+        int64_t mapping = 0, addTime = -1, previous = 0;
+        for (const AuditEvent &event : events) {
+            if (event.time < stage.start || event.time > stage.end)
+                continue;
+            if (event.kind == AuditAdd) {
+                addTime = previous = event.time;
+            } else if (event.kind == AuditConsistent && addTime >= 0) {
+                mapping += event.time - addTime;
+                addTime = -1;
+            } else if (event.kind == AuditObjectOpen) {
+                objectTimes[s].emplace_back(event.name, previous ? event.time - previous : 0);
+                previous = event.time;
+            }
+        }
+
+        cout << left << setw(nameWidth) << stage.name << right << setw(12) << formatDuration(stage.end - stage.start)
+             << setw(9) << stage.objects.size();
+        if (audited)
+            cout << setw(12) << formatDuration(mapping);
+        if (!stage.ok)
+            cout << "  failed";
+        cout << endl;
+        totalTime += stage.end - stage.start;
+        totalMapping += mapping;
+        totalObjects += stage.objects.size();
+    }
+    cout << left << setw(nameWidth) << "Total" << right << setw(12) << formatDuration(totalTime) << setw(9) << totalObjects;
+    if (audited)
+        cout << setw(12) << formatDuration(totalMapping);
+    cout << endl;
+
+    for (size_t s = 0; s < stages.size(); ++s) {
+        const Stage &stage = stages[s];
+        if (stage.objects.empty())
+            continue;
+        cout << endl << "Loaded during " << stage.name << ":" << endl;
+        for (const string &object : stage.objects) {
+            cout << "  " << object;
+            const auto timed = find_if(objectTimes[s].begin(), objectTimes[s].end(), [&](const pair<string, int64_t>& entry) {
+                return entry.first == object;
+            });
+            if (timed != objectTimes[s].end())
+                cout << " (" << formatDuration(timed->second) << ")";
+            cout << endl;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* library = "libEGL.so.1";
+    const char* auditModule = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--egl=", 6) == 0) {
+            library = argv[i] + 6;
+        } else if (strncmp(argv[i], "--audit=", 8) == 0) {
+            auditModule = argv[i] + 8;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--egl=LIBRARY] [--audit=PATH]" << endl
+                 << "  --egl=LIBRARY  libEGL to load with dlopen() (default libEGL.so.1)" << endl
+                 << "  --audit=PATH   time object mapping with the LD_AUDIT module PATH (libeglinfo-audit.so)" << endl;
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    const char *auditFd = getenv(EGLINFO_AUDIT_FD_VARIABLE);
+    if (auditModule && !auditFd) {
+        execAudited(auditModule, argv);
+        return 1;
+    }
+
+    vector<Stage> stages;
+    void *handle = nullptr;
+    runStage(&stages, string("dlopen(") + library + ")", [&] {
+        handle = dlopen(library, RTLD_NOW | RTLD_LOCAL);
+        return handle != nullptr;
+    });
+    if (!handle) {
+        cerr << "Could not load " << library << ": " << dlerror() << endl;
+        return 1;
+    }
+
+    // decltype does not reference the symbols, the binary is not linked against libEGL
+    const auto queryString = reinterpret_cast<decltype(&eglQueryString)>(dlsym(handle, "eglQueryString"));
+    const auto getDisplay = reinterpret_cast<decltype(&eglGetDisplay)>(dlsym(handle, "eglGetDisplay"));
+    const auto initialize = reinterpret_cast<decltype(&eglInitialize)>(dlsym(handle, "eglInitialize"));
+    const auto getConfigs = reinterpret_cast<decltype(&eglGetConfigs)>(dlsym(handle, "eglGetConfigs"));
+    const auto terminate = reinterpret_cast<decltype(&eglTerminate)>(dlsym(handle, "eglTerminate"));
+    if (!queryString || !getDisplay || !initialize || !getConfigs || !terminate) {
+        cerr << library << " lacks EGL 1.0 entry points." << endl;
+        return 1;
+    }
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLint configCount = 0;
+    runStage(&stages, "eglQueryString(EGL_EXTENSIONS)", [&] {
+        return queryString(EGL_NO_DISPLAY, EGL_EXTENSIONS) != nullptr;
+    });
+    runStage(&stages, "eglGetDisplay", [&] {
+        display = getDisplay(EGL_DEFAULT_DISPLAY);
+        return display != EGL_NO_DISPLAY;
+    });
+    if (display != EGL_NO_DISPLAY) {
+        runStage(&stages, "eglInitialize", [&] {
+            return initialize(display, nullptr, nullptr) != EGL_FALSE;
+        });
+        runStage(&stages, "eglGetConfigs", [&] {
+            return getConfigs(display, nullptr, 0, &configCount) != EGL_FALSE;
+        });
+    }
+
+    vector<AuditEvent> events;
+    if (auditFd)
+        events = readAuditLog(atoi(auditFd));
+    // ld.so only warns if it cannot load the audit module, trust the log instead of the variable
+    const Stage &load = stages.front();
+    const bool audited = any_of(events.begin(), events.end(), [&](const AuditEvent& event) {
+        return event.kind == AuditAdd && event.time >= load.start && event.time <= load.end;
+    });
+    if (auditFd && !audited)
+        cerr << "Auditing failed: " << (auditModule ? auditModule : "the LD_AUDIT module") << " was not loaded, no mapping times." << endl;
+    printStages(stages, events, audited);
+
+    if (display != EGL_NO_DISPLAY)
+        terminate(display);
+    return 0;
+}
@@ -0,0 +1,10 @@
+TEMPLATE = app
+TARGET = eglinfo-loadtime
+CONFIG += egl_headers_only
+INCLUDEPATH += $$PWD/.. $$PWD/../../lib
+# only for formatDuration(), libEGL is loaded at runtime
+LIBS += -L$$OUT_PWD/../../lib -leglinfo -ldl
+PRE_TARGETDEPS += $$OUT_PWD/../../lib/libeglinfo.a
+include(../../eglinfo.pri)
+HEADERS += ../auditlog.h
+SOURCES += main.cpp
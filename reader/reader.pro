@@ -0,0 +1,9 @@
+TEMPLATE = lib
+TARGET = eglinfo-reader
+CONFIG += staticlib egl_headers_only
+include(../eglinfo.pri)
+INCLUDEPATH += $$PWD/../lib
+HEADERS += \
+    ../lib/snapshot.h \
+    snapshotreader.h
+SOURCES += snapshotreader.cpp
@@ -0,0 +1,359 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "snapshotreader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EglInfo {
+
+SnapshotReader::SnapshotReader()
+    : m_fd(-1)
+    , m_data(nullptr)
+    , m_size(0)
+{
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    close();
+}
+
+bool SnapshotReader::open(const char* name)
+{
+    close();
+    m_fd = shm_open(name, O_RDONLY, 0);
+    if (m_fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 || !map(st.st_size)) {
+        const int error = errno;
+        close();
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+void SnapshotReader::close()
+{
+    if (m_data)
+        munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_fd = -1;
+}
+
+bool SnapshotReader::map(size_t size)
+{
+    if (size < sizeof(SnapshotHeader)) {
+        errno = EINVAL;
+        return false;
+    }
+
+    void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED)
+        return false;
+    if (m_data)
+        munmap(m_data, m_size);
+    m_data = data;
+    m_size = size;
+    return true;
+}
+
+bool SnapshotReader::beginRead(uint32_t* sequence, std::chrono::steady_clock::time_point deadline)
+{
+    if (!m_data)
+        return false;
+
+    for (;;) {
+        *sequence = header()->sequence.load(std::memory_order_acquire);
+        if (*sequence & 1) {
+            // a publisher that died mid-update leaves the sequence odd for good
+            if (std::chrono::steady_clock::now() >= deadline) {
+                errno = ETIMEDOUT;
+                return false;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        if (memcmp(header()->magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 || header()->version != SnapshotVersion)
+            return false;
+        // the publisher grew the snapshot, follow it
+        const uint32_t size = header()->size;
+        if (size > m_size && !map(size))
+            return false;
+        return true;
+    }
+}
+
+bool SnapshotReader::endRead(uint32_t sequence) const
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return header()->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+uint32_t SnapshotReader::generation() const
+{
+    return m_data ? header()->sequence.load(std::memory_order_acquire) / 2 : 0;
+}
+
+const SnapshotDisplay* SnapshotReader::display(uint32_t index) const
+{
+    const SnapshotHeader *h = header();
+    if (index >= h->displayCount)
+        return nullptr;
+    const size_t offset = h->displaysOffset + size_t(index) * sizeof(SnapshotDisplay);
+    if (offset + sizeof(SnapshotDisplay) > m_size)
+        return nullptr;
+    return reinterpret_cast<const SnapshotDisplay*>(static_cast<const char*>(m_data) + offset);
+}
+
+const SnapshotConfig* SnapshotReader::config(uint32_t index) const
+{
+    const SnapshotHeader *h = header();
+    if (index >= h->configCount)
+        return nullptr;
+    const size_t offset = h->configsOffset + size_t(index) * sizeof(SnapshotConfig);
+    if (offset + sizeof(SnapshotConfig) > m_size)
+        return nullptr;
+    return reinterpret_cast<const SnapshotConfig*>(static_cast<const char*>(m_data) + offset);
+}
+
+const SnapshotDmaBufFormat* SnapshotReader::dmaBufFormat(uint32_t index) const
+{
+    const SnapshotHeader *h = header();
+    if (index >= h->dmaBufFormatCount)
+        return nullptr;
+    const size_t offset = h->dmaBufFormatsOffset + size_t(index) * sizeof(SnapshotDmaBufFormat);
+    if (offset + sizeof(SnapshotDmaBufFormat) > m_size)
+        return nullptr;
+    return reinterpret_cast<const SnapshotDmaBufFormat*>(static_cast<const char*>(m_data) + offset);
+}
+
+const SnapshotDmaBufModifier* SnapshotReader::dmaBufModifier(uint32_t index) const
+{
+    const SnapshotHeader *h = header();
+    if (index >= h->dmaBufModifierCount)
+        return nullptr;
+    const size_t offset = h->dmaBufModifiersOffset + size_t(index) * sizeof(SnapshotDmaBufModifier);
+    if (offset + sizeof(SnapshotDmaBufModifier) > m_size)
+        return nullptr;
+    return reinterpret_cast<const SnapshotDmaBufModifier*>(static_cast<const char*>(m_data) + offset);
+}
+
+const char* SnapshotReader::string(uint32_t offset) const
+{
+    // the last byte of the mapping is always 0, so any offset inside it is terminated
+    if (offset == 0 || offset >= m_size)
+        return nullptr;
+    return static_cast<const char*>(m_data) + offset;
+}
+
+int SnapshotReader::column(int32_t attribute) const
+{
+    const SnapshotHeader *h = header();
+    for (uint32_t i = 0; i < h->attributeCount && i < SnapshotMaxAttributes; ++i) {
+        if (h->attributes[i] == attribute)
+            return i;
+    }
+    return -1;
+}
+
+bool SnapshotReader::findDmaBufModifier(uint32_t displayIndex, uint32_t fourcc, uint64_t modifier, bool* externalOnly)
+{
+    bool found = false;
+    const bool valid = read([&] {
+        found = false;
+        const SnapshotDisplay *disp = display(displayIndex);
+        if (!disp)
+            return;
+
+        uint32_t low = 0, high = disp->dmaBufFormatCount;
+        while (low < high) {
+            const uint32_t middle = low + (high - low) / 2;
+            const SnapshotDmaBufFormat *format = dmaBufFormat(disp->firstDmaBufFormat + middle);
+            if (!format)
+                return;
+            if (format->fourcc < fourcc)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        const SnapshotDmaBufFormat *format = low < disp->dmaBufFormatCount ? dmaBufFormat(disp->firstDmaBufFormat + low) : nullptr;
+        if (!format || format->fourcc != fourcc)
+            return;
+
+        low = 0;
+        high = format->modifierCount;
+        while (low < high) {
+            const uint32_t middle = low + (high - low) / 2;
+            const SnapshotDmaBufModifier *entry = dmaBufModifier(format->firstModifier + middle);
+            if (!entry)
+                return;
+            if (entry->modifier < modifier)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        const SnapshotDmaBufModifier *entry = low < format->modifierCount ? dmaBufModifier(format->firstModifier + low) : nullptr;
+        if (!entry || entry->modifier != modifier)
+            return;
+        *externalOnly = entry->externalOnly != 0;
+        found = true;
+    });
+    return valid && found;
+}
+
+bool SnapshotReader::findRecommendation(const char* profile, uint32_t displayIndex, SnapshotMatch* match)
+{
+    bool found = false;
+    const bool valid = read([&] {
+        found = false;
+        const SnapshotHeader *h = header();
+        if (h->recommendationsOffset + size_t(h->recommendationCount) * sizeof(SnapshotRecommendation) > m_size)
+            return;
+        const SnapshotRecommendation *table = reinterpret_cast<const SnapshotRecommendation*>(static_cast<const char*>(m_data) + h->recommendationsOffset);
+        for (uint32_t i = 0; i < h->recommendationCount; ++i) {
+            const SnapshotRecommendation &recommendation = table[i];
+            if (recommendation.displayIndex != displayIndex)
+                continue;
+            const char *name = string(recommendation.profile);
+            if (!name || strcmp(name, profile) != 0)
+                continue;
+            const SnapshotDisplay *disp = display(displayIndex);
+            const SnapshotConfig *cfg = config(recommendation.config);
+            if (!disp || !cfg || recommendation.config < disp->firstConfig)
+                return;
+            match->displayIndex = displayIndex;
+            match->configIndex = recommendation.config - disp->firstConfig;
+            match->config = *cfg;
+            found = true;
+            return;
+        }
+    });
+    return valid && found;
+}
+
+bool SnapshotReader::findFingerprint(uint64_t fingerprint, SnapshotMatch* match)
+{
+    bool found = false;
+    const bool valid = read([&] {
+        found = false;
+        const SnapshotHeader *h = header();
+        const size_t count = h->configCount;
+        if (h->fingerprintsOffset + count * sizeof(SnapshotFingerprint) > m_size)
+            return;
+        const SnapshotFingerprint *table = reinterpret_cast<const SnapshotFingerprint*>(static_cast<const char*>(m_data) + h->fingerprintsOffset);
+
+        size_t low = 0, high = count;
+        while (low < high) {
+            const size_t middle = low + (high - low) / 2;
+            if (table[middle].fingerprint < fingerprint)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        if (low == count || table[low].fingerprint != fingerprint)
+            return;
+
+        const uint32_t index = table[low].config;
+        const SnapshotConfig *cfg = config(index);
+        if (!cfg)
+            return;
+        // map the global config index back to its display
+        for (uint32_t d = 0; d < h->displayCount; ++d) {
+            const SnapshotDisplay *disp = display(d);
+            if (disp && index >= disp->firstConfig && index - disp->firstConfig < disp->configCount) {
+                match->displayIndex = d;
+                match->configIndex = index - disp->firstConfig;
+                match->config = *cfg;
+                found = true;
+                return;
+            }
+        }
+    });
+    return valid && found;
+}
+
+static bool matches(const SnapshotConfig* config, const SnapshotTerm& term, int column)
+{
+    if (column < 0 || !(config->validMask & (1u << column)))
+        return false;
+    const int32_t value = config->values[column];
+    switch (term.op) {
+        case SnapshotTerm::Equal:
+            return value == term.value;
+        case SnapshotTerm::AtLeast:
+            return value >= term.value;
+        case SnapshotTerm::AtMost:
+            return value <= term.value;
+        case SnapshotTerm::HasBits:
+            return (value & term.value) == term.value;
+    }
+    return false;
+}
+
+bool SnapshotReader::findConfig(const SnapshotTerm* terms, int termCount, SnapshotMatch* match)
+{
+    enum { MaxTerms = 16 };
+    if (termCount > MaxTerms)
+        return false;
+
+    bool found = false;
+    const bool valid = read([&] {
+        found = false;
+        int columns[MaxTerms];
+        for (int i = 0; i < termCount; ++i)
+            columns[i] = column(terms[i].attribute);
+
+        const SnapshotHeader *h = header();
+        for (uint32_t d = 0; d < h->displayCount && !found; ++d) {
+            const SnapshotDisplay *disp = display(d);
+            if (!disp)
+                break;
+            for (uint32_t c = 0; c < disp->configCount; ++c) {
+                const SnapshotConfig *cfg = config(disp->firstConfig + c);
+                if (!cfg)
+                    break;
+                int i = 0;
+                while (i < termCount && matches(cfg, terms[i], columns[i]))
+                    ++i;
+                if (i == termCount) {
+                    match->displayIndex = d;
+                    match->configIndex = c;
+                    match->config = *cfg;
+                    found = true;
+                    break;
+                }
+            }
+        }
+    });
+    return valid && found;
+}
+
+}
@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EGLINFO_SNAPSHOTREADER_H
+#define EGLINFO_SNAPSHOTREADER_H
+
+#include "snapshot.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+
+namespace EglInfo {
+
+/** A single constraint on a config attribute, see SnapshotReader::findConfig(). */
+struct SnapshotTerm {
+    int32_t attribute;
+    enum Op {
+        Equal,
+        AtLeast,
+        AtMost,
+        HasBits
+    } op;
+    int32_t value;
+};
+
+struct SnapshotMatch {
+    uint32_t displayIndex;
+    uint32_t configIndex;
+    SnapshotConfig config;
+};
+
+/**
+ * Read-only access to a snapshot published by eglinfo --publish.
+ * Neither EGL nor any parsing is involved, lookups work directly on the shared mapping.
+ */
+class SnapshotReader
+{
+public:
+    SnapshotReader();
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /** Maps the shared memory object @p name. Returns false and leaves errno set on failure. */
+    bool open(const char* name = EGLINFO_SNAPSHOT_DEFAULT_NAME);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    /** How long read() waits for a publish in progress before giving up, in milliseconds. */
+    enum { ReadTimeout = 100 };
+
+    /**
+     * Calls @p f with a consistent view of the snapshot, retrying if it is republished meanwhile.
+     * @p f may be called several times and must only use the accessors below.
+     * Returns false if there is no valid snapshot. Also returns false with errno set to ETIMEDOUT
+     * if no consistent view was possible within ReadTimeout, e.g. because a publisher died
+     * mid-update. Callers should then fall back to probing.
+     */
+    template <typename F>
+    bool read(F f)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ReadTimeout);
+        for (;;) {
+            uint32_t sequence;
+            if (!beginRead(&sequence, deadline))
+                return false;
+            f();
+            if (endRead(sequence))
+                return true;
+            if (std::chrono::steady_clock::now() >= deadline) {
+                errno = ETIMEDOUT;
+                return false;
+            }
+        }
+    }
+
+    /** Number of completed publishes seen in the current mapping. */
+    uint32_t generation() const;
+
+    // Accessors, only valid within read(); all return nullptr/-1 for out of range arguments.
+    const SnapshotHeader* header() const { return static_cast<const SnapshotHeader*>(m_data); }
+    const SnapshotDisplay* display(uint32_t index) const;
+    const SnapshotConfig* config(uint32_t index) const;
+    const SnapshotDmaBufFormat* dmaBufFormat(uint32_t index) const;
+    const SnapshotDmaBufModifier* dmaBufModifier(uint32_t index) const;
+    const char* string(uint32_t offset) const;
+    /** Column of @p attribute in SnapshotConfig::values. */
+    int column(int32_t attribute) const;
+
+    /** Finds a config by its fingerprint, using binary search on the fingerprint table. */
+    bool findFingerprint(uint64_t fingerprint, SnapshotMatch* match);
+
+    /**
+     * Returns true if display @p displayIndex can import DMA-BUFs of format @p fourcc with
+     * @p modifier, setting @p externalOnly accordingly. Binary searches the sorted tables.
+     */
+    bool findDmaBufModifier(uint32_t displayIndex, uint32_t fourcc, uint64_t modifier, bool* externalOnly);
+
+    /**
+     * Returns the config recommended for @p profile (e.g. "3d-ui") on display @p displayIndex,
+     * as computed when the snapshot was published. Returns false if no config qualified.
+     */
+    bool findRecommendation(const char* profile, uint32_t displayIndex, SnapshotMatch* match);
+
+    /** Finds the first config satisfying all @p terms. */
+    bool findConfig(const SnapshotTerm* terms, int termCount, SnapshotMatch* match);
+
+private:
+    bool beginRead(uint32_t* sequence, std::chrono::steady_clock::time_point deadline);
+    bool endRead(uint32_t sequence) const;
+    bool map(size_t size);
+
+    int m_fd;
+    void* m_data;
+    size_t m_size;
+};
+
+}
+
+#endif
@@ -0,0 +1,7 @@
+TEMPLATE = app
+TARGET = eglinfo-asynccheck
+INCLUDEPATH += $$PWD/../../lib
+LIBS += -L$$OUT_PWD/../../lib -leglinfo -lrt
+PRE_TARGETDEPS += $$OUT_PWD/../../lib/libeglinfo.a
+include(../../eglinfo.pri)
+SOURCES += main.cpp
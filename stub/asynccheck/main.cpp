@@ -0,0 +1,126 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Checks AsyncProbe against the stub libEGL, run by make check in stub/:
+ *
+ *   LD_LIBRARY_PATH=stub eglinfo-asynccheck
+ *
+ * The stub holds every eglInitialize() until the check writes a byte to EGLINFO_STUB_BLOCK_FD,
+ * which lets it release the displays one at a time. Exits with status 1 on the first failure.
+ */
+
+#include "asyncprobe.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <dirent.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace EglInfo;
+
+static const chrono::seconds timeout(10);
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << endl; \
+            exit(1); \
+        } \
+    } while (false)
+
+template <typename Future>
+static bool isReady(const Future& future, chrono::milliseconds wait = chrono::milliseconds(0))
+{
+    return future.wait_for(wait) == future_status::ready;
+}
+
+static void release(int fd, int displays)
+{
+    const string bytes(displays, 'x');
+    CHECK(write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()));
+}
+
+static int threadCount()
+{
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir)
+        return -1;
+    int count = 0;
+    while (const dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.')
+            ++count;
+    }
+    closedir(dir);
+    return count;
+}
+
+int main()
+{
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    setenv("EGLINFO_STUB_BLOCK_FD", to_string(fds[0]).c_str(), 1);
+    const int threadsBefore = threadCount();
+
+    {
+        AsyncProbe probe;
+        CHECK(isReady(probe.clientExtensions(), timeout));
+
+        // every display is held in eglInitialize(), so both requests have to wait
+        future<ConfigMatch> es2 = probe.findConfig(AsyncProbe::renderableType(EGL_OPENGL_ES2_BIT));
+        future<ConfigMatch> none = probe.findConfig([](const ConfigInfo&) { return false; });
+        CHECK(!isReady(es2, chrono::milliseconds(50)));
+        CHECK(!isReady(none));
+
+        // one display finishing resolves the first waiter, the result still waits for the others
+        release(fds[1], 1);
+        CHECK(isReady(es2, timeout));
+        const ConfigMatch match = es2.get();
+        CHECK(match.display && match.config());
+        CHECK(match.config()->value(EGL_RENDERABLE_TYPE) & EGL_OPENGL_ES2_BIT);
+        CHECK(!isReady(probe.result()));
+        CHECK(!isReady(none));
+
+        // a request made after a display finished is answered right away
+        CHECK(isReady(probe.findConfig(AsyncProbe::renderableType(EGL_OPENGL_BIT))));
+
+        release(fds[1], 2);
+        CHECK(isReady(probe.result(), timeout));
+        CHECK(probe.result().get()->hasDefaultDisplay);
+        CHECK(isReady(none, timeout));
+        CHECK(!none.get().display);
+    }
+    CHECK(threadCount() == threadsBefore);
+
+    // destroying the probe right after releasing its displays waits for all of its threads
+    shared_future<const ProbeResult*> result;
+    {
+        AsyncProbe probe;
+        result = probe.result();
+        CHECK(isReady(probe.clientExtensions(), timeout));
+        release(fds[1], 3);
+    }
+    CHECK(isReady(result));
+    CHECK(threadCount() == threadsBefore);
+
+    cout << "AsyncProbe checks passed." << endl;
+    return 0;
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+#
+# make check: runs the built tools against the stub libEGL and fails if any of them makes
+# different driver calls than its .calls file lists, prints something else than its .out file,
+# or if eglinfo-asynccheck or eglinfo-loadtime with the audit module fail.
+#
+#   sh check.sh STUBDIR BUILDDIR
+#
+# STUBDIR holds the stub libEGL, BUILDDIR is the top level build directory.
+
+stub=$1
+build=$2
+source=$(dirname "$0")
+export LD_LIBRARY_PATH="$stub"
+status=0
+
+# expect CALLS ARGS...: "eglinfo ARGS" has to make exactly the calls listed in CALLS
+expect()
+{
+    calls=$1
+    shift
+    if ! EGLINFO_STUB_EXPECT="$source/$calls" "$build/cli/eglinfo" "$@" > /dev/null; then
+        echo "check failed: eglinfo $* does not match $calls" >&2
+        status=1
+    fi
+}
+
+# output OUT PATTERN ARGS...: the lines of "eglinfo ARGS" matching the extended regular
+# expression PATTERN have to be the ones in OUT
+output()
+{
+    out=$1
+    pattern=$2
+    shift 2
+    if ! "$build/cli/eglinfo" "$@" | grep -E "$pattern" | diff -u "$source/$out" - >&2; then
+        echo "check failed: eglinfo $* does not print $out" >&2
+        status=1
+    fi
+}
+
+expect eglinfo.calls
+expect eglinfo-contexts.calls --contexts
+expect eglinfo-dmabuf.calls --dmabuf
+expect eglinfo-bench-eglimage.calls --bench-eglimage=5
+expect eglinfo-bench-sync.calls --bench-sync=10
+expect eglinfo-bench-transfer.calls --bench-transfer=2
+expect eglinfo-probe-pbuffer.calls --probe-pbuffer
+
+output eglinfo-bench-eglimage.out 'consumer saw' --bench-eglimage=5
+output eglinfo-dmabuf.out 'DMA-BUF|\(0x' --dmabuf
+output eglinfo-topology.out 'topology|PCI address|NUMA node|Local CPUs|Render node' \
+    --sysfs-root="$source/sysfs"
+
+if ! "$build/stub/asynccheck/eglinfo-asynccheck" > /dev/null; then
+    echo "check failed: eglinfo-asynccheck" >&2
+    status=1
+fi
+
+# eglinfo-loadtime with timings left out and the stub and build directories replaced by STUB and
+# BUILD; the audit module itself stands in for the driver the stub loads in eglInitialize()
+audit="$build/loadtime/audit/libeglinfo-audit.so"
+if ! loadtime=$(EGLINFO_STUB_DRIVER="$audit" "$build/loadtime/tool/eglinfo-loadtime" \
+        --egl="$stub/libEGL.so.1" --audit="$audit" 2>&1) \
+    || ! printf '%s\n' "$loadtime" | sed -e "s|$stub/|STUB/|g" -e "s|$build/|BUILD/|g" \
+        -e 's/[0-9.]* [num]s/T/g' | tr -s ' ' | diff -u "$source/eglinfo-loadtime.out" - >&2; then
+    echo "check failed: eglinfo-loadtime --audit" >&2
+    status=1
+fi
+
+exit $status
@@ -0,0 +1,1271 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Stub libEGL with a fixed topology that counts every call, used to keep the number of driver
+ * round trips eglinfo makes in check:
+ *
+ *   LD_LIBRARY_PATH=stub EGLINFO_STUB_CALLS=calls.txt eglinfo
+ *   LD_LIBRARY_PATH=stub EGLINFO_STUB_EXPECT=calls.txt eglinfo
+ *
+ * The first run writes one "function count" line per entry point that was called, the second one
+ * compares the calls made against such a file and exits with status 2 if any count differs.
+ *
+ * EGLINFO_STUB_DRIVER names a shared object the first eglInitialize() loads with dlopen(),
+ * standing in for a vendor driver when measuring load times with eglinfo-loadtime.
+ *
+ * EGLINFO_STUB_BLOCK_FD names a file descriptor every eglInitialize() reads one byte from before
+ * returning, so a test decides when and in which order concurrently probed displays finish.
+ *
+ * Topology: StubDeviceCount devices, each with a platform display, plus the default display,
+ * each display exposing StubConfigCount configs. All handles are pointers into static tables.
+ */
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#define STUB_FUNCTIONS(F) \
+    F(eglBindAPI) \
+    F(eglChooseConfig) \
+    F(eglClientWaitSyncKHR) \
+    F(eglCreateContext) \
+    F(eglCreateImageKHR) \
+    F(eglCreatePbufferSurface) \
+    F(eglCreateSyncKHR) \
+    F(eglDestroyContext) \
+    F(eglDestroyImageKHR) \
+    F(eglDestroySurface) \
+    F(eglDestroySyncKHR) \
+    F(eglGetConfigAttrib) \
+    F(eglGetConfigs) \
+    F(eglGetCurrentContext) \
+    F(eglGetDisplay) \
+    F(eglGetError) \
+    F(eglGetPlatformDisplay) \
+    F(eglGetPlatformDisplayEXT) \
+    F(eglGetProcAddress) \
+    F(eglInitialize) \
+    F(eglMakeCurrent) \
+    F(eglQueryAPI) \
+    F(eglQueryContext) \
+    F(eglQueryDeviceAttribEXT) \
+    F(eglQueryDevicesEXT) \
+    F(eglQueryDeviceStringEXT) \
+    F(eglQueryDmaBufFormatsEXT) \
+    F(eglQueryDmaBufModifiersEXT) \
+    F(eglQueryString) \
+    F(eglQuerySurface) \
+    F(eglReleaseThread) \
+    F(eglSetBlobCacheFuncsANDROID) \
+    F(eglSwapBuffers) \
+    F(eglTerminate) \
+    F(glAttachShader) \
+    F(glBindBuffer) \
+    F(glBindFramebuffer) \
+    F(glBindTexture) \
+    F(glBufferData) \
+    F(glCheckFramebufferStatus) \
+    F(glCompileShader) \
+    F(glCreateProgram) \
+    F(glCreateShader) \
+    F(glDeleteBuffers) \
+    F(glDeleteFramebuffers) \
+    F(glDeleteProgram) \
+    F(glDeleteShader) \
+    F(glDeleteTextures) \
+    F(glEGLImageTargetTexture2DOES) \
+    F(glFinish) \
+    F(glFramebufferTexture2D) \
+    F(glGenBuffers) \
+    F(glGenFramebuffers) \
+    F(glGenTextures) \
+    F(glGetError) \
+    F(glGetIntegerv) \
+    F(glGetProgramInfoLog) \
+    F(glGetProgramiv) \
+    F(glGetShaderInfoLog) \
+    F(glGetShaderiv) \
+    F(glGetString) \
+    F(glGetStringi) \
+    F(glLinkProgram) \
+    F(glMapBufferRange) \
+    F(glPixelStorei) \
+    F(glReadPixels) \
+    F(glShaderSource) \
+    F(glTexImage2D) \
+    F(glTexParameteri) \
+    F(glTexSubImage2D) \
+    F(glUnmapBuffer)
+
+namespace {
+
+enum FunctionId {
+#define F(name) Id_##name,
+    STUB_FUNCTIONS(F)
+#undef F
+    FunctionCount
+};
+
+const char* const functionNames[FunctionCount] = {
+#define F(name) #name,
+    STUB_FUNCTIONS(F)
+#undef F
+};
+
+std::atomic<unsigned long> calls[FunctionCount];
+
+#define COUNT(name) calls[Id_##name].fetch_add(1, std::memory_order_relaxed)
+
+enum {
+    StubDeviceCount = 2,
+    StubConfigCount = 6,
+    StubDisplayCount = StubDeviceCount + 1
+};
+
+struct StubDevice {
+    const char* extensions;
+    const char* drmDevice;
+};
+
+const StubDevice devices[StubDeviceCount] = {
+    { "EGL_EXT_device_drm", "/dev/dri/card0" },
+    { "EGL_MESA_device_software", nullptr },
+};
+
+struct StubConfig {
+    EGLint red, green, blue, alpha, depth, stencil, samples;
+};
+
+const StubConfig configTemplates[StubConfigCount] = {
+    { 8, 8, 8, 8, 24, 8, 0 },
+    { 8, 8, 8, 8, 24, 8, 4 },
+    { 8, 8, 8, 0, 24, 8, 0 },
+    { 8, 8, 8, 0, 0, 0, 0 },
+    { 5, 6, 5, 0, 16, 0, 0 },
+    { 10, 10, 10, 2, 24, 8, 0 },
+};
+
+struct StubDisplay {
+    int configIds[StubConfigCount];
+    bool initialized;
+    bool blobCacheSet;
+};
+
+StubDisplay displays[StubDisplayCount];
+// displays[0] is the default display, displays[1 + i] belongs to devices[i]
+StubDisplay* const defaultDisplay = &displays[0];
+
+thread_local EGLint lastError = EGL_SUCCESS;
+thread_local EGLenum boundAPI = EGL_OPENGL_ES_API;
+thread_local EGLContext currentContext = EGL_NO_CONTEXT;
+
+int contextObject;
+int surfaceObject;
+int syncObject;
+
+const char* const clientExtensions =
+    "EGL_EXT_client_extensions EGL_EXT_platform_base EGL_EXT_device_base EGL_EXT_device_enumeration "
+    "EGL_EXT_device_query EGL_EXT_platform_device EGL_KHR_platform_gbm";
+const char* const displayExtensions =
+    "EGL_KHR_create_context EGL_KHR_no_config_context EGL_KHR_surfaceless_context EGL_KHR_fence_sync "
+    "EGL_KHR_image_base EGL_KHR_gl_texture_2D_image EGL_EXT_image_dma_buf_import "
+    "EGL_EXT_image_dma_buf_import_modifiers EGL_ANDROID_blob_cache";
+
+// the last functions set by eglSetBlobCacheFuncsANDROID on any display
+EGLSetBlobFuncANDROID blobSet = nullptr;
+EGLGetBlobFuncANDROID blobGet = nullptr;
+
+// shader objects are their sources, program objects have no state
+std::mutex shaderMutex;
+std::map<unsigned int, std::string> shaders;
+unsigned int nextShader = 1;
+
+/** Textures only store their first pixel, which is all readback returns. */
+struct StubTexel {
+    unsigned char bytes[4];
+};
+
+// texture, framebuffer and buffer objects, bindings are per thread since eglinfo uses each
+// context on a single thread
+std::mutex objectMutex;
+std::map<unsigned int, std::shared_ptr<StubTexel>> textures;
+// framebuffers map to the texture attached to them
+std::map<unsigned int, unsigned int> framebuffers;
+std::map<unsigned int, std::vector<unsigned char>> buffers;
+unsigned int nextObject = 1;
+thread_local unsigned int boundTexture = 0;
+thread_local unsigned int boundFramebuffer = 0;
+thread_local unsigned int boundPackBuffer = 0;
+
+/** EGLImages share the texel of the texture they were created from with every importer. */
+struct StubImage {
+    std::shared_ptr<StubTexel> texel;
+};
+
+std::set<StubImage*> images;
+
+struct StubDmaBufFormat {
+    EGLint fourcc;
+    int modifierCount;
+    EGLuint64KHR modifiers[3];
+    EGLBoolean externalOnly[3];
+};
+
+// deliberately unsorted, eglinfo sorts them
+const StubDmaBufFormat dmaBufFormats[] = {
+    { 0x34325258 /* XR24 */, 3, { 0x0100000000000002, 0, 0x0100000000000001 }, { EGL_FALSE, EGL_FALSE, EGL_FALSE } },
+    { 0x34325241 /* AR24 */, 2, { 0, 0x0100000000000001 }, { EGL_FALSE, EGL_FALSE } },
+    { 0x3231564e /* NV12 */, 1, { 0 }, { EGL_TRUE } },
+};
+const int dmaBufFormatCount = sizeof(dmaBufFormats) / sizeof(dmaBufFormats[0]);
+
+/** Largest pbuffer that can actually be created, a fraction of the reported 8192x8192. */
+const int64_t stubPbufferPixels = 3000 * 3000;
+
+template <typename T>
+T fail(EGLint error, T result)
+{
+    lastError = error;
+    return result;
+}
+
+StubDisplay* toDisplay(EGLDisplay dpy)
+{
+    for (StubDisplay &display : displays) {
+        if (dpy == &display)
+            return &display;
+    }
+    return nullptr;
+}
+
+const StubDevice* toDevice(EGLDeviceEXT device)
+{
+    for (const StubDevice &d : devices) {
+        if (device == &d)
+            return &d;
+    }
+    return nullptr;
+}
+
+/** Configs are encoded as the 1-based index into configTemplates. */
+int toConfigIndex(EGLConfig config)
+{
+    const intptr_t index = reinterpret_cast<intptr_t>(config) - 1;
+    return index >= 0 && index < StubConfigCount ? int(index) : -1;
+}
+
+bool configAttrib(int index, EGLint attribute, EGLint* value)
+{
+    const StubConfig &c = configTemplates[index];
+    switch (attribute) {
+        case EGL_RED_SIZE: *value = c.red; break;
+        case EGL_GREEN_SIZE: *value = c.green; break;
+        case EGL_BLUE_SIZE: *value = c.blue; break;
+        case EGL_ALPHA_SIZE: *value = c.alpha; break;
+        case EGL_BUFFER_SIZE: *value = c.red + c.green + c.blue + c.alpha; break;
+        case EGL_DEPTH_SIZE: *value = c.depth; break;
+        case EGL_STENCIL_SIZE: *value = c.stencil; break;
+        case EGL_SAMPLES: *value = c.samples; break;
+        case EGL_SAMPLE_BUFFERS: *value = c.samples ? 1 : 0; break;
+        case EGL_CONFIG_ID: *value = index + 1; break;
+        case EGL_CONFIG_CAVEAT: *value = EGL_NONE; break;
+        case EGL_COLOR_BUFFER_TYPE: *value = EGL_RGB_BUFFER; break;
+        case EGL_RENDERABLE_TYPE:
+        case EGL_CONFORMANT: *value = EGL_OPENGL_BIT | EGL_OPENGL_ES2_BIT | EGL_OPENGL_ES3_BIT; break;
+        case EGL_SURFACE_TYPE: *value = EGL_WINDOW_BIT | EGL_PBUFFER_BIT; break;
+        case EGL_MAX_PBUFFER_WIDTH:
+        case EGL_MAX_PBUFFER_HEIGHT: *value = 8192; break;
+        case EGL_MAX_PBUFFER_PIXELS: *value = 8192 * 8192; break;
+        case EGL_MAX_SWAP_INTERVAL: *value = 1; break;
+        case EGL_MIN_SWAP_INTERVAL: *value = 0; break;
+        case EGL_NATIVE_RENDERABLE: *value = EGL_FALSE; break;
+        case EGL_NATIVE_VISUAL_TYPE: *value = EGL_NONE; break;
+        case EGL_TRANSPARENT_TYPE: *value = EGL_NONE; break;
+        case EGL_ALPHA_MASK_SIZE:
+        case EGL_BIND_TO_TEXTURE_RGB:
+        case EGL_BIND_TO_TEXTURE_RGBA:
+        case EGL_LEVEL:
+        case EGL_LUMINANCE_SIZE:
+        case EGL_NATIVE_VISUAL_ID:
+        case EGL_TRANSPARENT_RED_VALUE:
+        case EGL_TRANSPARENT_GREEN_VALUE:
+        case EGL_TRANSPARENT_BLUE_VALUE: *value = 0; break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void writeCalls(FILE* out)
+{
+    for (int i = 0; i < FunctionCount; ++i) {
+        const unsigned long count = calls[i].load(std::memory_order_relaxed);
+        if (count)
+            fprintf(out, "%s %lu\n", functionNames[i], count);
+    }
+}
+
+/** Compares the calls made against the "function count" lines in @p fileName. */
+bool checkCalls(const char* fileName)
+{
+    FILE *in = fopen(fileName, "r");
+    if (!in) {
+        fprintf(stderr, "eglinfo-stub: cannot open %s\n", fileName);
+        return false;
+    }
+    std::map<std::string, unsigned long> expected;
+    char name[128];
+    unsigned long count;
+    while (fscanf(in, "%127s %lu", name, &count) == 2)
+        expected[name] = count;
+    fclose(in);
+
+    bool ok = true;
+    for (int i = 0; i < FunctionCount; ++i) {
+        const unsigned long actual = calls[i].load(std::memory_order_relaxed);
+        const auto it = expected.find(functionNames[i]);
+        const unsigned long wanted = it == expected.end() ? 0 : it->second;
+        if (actual != wanted) {
+            fprintf(stderr, "eglinfo-stub: %s called %lu times, expected %lu\n", functionNames[i], actual, wanted);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+__attribute__((destructor)) void reportCalls()
+{
+    if (const char *fileName = getenv("EGLINFO_STUB_CALLS")) {
+        FILE *out = strcmp(fileName, "-") == 0 ? stderr : fopen(fileName, "w");
+        if (out) {
+            writeCalls(out);
+            if (out != stderr)
+                fclose(out);
+        }
+    }
+    if (const char *fileName = getenv("EGLINFO_STUB_EXPECT")) {
+        if (!checkCalls(fileName)) {
+            fflush(nullptr);
+            _exit(2);
+        }
+    }
+}
+
+}
+
+extern "C" {
+
+EGLint EGLAPIENTRY eglGetError(void)
+{
+    COUNT(eglGetError);
+    const EGLint error = lastError;
+    lastError = EGL_SUCCESS;
+    return error;
+}
+
+EGLDisplay EGLAPIENTRY eglGetDisplay(EGLNativeDisplayType display_id)
+{
+    COUNT(eglGetDisplay);
+    return display_id == EGL_DEFAULT_DISPLAY ? defaultDisplay : EGL_NO_DISPLAY;
+}
+
+static EGLDisplay platformDisplay(EGLenum platform, void* native_display)
+{
+    if (platform != EGL_PLATFORM_DEVICE_EXT)
+        return fail(EGL_BAD_PARAMETER, EGL_NO_DISPLAY);
+    const StubDevice *device = toDevice(native_display);
+    if (!device)
+        return fail(EGL_BAD_PARAMETER, EGL_NO_DISPLAY);
+    return &displays[1 + (device - devices)];
+}
+
+EGLDisplay EGLAPIENTRY eglGetPlatformDisplay(EGLenum platform, void* native_display, const EGLAttrib* /*attrib_list*/)
+{
+    COUNT(eglGetPlatformDisplay);
+    return platformDisplay(platform, native_display);
+}
+
+static EGLDisplay EGLAPIENTRY stubGetPlatformDisplayEXT(EGLenum platform, void* native_display, const EGLint* /*attrib_list*/)
+{
+    COUNT(eglGetPlatformDisplayEXT);
+    return platformDisplay(platform, native_display);
+}
+
+// like a vendor stack, load the "driver" named by EGLINFO_STUB_DRIVER on the first initialization
+static void loadDriver()
+{
+    static std::once_flag once;
+    std::call_once(once, [] {
+        const char *driver = getenv("EGLINFO_STUB_DRIVER");
+        if (driver && *driver && !dlopen(driver, RTLD_NOW | RTLD_LOCAL))
+            fprintf(stderr, "eglinfo stub: %s\n", dlerror());
+    });
+}
+
+static void waitForRelease()
+{
+    static const int fd = [] {
+        const char *env = getenv("EGLINFO_STUB_BLOCK_FD");
+        return env && *env ? atoi(env) : -1;
+    }();
+    if (fd < 0)
+        return;
+    char byte;
+    while (read(fd, &byte, 1) < 0 && errno == EINTR) {
+    }
+}
+
+EGLBoolean EGLAPIENTRY eglInitialize(EGLDisplay dpy, EGLint* major, EGLint* minor)
+{
+    COUNT(eglInitialize);
+    StubDisplay *display = toDisplay(dpy);
+    if (!display)
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    loadDriver();
+    waitForRelease();
+    display->initialized = true;
+    if (major)
+        *major = 1;
+    if (minor)
+        *minor = 5;
+    return EGL_TRUE;
+}
+
+EGLBoolean EGLAPIENTRY eglTerminate(EGLDisplay dpy)
+{
+    COUNT(eglTerminate);
+    StubDisplay *display = toDisplay(dpy);
+    if (!display)
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    display->initialized = false;
+    return EGL_TRUE;
+}
+
+const char* EGLAPIENTRY eglQueryString(EGLDisplay dpy, EGLint name)
+{
+    COUNT(eglQueryString);
+    if (dpy == EGL_NO_DISPLAY)
+        return name == EGL_EXTENSIONS ? clientExtensions : fail(EGL_BAD_DISPLAY, nullptr);
+    StubDisplay *display = toDisplay(dpy);
+    if (!display)
+        return fail(EGL_BAD_DISPLAY, nullptr);
+    if (!display->initialized)
+        return fail(EGL_NOT_INITIALIZED, nullptr);
+    switch (name) {
+        case EGL_CLIENT_APIS: return "OpenGL OpenGL_ES";
+        case EGL_EXTENSIONS: return displayExtensions;
+        case EGL_VENDOR: return "eglinfo stub";
+        case EGL_VERSION: return "1.5 eglinfo stub";
+    }
+    return fail(EGL_BAD_PARAMETER, nullptr);
+}
+
+static EGLBoolean listConfigs(EGLDisplay dpy, EGLConfig* configs, EGLint config_size, EGLint* num_config)
+{
+    StubDisplay *display = toDisplay(dpy);
+    if (!display)
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (!display->initialized)
+        return fail(EGL_NOT_INITIALIZED, EGL_FALSE);
+    if (!num_config)
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    if (!configs) {
+        *num_config = StubConfigCount;
+        return EGL_TRUE;
+    }
+    *num_config = config_size < StubConfigCount ? config_size : StubConfigCount;
+    for (int i = 0; i < *num_config; ++i)
+        configs[i] = reinterpret_cast<EGLConfig>(intptr_t(i + 1));
+    return EGL_TRUE;
+}
+
+EGLBoolean EGLAPIENTRY eglGetConfigs(EGLDisplay dpy, EGLConfig* configs, EGLint config_size, EGLint* num_config)
+{
+    COUNT(eglGetConfigs);
+    return listConfigs(dpy, configs, config_size, num_config);
+}
+
+EGLBoolean EGLAPIENTRY eglGetConfigAttrib(EGLDisplay dpy, EGLConfig config, EGLint attribute, EGLint* value)
+{
+    COUNT(eglGetConfigAttrib);
+    StubDisplay *display = toDisplay(dpy);
+    if (!display)
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    const int index = toConfigIndex(config);
+    if (index < 0)
+        return fail(EGL_BAD_CONFIG, EGL_FALSE);
+    if (!configAttrib(index, attribute, value))
+        return fail(EGL_BAD_ATTRIBUTE, EGL_FALSE);
+    return EGL_TRUE;
+}
+
+EGLBoolean EGLAPIENTRY eglChooseConfig(EGLDisplay dpy, const EGLint* /*attrib_list*/, EGLConfig* configs, EGLint config_size, EGLint* num_config)
+{
+    COUNT(eglChooseConfig);
+    // no filtering, every stub config matches
+    return listConfigs(dpy, configs, config_size, num_config);
+}
+
+EGLBoolean EGLAPIENTRY eglBindAPI(EGLenum api)
+{
+    COUNT(eglBindAPI);
+    if (api != EGL_OPENGL_API && api != EGL_OPENGL_ES_API)
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    boundAPI = api;
+    return EGL_TRUE;
+}
+
+EGLenum EGLAPIENTRY eglQueryAPI(void)
+{
+    COUNT(eglQueryAPI);
+    return boundAPI;
+}
+
+EGLContext EGLAPIENTRY eglCreateContext(EGLDisplay dpy, EGLConfig /*config*/, EGLContext /*share_context*/, const EGLint* /*attrib_list*/)
+{
+    COUNT(eglCreateContext);
+    StubDisplay *display = toDisplay(dpy);
+    if (!display)
+        return fail(EGL_BAD_DISPLAY, EGL_NO_CONTEXT);
+    if (!display->initialized)
+        return fail(EGL_NOT_INITIALIZED, EGL_NO_CONTEXT);
+    return &contextObject;
+}
+
+EGLBoolean EGLAPIENTRY eglDestroyContext(EGLDisplay dpy, EGLContext ctx)
+{
+    COUNT(eglDestroyContext);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (ctx != &contextObject)
+        return fail(EGL_BAD_CONTEXT, EGL_FALSE);
+    return EGL_TRUE;
+}
+
+EGLBoolean EGLAPIENTRY eglQueryContext(EGLDisplay dpy, EGLContext ctx, EGLint attribute, EGLint* value)
+{
+    COUNT(eglQueryContext);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (ctx != &contextObject)
+        return fail(EGL_BAD_CONTEXT, EGL_FALSE);
+    switch (attribute) {
+        case EGL_CONTEXT_CLIENT_TYPE: *value = boundAPI; return EGL_TRUE;
+        case EGL_CONTEXT_CLIENT_VERSION: *value = 3; return EGL_TRUE;
+        case EGL_RENDER_BUFFER: *value = EGL_BACK_BUFFER; return EGL_TRUE;
+    }
+    return fail(EGL_BAD_ATTRIBUTE, EGL_FALSE);
+}
+
+EGLSurface EGLAPIENTRY eglCreatePbufferSurface(EGLDisplay dpy, EGLConfig config, const EGLint* attrib_list)
+{
+    COUNT(eglCreatePbufferSurface);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_NO_SURFACE);
+    if (toConfigIndex(config) < 0)
+        return fail(EGL_BAD_CONFIG, EGL_NO_SURFACE);
+    int64_t width = 0;
+    int64_t height = 0;
+    for (const EGLint *attrib = attrib_list; attrib && *attrib != EGL_NONE; attrib += 2) {
+        if (attrib[0] == EGL_WIDTH)
+            width = attrib[1];
+        else if (attrib[0] == EGL_HEIGHT)
+            height = attrib[1];
+    }
+    // runs out of memory well below the reported EGL_MAX_PBUFFER_PIXELS, like many boards do
+    if (width * height > stubPbufferPixels)
+        return fail(EGL_BAD_ALLOC, EGL_NO_SURFACE);
+    return &surfaceObject;
+}
+
+EGLBoolean EGLAPIENTRY eglDestroySurface(EGLDisplay dpy, EGLSurface surface)
+{
+    COUNT(eglDestroySurface);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (surface != &surfaceObject)
+        return fail(EGL_BAD_SURFACE, EGL_FALSE);
+    return EGL_TRUE;
+}
+
+EGLBoolean EGLAPIENTRY eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint* value)
+{
+    COUNT(eglQuerySurface);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (surface != &surfaceObject)
+        return fail(EGL_BAD_SURFACE, EGL_FALSE);
+    switch (attribute) {
+        case EGL_WIDTH:
+        case EGL_HEIGHT: *value = 1; return EGL_TRUE;
+    }
+    return fail(EGL_BAD_ATTRIBUTE, EGL_FALSE);
+}
+
+EGLBoolean EGLAPIENTRY eglMakeCurrent(EGLDisplay dpy, EGLSurface /*draw*/, EGLSurface /*read*/, EGLContext ctx)
+{
+    COUNT(eglMakeCurrent);
+    if (!toDisplay(dpy) && dpy != EGL_NO_DISPLAY)
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (ctx != EGL_NO_CONTEXT && ctx != &contextObject)
+        return fail(EGL_BAD_CONTEXT, EGL_FALSE);
+    currentContext = ctx;
+    return EGL_TRUE;
+}
+
+EGLContext EGLAPIENTRY eglGetCurrentContext(void)
+{
+    COUNT(eglGetCurrentContext);
+    return currentContext;
+}
+
+EGLBoolean EGLAPIENTRY eglSwapBuffers(EGLDisplay dpy, EGLSurface surface)
+{
+    COUNT(eglSwapBuffers);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (surface != &surfaceObject)
+        return fail(EGL_BAD_SURFACE, EGL_FALSE);
+    return EGL_TRUE;
+}
+
+EGLBoolean EGLAPIENTRY eglReleaseThread(void)
+{
+    COUNT(eglReleaseThread);
+    currentContext = EGL_NO_CONTEXT;
+    boundAPI = EGL_OPENGL_ES_API;
+    return EGL_TRUE;
+}
+
+}
+
+static EGLBoolean EGLAPIENTRY stubQueryDevicesEXT(EGLint max_devices, EGLDeviceEXT* devicesOut, EGLint* num_devices)
+{
+    COUNT(eglQueryDevicesEXT);
+    if (!num_devices)
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    if (!devicesOut) {
+        *num_devices = StubDeviceCount;
+        return EGL_TRUE;
+    }
+    *num_devices = max_devices < StubDeviceCount ? max_devices : StubDeviceCount;
+    for (int i = 0; i < *num_devices; ++i)
+        devicesOut[i] = const_cast<StubDevice*>(&devices[i]);
+    return EGL_TRUE;
+}
+
+static const char* EGLAPIENTRY stubQueryDeviceStringEXT(EGLDeviceEXT deviceHandle, EGLint name)
+{
+    COUNT(eglQueryDeviceStringEXT);
+    const StubDevice *device = toDevice(deviceHandle);
+    if (!device)
+        return fail(EGL_BAD_DEVICE_EXT, nullptr);
+    switch (name) {
+        case EGL_EXTENSIONS: return device->extensions;
+        case EGL_DRM_DEVICE_FILE_EXT:
+            if (device->drmDevice)
+                return device->drmDevice;
+            break;
+    }
+    return fail(EGL_BAD_PARAMETER, nullptr);
+}
+
+static EGLBoolean EGLAPIENTRY stubQueryDmaBufFormatsEXT(EGLDisplay dpy, EGLint max_formats, EGLint* formats, EGLint* num_formats)
+{
+    COUNT(eglQueryDmaBufFormatsEXT);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (!num_formats || max_formats < 0 || (max_formats > 0 && !formats))
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    if (max_formats == 0) {
+        *num_formats = dmaBufFormatCount;
+        return EGL_TRUE;
+    }
+    *num_formats = max_formats < dmaBufFormatCount ? max_formats : dmaBufFormatCount;
+    for (int i = 0; i < *num_formats; ++i)
+        formats[i] = dmaBufFormats[i].fourcc;
+    return EGL_TRUE;
+}
+
+static EGLBoolean EGLAPIENTRY stubQueryDmaBufModifiersEXT(EGLDisplay dpy, EGLint format, EGLint max_modifiers, EGLuint64KHR* modifiers, EGLBoolean* external_only, EGLint* num_modifiers)
+{
+    COUNT(eglQueryDmaBufModifiersEXT);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (!num_modifiers || max_modifiers < 0 || (max_modifiers > 0 && !modifiers))
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    for (const StubDmaBufFormat &entry : dmaBufFormats) {
+        if (entry.fourcc != format)
+            continue;
+        if (max_modifiers == 0) {
+            *num_modifiers = entry.modifierCount;
+            return EGL_TRUE;
+        }
+        *num_modifiers = max_modifiers < entry.modifierCount ? max_modifiers : entry.modifierCount;
+        for (int i = 0; i < *num_modifiers; ++i) {
+            modifiers[i] = entry.modifiers[i];
+            if (external_only)
+                external_only[i] = entry.externalOnly[i];
+        }
+        return EGL_TRUE;
+    }
+    return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+}
+
+static EGLSyncKHR EGLAPIENTRY stubCreateSyncKHR(EGLDisplay dpy, EGLenum type, const EGLint* /*attrib_list*/)
+{
+    COUNT(eglCreateSyncKHR);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_NO_SYNC_KHR);
+    if (type != EGL_SYNC_FENCE_KHR)
+        return fail(EGL_BAD_ATTRIBUTE, EGL_NO_SYNC_KHR);
+    if (currentContext == EGL_NO_CONTEXT)
+        return fail(EGL_BAD_MATCH, EGL_NO_SYNC_KHR);
+    return &syncObject;
+}
+
+static EGLBoolean EGLAPIENTRY stubDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync)
+{
+    COUNT(eglDestroySyncKHR);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (sync != &syncObject)
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    return EGL_TRUE;
+}
+
+static EGLint EGLAPIENTRY stubClientWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint /*flags*/, EGLTimeKHR /*timeout*/)
+{
+    COUNT(eglClientWaitSyncKHR);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    if (sync != &syncObject)
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    // stub fences are signaled immediately
+    return EGL_CONDITION_SATISFIED_KHR;
+}
+
+static EGLBoolean EGLAPIENTRY stubQueryDeviceAttribEXT(EGLDeviceEXT deviceHandle, EGLint /*attribute*/, EGLAttrib* /*value*/)
+{
+    COUNT(eglQueryDeviceAttribEXT);
+    if (!toDevice(deviceHandle))
+        return fail(EGL_BAD_DEVICE_EXT, EGL_FALSE);
+    return fail(EGL_BAD_ATTRIBUTE, EGL_FALSE);
+}
+
+static EGLImageKHR EGLAPIENTRY stubCreateImageKHR(EGLDisplay dpy, EGLContext ctx, EGLenum target, EGLClientBuffer buffer,
+                                                  const EGLint* /*attrib_list*/)
+{
+    COUNT(eglCreateImageKHR);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_NO_IMAGE_KHR);
+    if (ctx != &contextObject)
+        return fail(EGL_BAD_CONTEXT, EGL_NO_IMAGE_KHR);
+    if (target != EGL_GL_TEXTURE_2D_KHR)
+        return fail(EGL_BAD_PARAMETER, EGL_NO_IMAGE_KHR);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto texture = textures.find(static_cast<unsigned int>(reinterpret_cast<uintptr_t>(buffer)));
+    if (texture == textures.end())
+        return fail(EGL_BAD_PARAMETER, EGL_NO_IMAGE_KHR);
+    StubImage *image = new StubImage{ texture->second };
+    images.insert(image);
+    return image;
+}
+
+static EGLBoolean EGLAPIENTRY stubDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image)
+{
+    COUNT(eglDestroyImageKHR);
+    if (!toDisplay(dpy))
+        return fail(EGL_BAD_DISPLAY, EGL_FALSE);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    if (!images.erase(static_cast<StubImage*>(image)))
+        return fail(EGL_BAD_PARAMETER, EGL_FALSE);
+    delete static_cast<StubImage*>(image);
+    return EGL_TRUE;
+}
+
+// GL entry points, enough for eglinfo --contexts, --bench-shaders, --bench-transfer and
+// --bench-eglimage
+
+static unsigned int KHRONOS_APIENTRY stubGlGetError()
+{
+    COUNT(glGetError);
+    return 0;
+}
+
+static void KHRONOS_APIENTRY stubGlGetIntegerv(unsigned int name, int* data)
+{
+    COUNT(glGetIntegerv);
+    switch (name) {
+        case 0x0D33: // GL_MAX_TEXTURE_SIZE
+        case 0x84E8: // GL_MAX_RENDERBUFFER_SIZE
+            data[0] = 8192;
+            break;
+        case 0x0D3A: // GL_MAX_VIEWPORT_DIMS
+            data[0] = data[1] = 8192;
+            break;
+        case 0x8D57: // GL_MAX_SAMPLES
+            data[0] = 4;
+            break;
+        case 0x821D: // GL_NUM_EXTENSIONS
+            data[0] = 3;
+            break;
+        case 0x8B9B: // GL_IMPLEMENTATION_COLOR_READ_FORMAT
+            data[0] = 0x80E1; // GL_BGRA
+            break;
+        case 0x8B9A: // GL_IMPLEMENTATION_COLOR_READ_TYPE
+            data[0] = 0x1401; // GL_UNSIGNED_BYTE
+            break;
+    }
+}
+
+static const unsigned char* KHRONOS_APIENTRY stubGlGetString(unsigned int name)
+{
+    COUNT(glGetString);
+    const char *value = nullptr;
+    switch (name) {
+        case 0x1F00: value = "eglinfo stub"; break; // GL_VENDOR
+        case 0x1F01: value = "stub renderer"; break; // GL_RENDERER
+        case 0x1F02: value = boundAPI == EGL_OPENGL_API ? "4.5 stub" : "OpenGL ES 3.2 stub"; break; // GL_VERSION
+        case 0x1F03: value = "GL_EXT_stub_a GL_EXT_stub_b GL_OES_EGL_image"; break; // GL_EXTENSIONS
+        case 0x8B8C: value = "4.50 stub"; break; // GL_SHADING_LANGUAGE_VERSION
+    }
+    return reinterpret_cast<const unsigned char*>(value);
+}
+
+static const unsigned char* KHRONOS_APIENTRY stubGlGetStringi(unsigned int name, unsigned int index)
+{
+    COUNT(glGetStringi);
+    static const char* const extensions[] = { "GL_EXT_stub_a", "GL_EXT_stub_b", "GL_OES_EGL_image" };
+    if (name != 0x1F03 || index >= 3)
+        return nullptr;
+    return reinterpret_cast<const unsigned char*>(extensions[index]);
+}
+
+static void EGLAPIENTRY stubSetBlobCacheFuncsANDROID(EGLDisplay dpy, EGLSetBlobFuncANDROID set, EGLGetBlobFuncANDROID get)
+{
+    COUNT(eglSetBlobCacheFuncsANDROID);
+    StubDisplay *display = toDisplay(dpy);
+    if (!display || !set || !get || display->blobCacheSet) {
+        lastError = EGL_BAD_PARAMETER;
+        return;
+    }
+    display->blobCacheSet = true;
+    blobSet = set;
+    blobGet = get;
+}
+
+static unsigned int KHRONOS_APIENTRY stubGlCreateShader(unsigned int /*type*/)
+{
+    COUNT(glCreateShader);
+    std::lock_guard<std::mutex> lock(shaderMutex);
+    shaders[nextShader] = std::string();
+    return nextShader++;
+}
+
+static void KHRONOS_APIENTRY stubGlShaderSource(unsigned int shader, int count, const char* const* strings, const int* lengths)
+{
+    COUNT(glShaderSource);
+    std::lock_guard<std::mutex> lock(shaderMutex);
+    std::string &source = shaders[shader];
+    source.clear();
+    for (int i = 0; i < count; ++i)
+        source.append(strings[i], lengths && lengths[i] >= 0 ? size_t(lengths[i]) : strlen(strings[i]));
+}
+
+// looks the "binary" up in the application's blob cache and stores it on a miss, like drivers do
+static void KHRONOS_APIENTRY stubGlCompileShader(unsigned int shader)
+{
+    COUNT(glCompileShader);
+    std::string key;
+    {
+        std::lock_guard<std::mutex> lock(shaderMutex);
+        key = shaders[shader];
+    }
+    static const char binary[] = "stub shader binary";
+    if (!blobGet)
+        return;
+    const EGLsizeiANDROID size = blobGet(key.data(), key.size(), nullptr, 0);
+    if (size == 0) {
+        blobSet(key.data(), key.size(), binary, sizeof(binary));
+        return;
+    }
+    std::string cached(size, '\0');
+    blobGet(key.data(), key.size(), &cached[0], size);
+}
+
+static void KHRONOS_APIENTRY stubGlDeleteShader(unsigned int shader)
+{
+    COUNT(glDeleteShader);
+    std::lock_guard<std::mutex> lock(shaderMutex);
+    shaders.erase(shader);
+}
+
+static unsigned int KHRONOS_APIENTRY stubGlCreateProgram()
+{
+    COUNT(glCreateProgram);
+    return 1;
+}
+
+static void KHRONOS_APIENTRY stubGlAttachShader(unsigned int /*program*/, unsigned int /*shader*/)
+{
+    COUNT(glAttachShader);
+}
+
+static void KHRONOS_APIENTRY stubGlLinkProgram(unsigned int /*program*/)
+{
+    COUNT(glLinkProgram);
+}
+
+static void KHRONOS_APIENTRY stubGlDeleteProgram(unsigned int /*program*/)
+{
+    COUNT(glDeleteProgram);
+}
+
+// everything compiles and links, without log
+static void KHRONOS_APIENTRY stubGlGetShaderiv(unsigned int /*shader*/, unsigned int name, int* value)
+{
+    COUNT(glGetShaderiv);
+    *value = name == 0x8B81 /* GL_COMPILE_STATUS */ ? 1 : 0;
+}
+
+static void KHRONOS_APIENTRY stubGlGetProgramiv(unsigned int /*program*/, unsigned int name, int* value)
+{
+    COUNT(glGetProgramiv);
+    *value = name == 0x8B82 /* GL_LINK_STATUS */ ? 1 : 0;
+}
+
+static void KHRONOS_APIENTRY stubGlGetShaderInfoLog(unsigned int /*shader*/, int size, int* length, char* log)
+{
+    COUNT(glGetShaderInfoLog);
+    if (length)
+        *length = 0;
+    if (size > 0)
+        *log = '\0';
+}
+
+static void KHRONOS_APIENTRY stubGlGetProgramInfoLog(unsigned int /*program*/, int size, int* length, char* log)
+{
+    COUNT(glGetProgramInfoLog);
+    if (length)
+        *length = 0;
+    if (size > 0)
+        *log = '\0';
+}
+
+static int bytesPerPixel(unsigned int format, unsigned int type)
+{
+    if (type == 0x8363) // GL_UNSIGNED_SHORT_5_6_5
+        return 2;
+    switch (format) {
+        case 0x1909: return 1; // GL_LUMINANCE
+        case 0x1907: return 3; // GL_RGB
+        default: return 4;
+    }
+}
+
+static void KHRONOS_APIENTRY stubGlGenTextures(int count, unsigned int* names)
+{
+    COUNT(glGenTextures);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    for (int i = 0; i < count; ++i) {
+        names[i] = nextObject++;
+        textures[names[i]] = std::make_shared<StubTexel>();
+    }
+}
+
+static void KHRONOS_APIENTRY stubGlDeleteTextures(int count, const unsigned int* names)
+{
+    COUNT(glDeleteTextures);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    for (int i = 0; i < count; ++i) {
+        textures.erase(names[i]);
+        if (boundTexture == names[i])
+            boundTexture = 0;
+    }
+}
+
+static void KHRONOS_APIENTRY stubGlBindTexture(unsigned int /*target*/, unsigned int texture)
+{
+    COUNT(glBindTexture);
+    boundTexture = texture;
+}
+
+static void KHRONOS_APIENTRY stubGlTexParameteri(unsigned int /*target*/, unsigned int /*name*/, int /*value*/)
+{
+    COUNT(glTexParameteri);
+}
+
+/** Stores the first pixel of @p pixels in the bound texture. */
+static void setTexel(unsigned int format, unsigned int type, const void* pixels)
+{
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto texture = textures.find(boundTexture);
+    if (texture == textures.end())
+        return;
+    StubTexel &texel = *texture->second;
+    memset(texel.bytes, 0, sizeof(texel.bytes));
+    if (pixels)
+        memcpy(texel.bytes, pixels, bytesPerPixel(format, type));
+}
+
+static void KHRONOS_APIENTRY stubGlTexImage2D(unsigned int /*target*/, int /*level*/, int /*internalFormat*/, int /*width*/, int /*height*/,
+                                              int /*border*/, unsigned int format, unsigned int type, const void* pixels)
+{
+    COUNT(glTexImage2D);
+    setTexel(format, type, pixels);
+}
+
+static void KHRONOS_APIENTRY stubGlTexSubImage2D(unsigned int /*target*/, int /*level*/, int x, int y, int /*width*/, int /*height*/,
+                                                 unsigned int format, unsigned int type, const void* pixels)
+{
+    COUNT(glTexSubImage2D);
+    if (x == 0 && y == 0)
+        setTexel(format, type, pixels);
+}
+
+// the bound texture shares the image's texel from now on
+static void KHRONOS_APIENTRY stubGlEGLImageTargetTexture2DOES(unsigned int /*target*/, void* image)
+{
+    COUNT(glEGLImageTargetTexture2DOES);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto texture = textures.find(boundTexture);
+    if (texture != textures.end() && images.count(static_cast<StubImage*>(image)))
+        texture->second = static_cast<StubImage*>(image)->texel;
+}
+
+static void KHRONOS_APIENTRY stubGlPixelStorei(unsigned int /*name*/, int /*value*/)
+{
+    COUNT(glPixelStorei);
+}
+
+static void KHRONOS_APIENTRY stubGlGenFramebuffers(int count, unsigned int* names)
+{
+    COUNT(glGenFramebuffers);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    for (int i = 0; i < count; ++i) {
+        names[i] = nextObject++;
+        framebuffers[names[i]] = 0;
+    }
+}
+
+static void KHRONOS_APIENTRY stubGlDeleteFramebuffers(int count, const unsigned int* names)
+{
+    COUNT(glDeleteFramebuffers);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    for (int i = 0; i < count; ++i) {
+        framebuffers.erase(names[i]);
+        if (boundFramebuffer == names[i])
+            boundFramebuffer = 0;
+    }
+}
+
+static void KHRONOS_APIENTRY stubGlBindFramebuffer(unsigned int /*target*/, unsigned int framebuffer)
+{
+    COUNT(glBindFramebuffer);
+    boundFramebuffer = framebuffer;
+}
+
+static void KHRONOS_APIENTRY stubGlFramebufferTexture2D(unsigned int /*target*/, unsigned int /*attachment*/, unsigned int /*textureTarget*/,
+                                                        unsigned int texture, int /*level*/)
+{
+    COUNT(glFramebufferTexture2D);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto framebuffer = framebuffers.find(boundFramebuffer);
+    if (framebuffer != framebuffers.end())
+        framebuffer->second = texture;
+}
+
+static unsigned int KHRONOS_APIENTRY stubGlCheckFramebufferStatus(unsigned int /*target*/)
+{
+    COUNT(glCheckFramebufferStatus);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto framebuffer = framebuffers.find(boundFramebuffer);
+    if (framebuffer == framebuffers.end() || !textures.count(framebuffer->second))
+        return 0x8CD7; // GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT
+    return 0x8CD5; // GL_FRAMEBUFFER_COMPLETE
+}
+
+// only the first pixel is written, into the bound pixel pack buffer if there is one
+static void KHRONOS_APIENTRY stubGlReadPixels(int /*x*/, int /*y*/, int /*width*/, int /*height*/, unsigned int format, unsigned int type,
+                                              void* pixels)
+{
+    COUNT(glReadPixels);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto framebuffer = framebuffers.find(boundFramebuffer);
+    if (framebuffer == framebuffers.end())
+        return;
+    const auto texture = textures.find(framebuffer->second);
+    if (texture == textures.end())
+        return;
+    const size_t size = bytesPerPixel(format, type);
+    unsigned char *destination = static_cast<unsigned char*>(pixels);
+    if (boundPackBuffer) {
+        std::vector<unsigned char> &buffer = buffers[boundPackBuffer];
+        const uintptr_t offset = reinterpret_cast<uintptr_t>(pixels);
+        if (offset + size > buffer.size())
+            return;
+        destination = buffer.data() + offset;
+    }
+    memcpy(destination, texture->second->bytes, size);
+}
+
+static void KHRONOS_APIENTRY stubGlFinish()
+{
+    COUNT(glFinish);
+}
+
+static void KHRONOS_APIENTRY stubGlGenBuffers(int count, unsigned int* names)
+{
+    COUNT(glGenBuffers);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    for (int i = 0; i < count; ++i) {
+        names[i] = nextObject++;
+        buffers[names[i]];
+    }
+}
+
+static void KHRONOS_APIENTRY stubGlDeleteBuffers(int count, const unsigned int* names)
+{
+    COUNT(glDeleteBuffers);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    for (int i = 0; i < count; ++i) {
+        buffers.erase(names[i]);
+        if (boundPackBuffer == names[i])
+            boundPackBuffer = 0;
+    }
+}
+
+// only GL_PIXEL_PACK_BUFFER is used
+static void KHRONOS_APIENTRY stubGlBindBuffer(unsigned int /*target*/, unsigned int buffer)
+{
+    COUNT(glBindBuffer);
+    boundPackBuffer = buffer;
+}
+
+static void KHRONOS_APIENTRY stubGlBufferData(unsigned int /*target*/, khronos_ssize_t size, const void* data, unsigned int /*usage*/)
+{
+    COUNT(glBufferData);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto buffer = buffers.find(boundPackBuffer);
+    if (buffer == buffers.end())
+        return;
+    buffer->second.assign(size, 0);
+    if (data)
+        memcpy(buffer->second.data(), data, size);
+}
+
+static void* KHRONOS_APIENTRY stubGlMapBufferRange(unsigned int /*target*/, khronos_intptr_t offset, khronos_ssize_t length,
+                                                   unsigned int /*access*/)
+{
+    COUNT(glMapBufferRange);
+    std::lock_guard<std::mutex> lock(objectMutex);
+    const auto buffer = buffers.find(boundPackBuffer);
+    if (buffer == buffers.end() || offset < 0 || length < 0 || size_t(offset + length) > buffer->second.size())
+        return nullptr;
+    return buffer->second.data() + offset;
+}
+
+static unsigned char KHRONOS_APIENTRY stubGlUnmapBuffer(unsigned int /*target*/)
+{
+    COUNT(glUnmapBuffer);
+    return 1;
+}
+
+extern "C" __eglMustCastToProperFunctionPointerType EGLAPIENTRY eglGetProcAddress(const char* procname)
+{
+    COUNT(eglGetProcAddress);
+    static const struct {
+        const char* name;
+        __eglMustCastToProperFunctionPointerType function;
+    } functions[] = {
+#define FUNCTION(name, function) { #name, reinterpret_cast<__eglMustCastToProperFunctionPointerType>(function) }
+        FUNCTION(eglClientWaitSyncKHR, stubClientWaitSyncKHR),
+        FUNCTION(eglCreateImageKHR, stubCreateImageKHR),
+        FUNCTION(eglCreateSyncKHR, stubCreateSyncKHR),
+        FUNCTION(eglDestroyImageKHR, stubDestroyImageKHR),
+        FUNCTION(eglDestroySyncKHR, stubDestroySyncKHR),
+        FUNCTION(eglGetPlatformDisplayEXT, stubGetPlatformDisplayEXT),
+        FUNCTION(eglQueryDeviceAttribEXT, stubQueryDeviceAttribEXT),
+        FUNCTION(eglQueryDevicesEXT, stubQueryDevicesEXT),
+        FUNCTION(eglQueryDeviceStringEXT, stubQueryDeviceStringEXT),
+        FUNCTION(eglQueryDmaBufFormatsEXT, stubQueryDmaBufFormatsEXT),
+        FUNCTION(eglQueryDmaBufModifiersEXT, stubQueryDmaBufModifiersEXT),
+        FUNCTION(eglSetBlobCacheFuncsANDROID, stubSetBlobCacheFuncsANDROID),
+        FUNCTION(glAttachShader, stubGlAttachShader),
+        FUNCTION(glBindBuffer, stubGlBindBuffer),
+        FUNCTION(glBindFramebuffer, stubGlBindFramebuffer),
+        FUNCTION(glBindTexture, stubGlBindTexture),
+        FUNCTION(glBufferData, stubGlBufferData),
+        FUNCTION(glCheckFramebufferStatus, stubGlCheckFramebufferStatus),
+        FUNCTION(glCompileShader, stubGlCompileShader),
+        FUNCTION(glCreateProgram, stubGlCreateProgram),
+        FUNCTION(glCreateShader, stubGlCreateShader),
+        FUNCTION(glDeleteBuffers, stubGlDeleteBuffers),
+        FUNCTION(glDeleteFramebuffers, stubGlDeleteFramebuffers),
+        FUNCTION(glDeleteProgram, stubGlDeleteProgram),
+        FUNCTION(glDeleteShader, stubGlDeleteShader),
+        FUNCTION(glDeleteTextures, stubGlDeleteTextures),
+        FUNCTION(glEGLImageTargetTexture2DOES, stubGlEGLImageTargetTexture2DOES),
+        FUNCTION(glFinish, stubGlFinish),
+        FUNCTION(glFramebufferTexture2D, stubGlFramebufferTexture2D),
+        FUNCTION(glGenBuffers, stubGlGenBuffers),
+        FUNCTION(glGenFramebuffers, stubGlGenFramebuffers),
+        FUNCTION(glGenTextures, stubGlGenTextures),
+        FUNCTION(glGetError, stubGlGetError),
+        FUNCTION(glGetIntegerv, stubGlGetIntegerv),
+        FUNCTION(glGetProgramInfoLog, stubGlGetProgramInfoLog),
+        FUNCTION(glGetProgramiv, stubGlGetProgramiv),
+        FUNCTION(glGetShaderInfoLog, stubGlGetShaderInfoLog),
+        FUNCTION(glGetShaderiv, stubGlGetShaderiv),
+        FUNCTION(glGetString, stubGlGetString),
+        FUNCTION(glGetStringi, stubGlGetStringi),
+        FUNCTION(glLinkProgram, stubGlLinkProgram),
+        FUNCTION(glMapBufferRange, stubGlMapBufferRange),
+        FUNCTION(glPixelStorei, stubGlPixelStorei),
+        FUNCTION(glReadPixels, stubGlReadPixels),
+        FUNCTION(glShaderSource, stubGlShaderSource),
+        FUNCTION(glTexImage2D, stubGlTexImage2D),
+        FUNCTION(glTexParameteri, stubGlTexParameteri),
+        FUNCTION(glTexSubImage2D, stubGlTexSubImage2D),
+        FUNCTION(glUnmapBuffer, stubGlUnmapBuffer),
+#undef FUNCTION
+    };
+    if (!procname)
+        return nullptr;
+    for (const auto &function : functions) {
+        if (strcmp(function.name, procname) == 0)
+            return function.function;
+    }
+    return nullptr;
+}
@@ -0,0 +1,12 @@
+TEMPLATE = lib
+TARGET = EGL
+VERSION = 1
+CONFIG += egl_headers_only
+LIBS += -ldl
+include(../eglinfo.pri)
+SOURCES += stub.cpp
+
+# make check: runs the built tools against the stub and compares calls and output, see check.sh
+check.depends = first
+check.commands = sh $$shell_quote($$PWD/check.sh) $$shell_quote($$OUT_PWD) $$shell_quote($$OUT_PWD/..)
+QMAKE_EXTRA_TARGETS += check
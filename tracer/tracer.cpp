@@ -0,0 +1,1144 @@
+/*
+    Copyright (C) 2026 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * LD_PRELOAD library tracing the EGL calls of an application:
+ *
+ *   LD_PRELOAD=libeglinfo-trace.so EGLINFO_TRACE=full myapp
+ *
+ * Every call is recorded with its arguments, result and duration into a fixed size ring
+ * buffer owned by the calling thread, so recording never takes a lock. At exit a summary
+ * per entry point (EGLINFO_TRACE=summary, the default) or the full call trace
+ * (EGLINFO_TRACE=full) is written to stderr or the file named by EGLINFO_TRACE_FILE.
+ * EGLINFO_TRACE_EVENTS sets the ring buffer size per thread for the full trace (default 4096
+ * calls, about 1 MB); the summary needs no ring buffer and counts all calls even if the ring
+ * buffer wrapped around. Calls that return while the trace is written out are not recorded.
+ */
+
+#include "attributes.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <dlfcn.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace EglInfo;
+
+namespace {
+
+enum FunctionId {
+    F_eglBindAPI,
+    F_eglBindTexImage,
+    F_eglChooseConfig,
+    F_eglClientWaitSync,
+    F_eglClientWaitSyncKHR,
+    F_eglCopyBuffers,
+    F_eglCreateContext,
+    F_eglCreateImage,
+    F_eglCreateImageKHR,
+    F_eglCreatePbufferFromClientBuffer,
+    F_eglCreatePbufferSurface,
+    F_eglCreatePixmapSurface,
+    F_eglCreatePlatformPixmapSurface,
+    F_eglCreatePlatformWindowSurface,
+    F_eglCreateSync,
+    F_eglCreateSyncKHR,
+    F_eglCreateWindowSurface,
+    F_eglDestroyContext,
+    F_eglDestroyImage,
+    F_eglDestroyImageKHR,
+    F_eglDestroySurface,
+    F_eglDestroySync,
+    F_eglDestroySyncKHR,
+    F_eglDupNativeFenceFDANDROID,
+    F_eglGetConfigAttrib,
+    F_eglGetConfigs,
+    F_eglGetCurrentContext,
+    F_eglGetCurrentDisplay,
+    F_eglGetCurrentSurface,
+    F_eglGetDisplay,
+    F_eglGetError,
+    F_eglGetPlatformDisplay,
+    F_eglGetPlatformDisplayEXT,
+    F_eglGetProcAddress,
+    F_eglGetSyncAttrib,
+    F_eglGetSyncAttribKHR,
+    F_eglInitialize,
+    F_eglMakeCurrent,
+    F_eglQueryAPI,
+    F_eglQueryContext,
+    F_eglQueryDeviceAttribEXT,
+    F_eglQueryDevicesEXT,
+    F_eglQueryDeviceStringEXT,
+    F_eglQueryDisplayAttribEXT,
+    F_eglQueryString,
+    F_eglQuerySurface,
+    F_eglReleaseTexImage,
+    F_eglReleaseThread,
+    F_eglSurfaceAttrib,
+    F_eglSwapBuffers,
+    F_eglSwapInterval,
+    F_eglTerminate,
+    F_eglWaitClient,
+    F_eglWaitGL,
+    F_eglWaitNative,
+    F_eglWaitSync,
+    F_eglWaitSyncKHR,
+    FunctionCount
+};
+
+/*
+ * Argument kinds, one character per argument:
+ * h handle, i integer, e enum, a config attribute, l attribute list, s string,
+ * o output pointer, printed as the value it points to if the call succeeded.
+ * The last character is the result kind: b boolean, h handle, i integer, e enum, s string, v void.
+ */
+struct FunctionInfo {
+    const char* name;
+    const char* arguments;
+    char result;
+};
+
+const FunctionInfo functions[FunctionCount] = {
+    { "eglBindAPI", "e", 'b' },
+    { "eglBindTexImage", "hhe", 'b' },
+    { "eglChooseConfig", "hlhio", 'b' },
+    { "eglClientWaitSync", "hhei", 'e' },
+    { "eglClientWaitSyncKHR", "hhei", 'e' },
+    { "eglCopyBuffers", "hhh", 'b' },
+    { "eglCreateContext", "hhhl", 'h' },
+    { "eglCreateImage", "hhehl", 'h' },
+    { "eglCreateImageKHR", "hhehl", 'h' },
+    { "eglCreatePbufferFromClientBuffer", "hehhl", 'h' },
+    { "eglCreatePbufferSurface", "hhl", 'h' },
+    { "eglCreatePixmapSurface", "hhhl", 'h' },
+    { "eglCreatePlatformPixmapSurface", "hhhl", 'h' },
+    { "eglCreatePlatformWindowSurface", "hhhl", 'h' },
+    { "eglCreateSync", "hel", 'h' },
+    { "eglCreateSyncKHR", "hel", 'h' },
+    { "eglCreateWindowSurface", "hhhl", 'h' },
+    { "eglDestroyContext", "hh", 'b' },
+    { "eglDestroyImage", "hh", 'b' },
+    { "eglDestroyImageKHR", "hh", 'b' },
+    { "eglDestroySurface", "hh", 'b' },
+    { "eglDestroySync", "hh", 'b' },
+    { "eglDestroySyncKHR", "hh", 'b' },
+    { "eglDupNativeFenceFDANDROID", "hh", 'i' },
+    { "eglGetConfigAttrib", "hhao", 'b' },
+    { "eglGetConfigs", "hhio", 'b' },
+    { "eglGetCurrentContext", "", 'h' },
+    { "eglGetCurrentDisplay", "", 'h' },
+    { "eglGetCurrentSurface", "e", 'h' },
+    { "eglGetDisplay", "h", 'h' },
+    { "eglGetError", "", 'e' },
+    { "eglGetPlatformDisplay", "ehl", 'h' },
+    { "eglGetPlatformDisplayEXT", "ehl", 'h' },
+    { "eglGetProcAddress", "s", 'h' },
+    { "eglGetSyncAttrib", "hheo", 'b' },
+    { "eglGetSyncAttribKHR", "hheo", 'b' },
+    { "eglInitialize", "hoo", 'b' },
+    { "eglMakeCurrent", "hhhh", 'b' },
+    { "eglQueryAPI", "", 'e' },
+    { "eglQueryContext", "hheo", 'b' },
+    { "eglQueryDeviceAttribEXT", "heo", 'b' },
+    { "eglQueryDevicesEXT", "iho", 'b' },
+    { "eglQueryDeviceStringEXT", "he", 's' },
+    { "eglQueryDisplayAttribEXT", "heo", 'b' },
+    { "eglQueryString", "he", 's' },
+    { "eglQuerySurface", "hheo", 'b' },
+    { "eglReleaseTexImage", "hhe", 'b' },
+    { "eglReleaseThread", "", 'b' },
+    { "eglSurfaceAttrib", "hhei", 'b' },
+    { "eglSwapBuffers", "hh", 'b' },
+    { "eglSwapInterval", "hi", 'b' },
+    { "eglTerminate", "h", 'b' },
+    { "eglWaitClient", "", 'b' },
+    { "eglWaitGL", "", 'b' },
+    { "eglWaitNative", "e", 'b' },
+    { "eglWaitSync", "hhi", 'b' },
+    { "eglWaitSyncKHR", "hhi", 'i' },
+};
+
+enum {
+    MaxArguments = 5,
+    MaxAttribPairs = 8,
+    TextSize = 40
+};
+
+struct Event {
+    uint64_t start;
+    uint64_t duration;
+    int64_t arguments[MaxArguments];
+    int64_t result;
+    int64_t attribs[2 * MaxAttribPairs];
+    char text[TextSize];
+    uint16_t function;
+    uint8_t outputs;
+    uint8_t attribCount;
+    bool attribsTruncated;
+};
+
+struct Stats {
+    uint64_t calls;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+};
+
+/** Per thread recording state, only ever written by its thread. */
+struct ThreadBuffer {
+    ThreadBuffer* next;
+    pid_t tid;
+    size_t capacity;
+    std::atomic<uint64_t> written;
+    /** Set while the thread records a call, dumpTrace() waits for it to be cleared. */
+    std::atomic<bool> recording;
+    Event* events;
+    Stats stats[FunctionCount];
+};
+
+std::atomic<ThreadBuffer*> threadBuffers(nullptr);
+/** Set by dumpTrace() before it reads the buffers, no call is recorded after that. */
+std::atomic<bool> stopped(false);
+thread_local ThreadBuffer* currentBuffer = nullptr;
+const uint64_t traceStart = [] {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}();
+
+uint64_t now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec - traceStart;
+}
+
+bool isFullTrace()
+{
+    static const bool full = [] {
+        const char *mode = getenv("EGLINFO_TRACE");
+        return mode && strcmp(mode, "full") == 0;
+    }();
+    return full;
+}
+
+ThreadBuffer* threadBuffer()
+{
+    if (currentBuffer)
+        return currentBuffer;
+
+    static const size_t capacity = [] {
+        if (!isFullTrace())
+            return size_t(0);
+        const char *env = getenv("EGLINFO_TRACE_EVENTS");
+        const long value = env ? atol(env) : 0;
+        return value > 0 ? size_t(value) : size_t(4096);
+    }();
+
+    ThreadBuffer *buffer = new ThreadBuffer;
+    buffer->tid = syscall(SYS_gettid);
+    buffer->capacity = capacity;
+    buffer->written.store(0, std::memory_order_relaxed);
+    buffer->recording.store(false, std::memory_order_relaxed);
+    buffer->events = capacity ? new Event[capacity] : nullptr;
+    memset(buffer->stats, 0, sizeof(buffer->stats));
+
+    // lock-free push onto the global list, buffers are never freed so they can be dumped at exit
+    buffer->next = threadBuffers.load(std::memory_order_relaxed);
+    while (!threadBuffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    currentBuffer = buffer;
+    return buffer;
+}
+
+void* resolveReal(const char* name)
+{
+    void *function = dlsym(RTLD_NEXT, name);
+    if (!function) {
+        // extension entry points are usually only reachable through eglGetProcAddress
+        static const auto realGetProcAddress = reinterpret_cast<__eglMustCastToProperFunctionPointerType (EGLAPIENTRY *)(const char*)>(dlsym(RTLD_NEXT, "eglGetProcAddress"));
+        if (realGetProcAddress)
+            function = reinterpret_cast<void*>(realGetProcAddress(name));
+    }
+    if (!function) {
+        fprintf(stderr, "eglinfo-trace: cannot resolve %s\n", name);
+        abort();
+    }
+    return function;
+}
+
+#define REAL(type, name) \
+    static const auto real = reinterpret_cast<type>(resolveReal(#name))
+
+template <typename T>
+int64_t toArgument(T value) { return static_cast<int64_t>(value); }
+template <typename T>
+int64_t toArgument(T* value) { return static_cast<int64_t>(reinterpret_cast<intptr_t>(value)); }
+
+/** Records one call; construct before calling the real function, call done() with its result. */
+class Call
+{
+public:
+    template <typename... Args>
+    Call(FunctionId function, Args... args)
+        : m_event()
+    {
+        m_event.function = function;
+        const int64_t values[] = { toArgument(args)..., 0 };
+        std::copy(values, values + std::min<size_t>(sizeof...(args), MaxArguments), m_event.arguments);
+        m_event.start = now();
+    }
+
+    template <typename T>
+    void attribs(const T* list)
+    {
+        if (!list)
+            return;
+        int i = 0;
+        for (; list[2 * i] != EGL_NONE && i < MaxAttribPairs; ++i) {
+            m_event.attribs[2 * i] = list[2 * i];
+            m_event.attribs[2 * i + 1] = list[2 * i + 1];
+        }
+        m_event.attribCount = i;
+        m_event.attribsTruncated = list[2 * i] != EGL_NONE;
+    }
+
+    void text(const char* str)
+    {
+        if (str)
+            strncpy(m_event.text, str, TextSize - 1);
+    }
+
+    /** Replaces argument @p index by the value its pointer argument points to, if any. */
+    template <typename T>
+    void output(int index, const T* value)
+    {
+        if (!value)
+            return;
+        m_event.arguments[index] = static_cast<int64_t>(*value);
+        m_event.outputs |= 1 << index;
+    }
+
+    template <typename T>
+    T done(T result)
+    {
+        finish(toArgument(result));
+        return result;
+    }
+
+    const char* done(const char* result)
+    {
+        text(result);
+        finish(toArgument(result));
+        return result;
+    }
+
+private:
+    void finish(int64_t result)
+    {
+        m_event.duration = now() - m_event.start;
+        m_event.result = result;
+
+        ThreadBuffer *buffer = threadBuffer();
+        // pairs with dumpTrace(): either it sees the flag and waits, or this sees stopped
+        buffer->recording.store(true);
+        if (stopped.load()) {
+            buffer->recording.store(false, std::memory_order_release);
+            return;
+        }
+        Stats &stats = buffer->stats[m_event.function];
+        if (stats.calls == 0 || m_event.duration < stats.min)
+            stats.min = m_event.duration;
+        stats.max = std::max(stats.max, m_event.duration);
+        stats.total += m_event.duration;
+        ++stats.calls;
+
+        if (buffer->capacity) {
+            const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+            buffer->events[index % buffer->capacity] = m_event;
+            buffer->written.store(index + 1, std::memory_order_release);
+        }
+        buffer->recording.store(false, std::memory_order_release);
+    }
+
+    Event m_event;
+};
+
+}
+
+extern "C" {
+
+EGLBoolean EGLAPIENTRY eglBindAPI(EGLenum api)
+{
+    REAL(decltype(&eglBindAPI), eglBindAPI);
+    Call call(F_eglBindAPI, api);
+    return call.done(real(api));
+}
+
+EGLBoolean EGLAPIENTRY eglBindTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer)
+{
+    REAL(decltype(&eglBindTexImage), eglBindTexImage);
+    Call call(F_eglBindTexImage, dpy, surface, buffer);
+    return call.done(real(dpy, surface, buffer));
+}
+
+EGLBoolean EGLAPIENTRY eglChooseConfig(EGLDisplay dpy, const EGLint* attrib_list, EGLConfig* configs, EGLint config_size, EGLint* num_config)
+{
+    REAL(decltype(&eglChooseConfig), eglChooseConfig);
+    Call call(F_eglChooseConfig, dpy, attrib_list, configs, config_size, num_config);
+    call.attribs(attrib_list);
+    const EGLBoolean result = real(dpy, attrib_list, configs, config_size, num_config);
+    call.output(4, result ? num_config : nullptr);
+    return call.done(result);
+}
+
+EGLint EGLAPIENTRY eglClientWaitSync(EGLDisplay dpy, EGLSync sync, EGLint flags, EGLTime timeout)
+{
+    REAL(decltype(&eglClientWaitSync), eglClientWaitSync);
+    Call call(F_eglClientWaitSync, dpy, sync, flags, timeout);
+    return call.done(real(dpy, sync, flags, timeout));
+}
+
+EGLBoolean EGLAPIENTRY eglCopyBuffers(EGLDisplay dpy, EGLSurface surface, EGLNativePixmapType target)
+{
+    REAL(decltype(&eglCopyBuffers), eglCopyBuffers);
+    Call call(F_eglCopyBuffers, dpy, surface, target);
+    return call.done(real(dpy, surface, target));
+}
+
+EGLContext EGLAPIENTRY eglCreateContext(EGLDisplay dpy, EGLConfig config, EGLContext share_context, const EGLint* attrib_list)
+{
+    REAL(decltype(&eglCreateContext), eglCreateContext);
+    Call call(F_eglCreateContext, dpy, config, share_context, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, config, share_context, attrib_list));
+}
+
+EGLImage EGLAPIENTRY eglCreateImage(EGLDisplay dpy, EGLContext ctx, EGLenum target, EGLClientBuffer buffer, const EGLAttrib* attrib_list)
+{
+    REAL(decltype(&eglCreateImage), eglCreateImage);
+    Call call(F_eglCreateImage, dpy, ctx, target, buffer);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, ctx, target, buffer, attrib_list));
+}
+
+EGLSurface EGLAPIENTRY eglCreatePbufferFromClientBuffer(EGLDisplay dpy, EGLenum buftype, EGLClientBuffer buffer, EGLConfig config, const EGLint* attrib_list)
+{
+    REAL(decltype(&eglCreatePbufferFromClientBuffer), eglCreatePbufferFromClientBuffer);
+    Call call(F_eglCreatePbufferFromClientBuffer, dpy, buftype, buffer, config);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, buftype, buffer, config, attrib_list));
+}
+
+EGLSurface EGLAPIENTRY eglCreatePbufferSurface(EGLDisplay dpy, EGLConfig config, const EGLint* attrib_list)
+{
+    REAL(decltype(&eglCreatePbufferSurface), eglCreatePbufferSurface);
+    Call call(F_eglCreatePbufferSurface, dpy, config, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, config, attrib_list));
+}
+
+EGLSurface EGLAPIENTRY eglCreatePixmapSurface(EGLDisplay dpy, EGLConfig config, EGLNativePixmapType pixmap, const EGLint* attrib_list)
+{
+    REAL(decltype(&eglCreatePixmapSurface), eglCreatePixmapSurface);
+    Call call(F_eglCreatePixmapSurface, dpy, config, pixmap, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, config, pixmap, attrib_list));
+}
+
+EGLSurface EGLAPIENTRY eglCreatePlatformPixmapSurface(EGLDisplay dpy, EGLConfig config, void* native_pixmap, const EGLAttrib* attrib_list)
+{
+    REAL(decltype(&eglCreatePlatformPixmapSurface), eglCreatePlatformPixmapSurface);
+    Call call(F_eglCreatePlatformPixmapSurface, dpy, config, native_pixmap, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, config, native_pixmap, attrib_list));
+}
+
+EGLSurface EGLAPIENTRY eglCreatePlatformWindowSurface(EGLDisplay dpy, EGLConfig config, void* native_window, const EGLAttrib* attrib_list)
+{
+    REAL(decltype(&eglCreatePlatformWindowSurface), eglCreatePlatformWindowSurface);
+    Call call(F_eglCreatePlatformWindowSurface, dpy, config, native_window, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, config, native_window, attrib_list));
+}
+
+EGLSync EGLAPIENTRY eglCreateSync(EGLDisplay dpy, EGLenum type, const EGLAttrib* attrib_list)
+{
+    REAL(decltype(&eglCreateSync), eglCreateSync);
+    Call call(F_eglCreateSync, dpy, type, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, type, attrib_list));
+}
+
+EGLSurface EGLAPIENTRY eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config, EGLNativeWindowType win, const EGLint* attrib_list)
+{
+    REAL(decltype(&eglCreateWindowSurface), eglCreateWindowSurface);
+    Call call(F_eglCreateWindowSurface, dpy, config, win, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, config, win, attrib_list));
+}
+
+EGLBoolean EGLAPIENTRY eglDestroyContext(EGLDisplay dpy, EGLContext ctx)
+{
+    REAL(decltype(&eglDestroyContext), eglDestroyContext);
+    Call call(F_eglDestroyContext, dpy, ctx);
+    return call.done(real(dpy, ctx));
+}
+
+EGLBoolean EGLAPIENTRY eglDestroyImage(EGLDisplay dpy, EGLImage image)
+{
+    REAL(decltype(&eglDestroyImage), eglDestroyImage);
+    Call call(F_eglDestroyImage, dpy, image);
+    return call.done(real(dpy, image));
+}
+
+EGLBoolean EGLAPIENTRY eglDestroySurface(EGLDisplay dpy, EGLSurface surface)
+{
+    REAL(decltype(&eglDestroySurface), eglDestroySurface);
+    Call call(F_eglDestroySurface, dpy, surface);
+    return call.done(real(dpy, surface));
+}
+
+EGLBoolean EGLAPIENTRY eglDestroySync(EGLDisplay dpy, EGLSync sync)
+{
+    REAL(decltype(&eglDestroySync), eglDestroySync);
+    Call call(F_eglDestroySync, dpy, sync);
+    return call.done(real(dpy, sync));
+}
+
+EGLBoolean EGLAPIENTRY eglGetConfigAttrib(EGLDisplay dpy, EGLConfig config, EGLint attribute, EGLint* value)
+{
+    REAL(decltype(&eglGetConfigAttrib), eglGetConfigAttrib);
+    Call call(F_eglGetConfigAttrib, dpy, config, attribute, value);
+    const EGLBoolean result = real(dpy, config, attribute, value);
+    call.output(3, result ? value : nullptr);
+    return call.done(result);
+}
+
+EGLBoolean EGLAPIENTRY eglGetConfigs(EGLDisplay dpy, EGLConfig* configs, EGLint config_size, EGLint* num_config)
+{
+    REAL(decltype(&eglGetConfigs), eglGetConfigs);
+    Call call(F_eglGetConfigs, dpy, configs, config_size, num_config);
+    const EGLBoolean result = real(dpy, configs, config_size, num_config);
+    call.output(3, result ? num_config : nullptr);
+    return call.done(result);
+}
+
+EGLContext EGLAPIENTRY eglGetCurrentContext(void)
+{
+    REAL(decltype(&eglGetCurrentContext), eglGetCurrentContext);
+    Call call(F_eglGetCurrentContext);
+    return call.done(real());
+}
+
+EGLDisplay EGLAPIENTRY eglGetCurrentDisplay(void)
+{
+    REAL(decltype(&eglGetCurrentDisplay), eglGetCurrentDisplay);
+    Call call(F_eglGetCurrentDisplay);
+    return call.done(real());
+}
+
+EGLSurface EGLAPIENTRY eglGetCurrentSurface(EGLint readdraw)
+{
+    REAL(decltype(&eglGetCurrentSurface), eglGetCurrentSurface);
+    Call call(F_eglGetCurrentSurface, readdraw);
+    return call.done(real(readdraw));
+}
+
+EGLDisplay EGLAPIENTRY eglGetDisplay(EGLNativeDisplayType display_id)
+{
+    REAL(decltype(&eglGetDisplay), eglGetDisplay);
+    Call call(F_eglGetDisplay, display_id);
+    return call.done(real(display_id));
+}
+
+EGLint EGLAPIENTRY eglGetError(void)
+{
+    REAL(decltype(&eglGetError), eglGetError);
+    Call call(F_eglGetError);
+    return call.done(real());
+}
+
+EGLDisplay EGLAPIENTRY eglGetPlatformDisplay(EGLenum platform, void* native_display, const EGLAttrib* attrib_list)
+{
+    REAL(decltype(&eglGetPlatformDisplay), eglGetPlatformDisplay);
+    Call call(F_eglGetPlatformDisplay, platform, native_display, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(platform, native_display, attrib_list));
+}
+
+EGLBoolean EGLAPIENTRY eglGetSyncAttrib(EGLDisplay dpy, EGLSync sync, EGLint attribute, EGLAttrib* value)
+{
+    REAL(decltype(&eglGetSyncAttrib), eglGetSyncAttrib);
+    Call call(F_eglGetSyncAttrib, dpy, sync, attribute, value);
+    const EGLBoolean result = real(dpy, sync, attribute, value);
+    call.output(3, result ? value : nullptr);
+    return call.done(result);
+}
+
+EGLBoolean EGLAPIENTRY eglInitialize(EGLDisplay dpy, EGLint* major, EGLint* minor)
+{
+    REAL(decltype(&eglInitialize), eglInitialize);
+    Call call(F_eglInitialize, dpy, major, minor);
+    const EGLBoolean result = real(dpy, major, minor);
+    call.output(1, result ? major : nullptr);
+    call.output(2, result ? minor : nullptr);
+    return call.done(result);
+}
+
+EGLBoolean EGLAPIENTRY eglMakeCurrent(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext ctx)
+{
+    REAL(decltype(&eglMakeCurrent), eglMakeCurrent);
+    Call call(F_eglMakeCurrent, dpy, draw, read, ctx);
+    return call.done(real(dpy, draw, read, ctx));
+}
+
+EGLenum EGLAPIENTRY eglQueryAPI(void)
+{
+    REAL(decltype(&eglQueryAPI), eglQueryAPI);
+    Call call(F_eglQueryAPI);
+    return call.done(real());
+}
+
+EGLBoolean EGLAPIENTRY eglQueryContext(EGLDisplay dpy, EGLContext ctx, EGLint attribute, EGLint* value)
+{
+    REAL(decltype(&eglQueryContext), eglQueryContext);
+    Call call(F_eglQueryContext, dpy, ctx, attribute, value);
+    const EGLBoolean result = real(dpy, ctx, attribute, value);
+    call.output(3, result ? value : nullptr);
+    return call.done(result);
+}
+
+const char* EGLAPIENTRY eglQueryString(EGLDisplay dpy, EGLint name)
+{
+    REAL(decltype(&eglQueryString), eglQueryString);
+    Call call(F_eglQueryString, dpy, name);
+    return call.done(real(dpy, name));
+}
+
+EGLBoolean EGLAPIENTRY eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint* value)
+{
+    REAL(decltype(&eglQuerySurface), eglQuerySurface);
+    Call call(F_eglQuerySurface, dpy, surface, attribute, value);
+    const EGLBoolean result = real(dpy, surface, attribute, value);
+    call.output(3, result ? value : nullptr);
+    return call.done(result);
+}
+
+EGLBoolean EGLAPIENTRY eglReleaseTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer)
+{
+    REAL(decltype(&eglReleaseTexImage), eglReleaseTexImage);
+    Call call(F_eglReleaseTexImage, dpy, surface, buffer);
+    return call.done(real(dpy, surface, buffer));
+}
+
+EGLBoolean EGLAPIENTRY eglReleaseThread(void)
+{
+    REAL(decltype(&eglReleaseThread), eglReleaseThread);
+    Call call(F_eglReleaseThread);
+    return call.done(real());
+}
+
+EGLBoolean EGLAPIENTRY eglSurfaceAttrib(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint value)
+{
+    REAL(decltype(&eglSurfaceAttrib), eglSurfaceAttrib);
+    Call call(F_eglSurfaceAttrib, dpy, surface, attribute, value);
+    return call.done(real(dpy, surface, attribute, value));
+}
+
+EGLBoolean EGLAPIENTRY eglSwapBuffers(EGLDisplay dpy, EGLSurface surface)
+{
+    REAL(decltype(&eglSwapBuffers), eglSwapBuffers);
+    Call call(F_eglSwapBuffers, dpy, surface);
+    return call.done(real(dpy, surface));
+}
+
+EGLBoolean EGLAPIENTRY eglSwapInterval(EGLDisplay dpy, EGLint interval)
+{
+    REAL(decltype(&eglSwapInterval), eglSwapInterval);
+    Call call(F_eglSwapInterval, dpy, interval);
+    return call.done(real(dpy, interval));
+}
+
+EGLBoolean EGLAPIENTRY eglTerminate(EGLDisplay dpy)
+{
+    REAL(decltype(&eglTerminate), eglTerminate);
+    Call call(F_eglTerminate, dpy);
+    return call.done(real(dpy));
+}
+
+EGLBoolean EGLAPIENTRY eglWaitClient(void)
+{
+    REAL(decltype(&eglWaitClient), eglWaitClient);
+    Call call(F_eglWaitClient);
+    return call.done(real());
+}
+
+EGLBoolean EGLAPIENTRY eglWaitGL(void)
+{
+    REAL(decltype(&eglWaitGL), eglWaitGL);
+    Call call(F_eglWaitGL);
+    return call.done(real());
+}
+
+EGLBoolean EGLAPIENTRY eglWaitNative(EGLint engine)
+{
+    REAL(decltype(&eglWaitNative), eglWaitNative);
+    Call call(F_eglWaitNative, engine);
+    return call.done(real(engine));
+}
+
+EGLBoolean EGLAPIENTRY eglWaitSync(EGLDisplay dpy, EGLSync sync, EGLint flags)
+{
+    REAL(decltype(&eglWaitSync), eglWaitSync);
+    Call call(F_eglWaitSync, dpy, sync, flags);
+    return call.done(real(dpy, sync, flags));
+}
+
+}
+
+// Extension entry points, only handed out through eglGetProcAddress()
+
+static EGLint EGLAPIENTRY traced_eglClientWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeout)
+{
+    REAL(PFNEGLCLIENTWAITSYNCKHRPROC, eglClientWaitSyncKHR);
+    Call call(F_eglClientWaitSyncKHR, dpy, sync, flags, timeout);
+    return call.done(real(dpy, sync, flags, timeout));
+}
+
+static EGLImageKHR EGLAPIENTRY traced_eglCreateImageKHR(EGLDisplay dpy, EGLContext ctx, EGLenum target, EGLClientBuffer buffer, const EGLint* attrib_list)
+{
+    REAL(PFNEGLCREATEIMAGEKHRPROC, eglCreateImageKHR);
+    Call call(F_eglCreateImageKHR, dpy, ctx, target, buffer);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, ctx, target, buffer, attrib_list));
+}
+
+static EGLSyncKHR EGLAPIENTRY traced_eglCreateSyncKHR(EGLDisplay dpy, EGLenum type, const EGLint* attrib_list)
+{
+    REAL(PFNEGLCREATESYNCKHRPROC, eglCreateSyncKHR);
+    Call call(F_eglCreateSyncKHR, dpy, type, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(dpy, type, attrib_list));
+}
+
+static EGLBoolean EGLAPIENTRY traced_eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image)
+{
+    REAL(PFNEGLDESTROYIMAGEKHRPROC, eglDestroyImageKHR);
+    Call call(F_eglDestroyImageKHR, dpy, image);
+    return call.done(real(dpy, image));
+}
+
+static EGLBoolean EGLAPIENTRY traced_eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync)
+{
+    REAL(PFNEGLDESTROYSYNCKHRPROC, eglDestroySyncKHR);
+    Call call(F_eglDestroySyncKHR, dpy, sync);
+    return call.done(real(dpy, sync));
+}
+
+static EGLint EGLAPIENTRY traced_eglDupNativeFenceFDANDROID(EGLDisplay dpy, EGLSyncKHR sync)
+{
+    REAL(PFNEGLDUPNATIVEFENCEFDANDROIDPROC, eglDupNativeFenceFDANDROID);
+    Call call(F_eglDupNativeFenceFDANDROID, dpy, sync);
+    return call.done(real(dpy, sync));
+}
+
+static EGLDisplay EGLAPIENTRY traced_eglGetPlatformDisplayEXT(EGLenum platform, void* native_display, const EGLint* attrib_list)
+{
+    REAL(PFNEGLGETPLATFORMDISPLAYEXTPROC, eglGetPlatformDisplayEXT);
+    Call call(F_eglGetPlatformDisplayEXT, platform, native_display, attrib_list);
+    call.attribs(attrib_list);
+    return call.done(real(platform, native_display, attrib_list));
+}
+
+static EGLBoolean EGLAPIENTRY traced_eglGetSyncAttribKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint attribute, EGLint* value)
+{
+    REAL(PFNEGLGETSYNCATTRIBKHRPROC, eglGetSyncAttribKHR);
+    Call call(F_eglGetSyncAttribKHR, dpy, sync, attribute, value);
+    const EGLBoolean result = real(dpy, sync, attribute, value);
+    call.output(3, result ? value : nullptr);
+    return call.done(result);
+}
+
+static EGLBoolean EGLAPIENTRY traced_eglQueryDeviceAttribEXT(EGLDeviceEXT device, EGLint attribute, EGLAttrib* value)
+{
+    REAL(PFNEGLQUERYDEVICEATTRIBEXTPROC, eglQueryDeviceAttribEXT);
+    Call call(F_eglQueryDeviceAttribEXT, device, attribute, value);
+    const EGLBoolean result = real(device, attribute, value);
+    call.output(2, result ? value : nullptr);
+    return call.done(result);
+}
+
+static EGLBoolean EGLAPIENTRY traced_eglQueryDevicesEXT(EGLint max_devices, EGLDeviceEXT* devices, EGLint* num_devices)
+{
+    REAL(PFNEGLQUERYDEVICESEXTPROC, eglQueryDevicesEXT);
+    Call call(F_eglQueryDevicesEXT, max_devices, devices, num_devices);
+    const EGLBoolean result = real(max_devices, devices, num_devices);
+    call.output(2, result ? num_devices : nullptr);
+    return call.done(result);
+}
+
+static const char* EGLAPIENTRY traced_eglQueryDeviceStringEXT(EGLDeviceEXT device, EGLint name)
+{
+    REAL(PFNEGLQUERYDEVICESTRINGEXTPROC, eglQueryDeviceStringEXT);
+    Call call(F_eglQueryDeviceStringEXT, device, name);
+    return call.done(real(device, name));
+}
+
+static EGLBoolean EGLAPIENTRY traced_eglQueryDisplayAttribEXT(EGLDisplay dpy, EGLint attribute, EGLAttrib* value)
+{
+    REAL(PFNEGLQUERYDISPLAYATTRIBEXTPROC, eglQueryDisplayAttribEXT);
+    Call call(F_eglQueryDisplayAttribEXT, dpy, attribute, value);
+    const EGLBoolean result = real(dpy, attribute, value);
+    call.output(2, result ? value : nullptr);
+    return call.done(result);
+}
+
+static EGLint EGLAPIENTRY traced_eglWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags)
+{
+    REAL(PFNEGLWAITSYNCKHRPROC, eglWaitSyncKHR);
+    Call call(F_eglWaitSyncKHR, dpy, sync, flags);
+    return call.done(real(dpy, sync, flags));
+}
+
+extern "C" __eglMustCastToProperFunctionPointerType EGLAPIENTRY eglGetProcAddress(const char* procname)
+{
+    REAL(decltype(&eglGetProcAddress), eglGetProcAddress);
+
+    static const struct {
+        const char* name;
+        __eglMustCastToProperFunctionPointerType function;
+    } wrappers[] = {
+#define WRAPPER(name, function) { #name, reinterpret_cast<__eglMustCastToProperFunctionPointerType>(function) }
+        WRAPPER(eglBindAPI, eglBindAPI),
+        WRAPPER(eglBindTexImage, eglBindTexImage),
+        WRAPPER(eglChooseConfig, eglChooseConfig),
+        WRAPPER(eglClientWaitSync, eglClientWaitSync),
+        WRAPPER(eglClientWaitSyncKHR, traced_eglClientWaitSyncKHR),
+        WRAPPER(eglCopyBuffers, eglCopyBuffers),
+        WRAPPER(eglCreateContext, eglCreateContext),
+        WRAPPER(eglCreateImage, eglCreateImage),
+        WRAPPER(eglCreateImageKHR, traced_eglCreateImageKHR),
+        WRAPPER(eglCreatePbufferFromClientBuffer, eglCreatePbufferFromClientBuffer),
+        WRAPPER(eglCreatePbufferSurface, eglCreatePbufferSurface),
+        WRAPPER(eglCreatePixmapSurface, eglCreatePixmapSurface),
+        WRAPPER(eglCreatePlatformPixmapSurface, eglCreatePlatformPixmapSurface),
+        WRAPPER(eglCreatePlatformWindowSurface, eglCreatePlatformWindowSurface),
+        WRAPPER(eglCreateSync, eglCreateSync),
+        WRAPPER(eglCreateSyncKHR, traced_eglCreateSyncKHR),
+        WRAPPER(eglCreateWindowSurface, eglCreateWindowSurface),
+        WRAPPER(eglDestroyContext, eglDestroyContext),
+        WRAPPER(eglDestroyImage, eglDestroyImage),
+        WRAPPER(eglDestroyImageKHR, traced_eglDestroyImageKHR),
+        WRAPPER(eglDestroySurface, eglDestroySurface),
+        WRAPPER(eglDestroySync, eglDestroySync),
+        WRAPPER(eglDestroySyncKHR, traced_eglDestroySyncKHR),
+        WRAPPER(eglDupNativeFenceFDANDROID, traced_eglDupNativeFenceFDANDROID),
+        WRAPPER(eglGetConfigAttrib, eglGetConfigAttrib),
+        WRAPPER(eglGetConfigs, eglGetConfigs),
+        WRAPPER(eglGetCurrentContext, eglGetCurrentContext),
+        WRAPPER(eglGetCurrentDisplay, eglGetCurrentDisplay),
+        WRAPPER(eglGetCurrentSurface, eglGetCurrentSurface),
+        WRAPPER(eglGetDisplay, eglGetDisplay),
+        WRAPPER(eglGetError, eglGetError),
+        WRAPPER(eglGetPlatformDisplay, eglGetPlatformDisplay),
+        WRAPPER(eglGetPlatformDisplayEXT, traced_eglGetPlatformDisplayEXT),
+        WRAPPER(eglGetProcAddress, eglGetProcAddress),
+        WRAPPER(eglGetSyncAttrib, eglGetSyncAttrib),
+        WRAPPER(eglGetSyncAttribKHR, traced_eglGetSyncAttribKHR),
+        WRAPPER(eglInitialize, eglInitialize),
+        WRAPPER(eglMakeCurrent, eglMakeCurrent),
+        WRAPPER(eglQueryAPI, eglQueryAPI),
+        WRAPPER(eglQueryContext, eglQueryContext),
+        WRAPPER(eglQueryDeviceAttribEXT, traced_eglQueryDeviceAttribEXT),
+        WRAPPER(eglQueryDevicesEXT, traced_eglQueryDevicesEXT),
+        WRAPPER(eglQueryDeviceStringEXT, traced_eglQueryDeviceStringEXT),
+        WRAPPER(eglQueryDisplayAttribEXT, traced_eglQueryDisplayAttribEXT),
+        WRAPPER(eglQueryString, eglQueryString),
+        WRAPPER(eglQuerySurface, eglQuerySurface),
+        WRAPPER(eglReleaseTexImage, eglReleaseTexImage),
+        WRAPPER(eglReleaseThread, eglReleaseThread),
+        WRAPPER(eglSurfaceAttrib, eglSurfaceAttrib),
+        WRAPPER(eglSwapBuffers, eglSwapBuffers),
+        WRAPPER(eglSwapInterval, eglSwapInterval),
+        WRAPPER(eglTerminate, eglTerminate),
+        WRAPPER(eglWaitClient, eglWaitClient),
+        WRAPPER(eglWaitGL, eglWaitGL),
+        WRAPPER(eglWaitNative, eglWaitNative),
+        WRAPPER(eglWaitSync, eglWaitSync),
+        WRAPPER(eglWaitSyncKHR, traced_eglWaitSyncKHR),
+#undef WRAPPER
+    };
+
+    Call call(F_eglGetProcAddress, procname);
+    call.text(procname);
+    __eglMustCastToProperFunctionPointerType function = real(procname);
+    // only hand out a wrapper if the implementation supports the function
+    if (function && procname) {
+        for (const auto &wrapper : wrappers) {
+            if (strcmp(wrapper.name, procname) == 0) {
+                function = wrapper.function;
+                break;
+            }
+        }
+    }
+    call.done(reinterpret_cast<void*>(function));
+    return function;
+}
+
+// Output
+
+namespace {
+
+struct NamedEnum {
+    EGLint value;
+    const char* name;
+};
+
+/** Non-config enums commonly seen in attribute lists and queries. */
+const NamedEnum enumNames[] = {
+#define E(x) { x, #x }
+    E(EGL_NONE), E(EGL_VENDOR), E(EGL_VERSION), E(EGL_EXTENSIONS), E(EGL_CLIENT_APIS),
+    E(EGL_WIDTH), E(EGL_HEIGHT), E(EGL_LARGEST_PBUFFER), E(EGL_TEXTURE_FORMAT), E(EGL_TEXTURE_TARGET),
+    E(EGL_RENDER_BUFFER), E(EGL_GL_COLORSPACE), E(EGL_CONTEXT_CLIENT_TYPE),
+    E(EGL_CONTEXT_MAJOR_VERSION), E(EGL_CONTEXT_MINOR_VERSION), E(EGL_CONTEXT_OPENGL_PROFILE_MASK),
+    E(EGL_CONTEXT_OPENGL_DEBUG), E(EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE), E(EGL_CONTEXT_OPENGL_ROBUST_ACCESS),
+    E(EGL_OPENGL_ES_API), E(EGL_OPENGL_API), E(EGL_OPENVG_API),
+    E(EGL_SYNC_FENCE), E(EGL_SYNC_STATUS), E(EGL_SYNC_TYPE), E(EGL_CONDITION_SATISFIED), E(EGL_TIMEOUT_EXPIRED),
+    E(EGL_GL_TEXTURE_2D), E(EGL_GL_TEXTURE_LEVEL), E(EGL_IMAGE_PRESERVED),
+    E(EGL_DRAW), E(EGL_READ), E(EGL_BACK_BUFFER), E(EGL_CORE_NATIVE_ENGINE), E(EGL_OPENVG_IMAGE),
+    E(EGL_SWAP_BEHAVIOR), E(EGL_MIPMAP_LEVEL), E(EGL_SYNC_CONDITION), E(EGL_SIGNALED), E(EGL_UNSIGNALED),
+    E(EGL_SUCCESS), E(EGL_NOT_INITIALIZED), E(EGL_BAD_ACCESS), E(EGL_BAD_ALLOC), E(EGL_BAD_ATTRIBUTE),
+    E(EGL_BAD_CONFIG), E(EGL_BAD_CONTEXT), E(EGL_BAD_CURRENT_SURFACE), E(EGL_BAD_DISPLAY), E(EGL_BAD_MATCH),
+    E(EGL_BAD_NATIVE_PIXMAP), E(EGL_BAD_NATIVE_WINDOW), E(EGL_BAD_PARAMETER), E(EGL_BAD_SURFACE),
+    E(EGL_CONTEXT_LOST),
+#ifdef EGL_PLATFORM_DEVICE_EXT
+    E(EGL_PLATFORM_DEVICE_EXT),
+#endif
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    E(EGL_PLATFORM_SURFACELESS_MESA),
+#endif
+#ifdef EGL_DRM_DEVICE_FILE_EXT
+    E(EGL_DRM_DEVICE_FILE_EXT),
+#endif
+#ifdef EGL_PLATFORM_X11_KHR
+    E(EGL_PLATFORM_X11_KHR),
+#endif
+#ifdef EGL_PLATFORM_WAYLAND_KHR
+    E(EGL_PLATFORM_WAYLAND_KHR),
+#endif
+#ifdef EGL_PLATFORM_GBM_KHR
+    E(EGL_PLATFORM_GBM_KHR),
+#endif
+#undef E
+};
+
+void printEnum(FILE* out, int64_t value)
+{
+    const int index = attributeIndex(static_cast<EGLint>(value));
+    if (index >= 0) {
+        fputs(attributes[index].displayName, out);
+        return;
+    }
+    for (const NamedEnum &e : enumNames) {
+        if (e.value == value) {
+            fputs(e.name, out);
+            return;
+        }
+    }
+    fprintf(out, "0x%" PRIx64, value);
+}
+
+void printAttribValue(FILE* out, int64_t attribute, int64_t value)
+{
+    const int index = attributeIndex(static_cast<EGLint>(attribute));
+    if (index >= 0 && attributes[index].enumMap) {
+        // same decoding as eglinfo's config output
+        const attrib_t *attr = &attributes[index];
+        for (int i = 0; i < attr->enumMapSize; ++i) {
+            if (!attr->isFlag && attr->enumMap[i].value == value) {
+                fputs(attr->enumMap[i].displayName, out);
+                return;
+            }
+        }
+        if (attr->isFlag) {
+            bool first = true;
+            for (int i = 0; i < attr->enumMapSize; ++i) {
+                if (value & attr->enumMap[i].value) {
+                    fprintf(out, "%s%s", first ? "" : "|", attr->enumMap[i].displayName);
+                    first = false;
+                }
+            }
+            if (!first)
+                return;
+        }
+    }
+    if (index < 0 && value >= 0x3000 && value < 0x4000) {
+        printEnum(out, value);
+        return;
+    }
+    fprintf(out, "%" PRId64, value);
+}
+
+void printEvent(FILE* out, pid_t tid, const Event& event)
+{
+    const FunctionInfo &info = functions[event.function];
+    fprintf(out, "%12.3f ms [%d] %s(", event.start / 1e6, tid, info.name);
+    int argument = 0;
+    for (const char *kind = info.arguments; *kind; ++kind, ++argument) {
+        if (argument)
+            fputs(", ", out);
+        const int64_t value = argument < MaxArguments ? event.arguments[argument] : 0;
+        switch (*kind) {
+            case 'h':
+                fprintf(out, "0x%" PRIx64, value);
+                break;
+            case 'i':
+                fprintf(out, "%" PRId64, value);
+                break;
+            case 'o':
+                if (event.outputs & (1 << argument))
+                    fprintf(out, "%" PRId64, value);
+                else
+                    fprintf(out, "0x%" PRIx64, value);
+                break;
+            case 'e':
+            case 'a':
+                printEnum(out, value);
+                break;
+            case 's':
+                fprintf(out, "\"%s\"", event.text);
+                break;
+            case 'l':
+                fputc('{', out);
+                for (int i = 0; i < event.attribCount; ++i) {
+                    fputs(i ? ", " : "", out);
+                    printEnum(out, event.attribs[2 * i]);
+                    fputs(": ", out);
+                    printAttribValue(out, event.attribs[2 * i], event.attribs[2 * i + 1]);
+                }
+                fputs(event.attribsTruncated ? ", ...}" : "}", out);
+                break;
+        }
+    }
+    fputs(") = ", out);
+    switch (info.result) {
+        case 'b':
+            fputs(event.result ? "EGL_TRUE" : "EGL_FALSE", out);
+            break;
+        case 'h':
+            fprintf(out, "0x%" PRIx64, event.result);
+            break;
+        case 'e':
+            printEnum(out, event.result);
+            break;
+        case 's':
+            if (event.result)
+                fprintf(out, "\"%s%s\"", event.text, strlen(event.text) == TextSize - 1 ? "..." : "");
+            else
+                fputs("NULL", out);
+            break;
+        default:
+            fprintf(out, "%" PRId64, event.result);
+            break;
+    }
+    fprintf(out, " (%.3f us)\n", event.duration / 1e3);
+}
+
+struct TracedEvent {
+    pid_t tid;
+    const Event* event;
+};
+
+__attribute__((destructor)) void dumpTrace()
+{
+    const bool full = isFullTrace();
+    const char *fileName = getenv("EGLINFO_TRACE_FILE");
+    FILE *out = fileName ? fopen(fileName, "w") : stderr;
+    if (!out)
+        return;
+
+    Stats stats[FunctionCount];
+    memset(stats, 0, sizeof(stats));
+    std::vector<TracedEvent> events;
+    uint64_t dropped = 0;
+    int threads = 0;
+    // threads still running keep calling EGL, stop recording and let calls in flight finish
+    stopped.store(true);
+    for (ThreadBuffer *buffer = threadBuffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        while (buffer->recording.load())
+            sched_yield();
+    }
+
+    for (ThreadBuffer *buffer = threadBuffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+        ++threads;
+        for (int i = 0; i < FunctionCount; ++i) {
+            const Stats &s = buffer->stats[i];
+            if (!s.calls)
+                continue;
+            stats[i].min = stats[i].calls ? std::min(stats[i].min, s.min) : s.min;
+            stats[i].max = std::max(stats[i].max, s.max);
+            stats[i].total += s.total;
+            stats[i].calls += s.calls;
+        }
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const uint64_t first = written > buffer->capacity ? written - buffer->capacity : 0;
+        dropped += first;
+        for (uint64_t i = first; full && i < written; ++i)
+            events.push_back(TracedEvent{ buffer->tid, &buffer->events[i % buffer->capacity] });
+    }
+
+    if (full) {
+        std::sort(events.begin(), events.end(), [](const TracedEvent& a, const TracedEvent& b) {
+            return a.event->start < b.event->start;
+        });
+        fprintf(out, "EGL call trace of process %d:\n", getpid());
+        for (const TracedEvent &event : events)
+            printEvent(out, event.tid, *event.event);
+        if (dropped)
+            fprintf(out, "(%" PRIu64 " earlier calls dropped, raise EGLINFO_TRACE_EVENTS to keep them)\n", dropped);
+        fputc('\n', out);
+    }
+
+    fprintf(out, "EGL call summary of process %d (%d thread(s)):\n", getpid(), threads);
+    fprintf(out, "%-32s %8s %12s %12s %12s %12s\n", "Function", "Calls", "Total ms", "Mean us", "Min us", "Max us");
+    for (int i = 0; i < FunctionCount; ++i) {
+        const Stats &s = stats[i];
+        if (!s.calls)
+            continue;
+        fprintf(out, "%-32s %8" PRIu64 " %12.3f %12.3f %12.3f %12.3f\n", functions[i].name, s.calls,
+                s.total / 1e6, s.total / 1e3 / s.calls, s.min / 1e3, s.max / 1e3);
+    }
+
+    if (out != stderr)
+        fclose(out);
+}
+
+}
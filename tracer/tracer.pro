@@ -0,0 +1,9 @@
+TEMPLATE = lib
+TARGET = eglinfo-trace
+CONFIG += plugin egl_headers_only
+INCLUDEPATH += $$PWD/../lib
+LIBS += -ldl
+include(../eglinfo.pri)
+SOURCES += \
+    tracer.cpp \
+    ../lib/attributes.cpp